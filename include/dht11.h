@@ -26,8 +26,19 @@ typedef enum {
     DHT11_ERR_INVALID_DATA,             /**< Invalid data received */
     DHT11_ERR_PIN_ERROR,                /**< HAL pin operation error */
     DHT11_ERR_TOO_SOON,                 /**< Reading attempted too soon after last reading */
+    DHT11_ERR_IN_PROGRESS,              /**< Non-blocking transaction has not completed yet */
+    DHT11_ERR_NO_DATA,                  /**< No reading has been published yet */
+    DHT11_ERR_OUTLIER,                  /**< Valid reading rejected by the attached filter */
+    DHT11_RESULT_COUNT                  /**< Number of result codes, not a result */
 } dht11_result_t;
 
+typedef enum {
+    DHT11_STATE_IDLE = 0,               /**< No non-blocking transaction started */
+    DHT11_STATE_START_SIGNAL,           /**< Start signal low phase running, waiting for its deadline */
+    DHT11_STATE_RECEIVING,              /**< Line released, edges arriving through dht11_on_edge() */
+    DHT11_STATE_COMPLETE,               /**< Transaction finished, result available */
+} dht11_state_t;
+
 typedef struct {
     uint8_t humidity_integer;           /**< Humidity integer part (%) */
     uint8_t humidity_decimal;           /**< Humidity decimal part (%) */
@@ -41,9 +52,272 @@ typedef struct {
     float temperature;                  /**< Temperature in Celsius */
 } dht11_reading_t;
 
+/**
+ * @brief Reading in tenths of a unit, produced without floating point
+ */
+typedef struct {
+    int16_t humidity_x10;               /**< Humidity in 0.1 %RH */
+    int16_t temperature_x10;            /**< Temperature in 0.1 degrees Celsius */
+} dht11_reading_fixed_t;
+
+typedef enum {
+    DHT11_ACQ_POLLING = 0,              /**< Data phase is received by busy-waiting on the pin */
+    DHT11_ACQ_INTERRUPT,                /**< Data phase is received from edges pushed by dht11_on_edge() */
+    DHT11_ACQ_OVERSAMPLED,              /**< Data phase is sampled in bulk by the sampler hook and decoded afterwards */
+} dht11_acquisition_t;
+
+typedef struct {
+    uint32_t timestamp_us[DHT11_EDGE_RING_SIZE]; /**< Edge timestamps */
+    uint8_t level[DHT11_EDGE_RING_SIZE];         /**< Line level after each edge */
+    uint16_t head;                      /**< Next slot to write, owned by the producer (ISR) */
+    uint16_t tail;                      /**< Next slot to read, owned by the consumer (task) */
+    uint16_t dropped;                   /**< Edges lost because the ring was full */
+} dht11_edge_ring_t;
+
+/**
+ * @brief Pulse widths of the bits of one frame, saturated at 255 us
+ */
+typedef struct {
+    uint8_t low_us[DHT11_DATA_BITS];    /**< Low phase preceding each bit */
+    uint8_t high_us[DHT11_DATA_BITS];   /**< High phase carrying each bit */
+} dht11_bit_timing_t;
+
+typedef struct {
+    uint16_t edge_count;                /**< Edges consumed in the current frame */
+    uint32_t last_edge_us;              /**< Timestamp of the previous edge */
+    uint32_t pending_low_us;            /**< Low phase of the bit being received */
+    uint8_t bit_count;                  /**< Bits decided so far */
+    uint8_t threshold_us;               /**< High pulses longer than this are '1' */
+    uint8_t data_bytes[DHT11_DATA_BYTES]; /**< Bits decoded so far */
+    dht11_bit_timing_t *timing;         /**< Where to record pulse widths, or NULL */
+} dht11_edge_decoder_t;
+
+/**
+ * @brief Lock hooks for sharing a handle between tasks
+ *
+ * Maps onto a mutex and condition variable of the target RTOS or pthreads.
+ */
+typedef struct {
+    void (*lock)(void *ctx);            /**< Acquire the handle lock */
+    void (*unlock)(void *ctx);          /**< Release the handle lock */
+    void (*wait)(void *ctx);            /**< Release the lock, block until notified, reacquire the lock */
+    void (*notify_all)(void *ctx);      /**< Wake every task blocked in wait */
+    void *ctx;                          /**< Context passed to the hooks */
+} dht11_lock_ops_t;
+
+/**
+ * @brief Bulk pin sampler for oversampled acquisition
+ *
+ * Maps onto a timer-triggered DMA transfer from the port input register or
+ * a tight sampling loop. The hook blocks until all samples were taken.
+ */
+typedef struct {
+    /** Sample the data line sample_count times, period_us apart, starting now.
+     *  Sample i goes to bit (i % 32) of samples[i / 32], 1 for a high line. */
+    nhal_result_t (*sample)(void *ctx, uint32_t *samples, size_t sample_count, uint32_t period_us);
+    void *ctx;                          /**< Context passed to the hook */
+} dht11_sampler_t;
+
+/**
+ * @brief Latest reading published for lock-free readers
+ *
+ * Written by the task that owns the handle and read through dht11_get_latest().
+ * Values are stored as words so readers copy them with plain atomic loads.
+ */
+typedef struct {
+    uint32_t sequence;                  /**< Publish counter, odd while a publish is in progress */
+    uint32_t temperature_x10;           /**< Temperature in 0.1 degrees Celsius, sign-extended */
+    uint32_t humidity_x10;              /**< Humidity in 0.1 %RH */
+    uint32_t time_ms;                   /**< Timestamp of the reading */
+} dht11_latest_t;
+
+typedef enum {
+    DHT11_PHASE_START = 0,              /**< Start signal, until the line is released */
+    DHT11_PHASE_RESPONSE,               /**< Sensor response, until the first data bit starts */
+    DHT11_PHASE_DATA,                   /**< Data bits, until the frame is complete */
+    DHT11_PHASE_COUNT
+} dht11_phase_t;
+
+/**
+ * @brief Transaction counters of a handle
+ *
+ * All counters are free-running 32-bit values that wrap; telemetry should
+ * work with the difference between two snapshots. Latency histogram bucket i
+ * counts durations of 2^i to 2^(i+1) - 1 microseconds (bucket 0 also counts 0).
+ * Pulse histogram bucket i counts widths of i * DHT11_STATS_PULSE_BUCKET_US to
+ * (i + 1) * DHT11_STATS_PULSE_BUCKET_US - 1 microseconds. A shrinking margin
+ * warns that a sensor or cable is drifting toward misread bits.
+ */
+typedef struct {
+    uint32_t results[DHT11_RESULT_COUNT]; /**< Read attempts per result returned to the caller, including rejected ones */
+    uint32_t transactions;              /**< Transactions that drove the bus */
+    uint32_t retries;                   /**< Transactions started after a failed one */
+    uint32_t busy_wait_us;              /**< Time spent polling the pin */
+    uint32_t latency_total_us;          /**< Sum of transaction latencies */
+    uint32_t latency_max_us;            /**< Longest transaction */
+    uint32_t latency_histogram[DHT11_STATS_HISTOGRAM_BUCKETS]; /**< Transaction latencies */
+    uint32_t phase_total_us[DHT11_PHASE_COUNT]; /**< Sum of time spent in each phase */
+    uint32_t phase_max_us[DHT11_PHASE_COUNT]; /**< Longest time spent in each phase */
+    uint32_t phase_histogram[DHT11_PHASE_COUNT][DHT11_STATS_HISTOGRAM_BUCKETS]; /**< Phase durations */
+    uint32_t frames_timed;              /**< Complete frames whose pulse widths were recorded */
+    uint32_t zero_high_histogram[DHT11_STATS_PULSE_BUCKETS]; /**< High widths of '0' bits */
+    uint32_t one_high_histogram[DHT11_STATS_PULSE_BUCKETS]; /**< High widths of '1' bits */
+    uint32_t low_histogram[DHT11_STATS_PULSE_BUCKETS]; /**< Low widths preceding each bit */
+    uint32_t margin_histogram[DHT11_STATS_PULSE_BUCKETS]; /**< Smallest distance to the threshold, one entry per frame */
+    uint32_t last_margin_us;            /**< Smallest distance to the threshold in the last timed frame */
+    uint32_t min_margin_us;             /**< Smallest distance to the threshold in any timed frame */
+    uint32_t corrections_attempted;     /**< Checksum mismatches that error correction tried to repair */
+    uint32_t corrections_succeeded;     /**< Mismatches repaired by flipping one low-confidence bit */
+} dht11_stats_counters_t;
+
+/**
+ * @brief Statistics block attached to a handle with dht11_set_stats()
+ *
+ * Written only by the task that owns the handle; other tasks read it through
+ * dht11_stats_snapshot() and dht11_stats_reset() without taking a lock.
+ */
+typedef struct {
+    uint32_t sequence;                  /**< Update counter, odd while the counters are being changed */
+    uint32_t reset_pending;             /**< Set by dht11_stats_reset(), applied by the next update */
+    dht11_stats_counters_t counters;    /**< Counters, read them through dht11_stats_snapshot() */
+} dht11_stats_t;
+
+/**
+ * @brief Settings of a filter pipeline
+ *
+ * Readings go through outlier rejection, then a median, then an exponential
+ * moving average. Each stage can be disabled on its own.
+ */
+typedef struct {
+    int16_t max_humidity_step_x10;      /**< Largest humidity change between two readings, 0 disables the check */
+    int16_t max_temperature_step_x10;   /**< Largest temperature change between two readings, 0 disables the check */
+    uint8_t max_rejections;             /**< Consecutive rejections after which a new level is accepted */
+    uint8_t median_window;              /**< Odd median window up to DHT11_FILTER_MEDIAN_MAX, 1 disables the median */
+    uint8_t ema_shift;                  /**< Average weight of 1/2^shift for each new reading, 0 disables the average */
+} dht11_filter_config_t;
+
+/**
+ * @brief State of one channel of a filter pipeline
+ */
+typedef struct {
+    int16_t last_accepted_x10;          /**< Last reading that passed outlier rejection */
+    int16_t window[DHT11_FILTER_MEDIAN_MAX]; /**< Median window in arrival order */
+    int16_t sorted[DHT11_FILTER_MEDIAN_MAX]; /**< Median window in ascending order */
+    uint8_t window_head;                /**< Oldest entry of the window once it is full */
+    uint8_t window_fill;                /**< Entries in the window */
+    int32_t average_q8;                 /**< Moving average in 1/256 of 0.1 units */
+} dht11_filter_channel_t;
+
+/**
+ * @brief Filter pipeline, attached to a handle with dht11_set_filter() or used on its own
+ *
+ * All state is held in fixed-size arrays, so a filter needs no allocation
+ * and each reading costs a bounded amount of work.
+ */
+typedef struct {
+    dht11_filter_config_t config;       /**< Stage settings */
+    bool primed;                        /**< true once a reading was accepted */
+    uint8_t rejections;                 /**< Consecutive readings rejected as outliers */
+    dht11_filter_channel_t humidity;    /**< Humidity channel */
+    dht11_filter_channel_t temperature; /**< Temperature channel */
+    uint32_t accepted;                  /**< Readings that produced a filtered value */
+    uint32_t rejected;                  /**< Readings rejected as outliers */
+} dht11_filter_t;
+
+/**
+ * @brief Sensor family sharing the DHT11 single-wire framing
+ *
+ * DHT22, AM2302 and DHT21 send the same 40-bit frame and checksum as the
+ * DHT11, but wake up on a shorter start signal and encode each value as a
+ * 16-bit count of 0.1 units with the temperature sign in the top bit. A
+ * variant supplies these differences; everything else is shared.
+ */
+typedef struct {
+    const char *name;                   /**< Sensor part name */
+    uint32_t start_signal_ms;           /**< Start signal low duration */
+    uint32_t min_sampling_period_ms;    /**< Minimum time between readings */
+    int16_t humidity_min_x10;           /**< Lowest humidity the sensor reports, in 0.1 %RH */
+    int16_t humidity_max_x10;           /**< Highest humidity the sensor reports, in 0.1 %RH */
+    int16_t temperature_min_x10;        /**< Lowest temperature the sensor reports, in 0.1 C */
+    int16_t temperature_max_x10;        /**< Highest temperature the sensor reports, in 0.1 C */
+    /** Decode the data bytes of a frame whose checksum was already verified, integer only */
+    void (*decode)(const dht11_raw_data_t *raw_data, dht11_reading_fixed_t *reading);
+} dht11_variant_t;
+
+extern const dht11_variant_t dht11_variant_dht11;   /**< DHT11: 18 ms start, 2 s period, whole units */
+extern const dht11_variant_t dht11_variant_dht22;   /**< DHT22: 1 ms start, 1 s period, signed 0.1 units */
+extern const dht11_variant_t dht11_variant_am2302;  /**< AM2302: wired DHT22, 2 s period */
+extern const dht11_variant_t dht11_variant_dht21;   /**< DHT21 / AM2301: 1 ms start, 2 s period, signed 0.1 units */
+
+/**
+ * @brief Protocol timing and validation settings of a handle
+ *
+ * Start from dht11_config_default(), which holds the values of dht11_defs.h,
+ * and override what a board or deployment needs.
+ */
+typedef struct {
+    uint32_t start_signal_ms;           /**< Start signal low duration */
+    uint32_t start_signal_high_us;      /**< Host high time after the start signal */
+    uint32_t response_timeout_us;       /**< Timeout for the sensor response signals */
+    uint32_t bit_timeout_us;            /**< Longest gap between two edges of a frame */
+    uint32_t bit_low_timeout_us;        /**< Timeout for the low phase preceding each bit */
+    uint32_t bit_high_timeout_us;       /**< Timeout for the high phase carrying each bit */
+    uint8_t bit_threshold_us;           /**< High pulses longer than this are '1' bits */
+    uint32_t min_sampling_period_ms;    /**< Minimum time between readings */
+    int16_t humidity_min_x10;           /**< Lowest valid humidity in 0.1 %RH */
+    int16_t humidity_max_x10;           /**< Highest valid humidity in 0.1 %RH */
+    int16_t temperature_min_x10;        /**< Lowest valid temperature in 0.1 C */
+    int16_t temperature_max_x10;        /**< Highest valid temperature in 0.1 C */
+    const dht11_variant_t *variant;     /**< Sensor family, selects the value decoding */
+} dht11_config_t;
+
+typedef struct {
+    uint32_t age_ms;                    /**< Age of the returned reading in milliseconds */
+    bool fresh;                         /**< true if the reading is not older than the configured max age */
+} dht11_cache_info_t;
+
 typedef struct {
     struct nhal_pin_context *pin_ctx;   /**< HAL pin context */
+    dht11_config_t config;              /**< Protocol timing and validation settings */
     uint32_t last_reading_time_ms;      /**< Timestamp of last reading (for rate limiting) */
+    dht11_state_t state;                /**< Non-blocking transaction state */
+    uint32_t start_signal_time_ms;      /**< Timestamp when the start signal was pulled low */
+    dht11_result_t async_result;        /**< Result of the last non-blocking transaction */
+    dht11_raw_data_t async_raw_data;    /**< Raw data of the last non-blocking transaction */
+    dht11_acquisition_t acquisition;    /**< How the data phase of non-blocking transactions is received */
+    uint32_t last_activity_us;          /**< Time of the last edge or of the line release */
+    dht11_edge_decoder_t decoder;       /**< Incremental decoder for interrupt acquisition */
+    dht11_edge_ring_t edge_ring;        /**< Edges pushed from the pin interrupt */
+    uint32_t cache_max_age_ms;          /**< Max age served from the cache, 0 disables caching */
+    bool cache_valid;                   /**< true once a validated reading was cached */
+    uint32_t cached_time_ms;            /**< Timestamp of the cached reading */
+    dht11_reading_fixed_t cached_reading; /**< Most recent validated reading */
+    const dht11_lock_ops_t *lock_ops;   /**< Lock hooks, NULL for single-task use */
+    bool read_in_flight;                /**< true while a shared read is running */
+    uint32_t read_generation;           /**< Incremented when a shared read completes */
+    dht11_result_t shared_result;       /**< Result of the last shared read */
+    dht11_reading_fixed_t shared_reading; /**< Reading of the last shared read */
+    dht11_cache_info_t shared_info;     /**< Cache info of the last shared read */
+    dht11_latest_t latest;              /**< Most recent validated reading for dht11_get_latest() */
+    bool adaptive_threshold;            /**< true if the bit threshold is learned from received frames */
+    uint8_t threshold_us;               /**< Bit threshold used by the next transaction */
+    uint16_t zero_high_x16;             /**< Learned '0' high width in 1/16 us */
+    uint16_t one_high_x16;              /**< Learned '1' high width in 1/16 us */
+    const dht11_sampler_t *sampler;     /**< Bulk sampler for oversampled acquisition, or NULL */
+    uint32_t *sample_buffer;            /**< Packed line samples of the last oversampled frame */
+    size_t sample_count;                /**< Samples per oversampled frame */
+    uint32_t sample_period_us;          /**< Time between two samples */
+    bool error_correction;              /**< true if checksum mismatches are repaired by flipping one bit */
+    bool correction_attempted;          /**< true if the last frame failed the checksum with correction enabled */
+    bool frame_corrected;               /**< true if a bit of the last frame was flipped to match the checksum */
+    dht11_filter_t *filter;             /**< Attached filter pipeline, NULL when disabled */
+    dht11_stats_t *stats;               /**< Attached statistics block, NULL when disabled */
+    dht11_bit_timing_t bit_timing;      /**< Pulse widths of the current frame */
+    uint32_t stats_start_us;            /**< Start of the current transaction */
+    uint32_t stats_mark_us;             /**< Start of the current phase */
+    uint32_t stats_phase_us[DHT11_PHASE_COUNT]; /**< Phase durations of the current transaction */
+    dht11_phase_t stats_phase;          /**< Phase the current transaction is in */
+    bool stats_last_failed;             /**< true if the previous transaction failed */
 } dht11_handle_t;
 
 /**
@@ -55,11 +329,48 @@ typedef struct {
  */
 dht11_result_t dht11_init(dht11_handle_t *handle, struct nhal_pin_context *pin_ctx);
 
+/**
+ * @brief Fill a configuration with the defaults from dht11_defs.h
+ *
+ * @param config Pointer to configuration to fill
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_config_default(dht11_config_t *config);
+
+/**
+ * @brief Fill a configuration with the defaults for a sensor family
+ *
+ * Starts from dht11_config_default() and takes the start signal, sampling
+ * period, validation ranges and decoding from the variant.
+ *
+ * @param config Pointer to configuration to fill
+ * @param variant Sensor family, e.g. &dht11_variant_dht22
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_config_for_variant(dht11_config_t *config, const dht11_variant_t *variant);
+
+/**
+ * @brief Initialize DHT11 driver with its own protocol settings
+ *
+ * The configuration is copied into the handle. dht11_init() is this function
+ * called with dht11_config_default(). Free functions that take no handle,
+ * such as dht11_convert_raw_to_reading(), keep using the defaults.
+ *
+ * @param handle Pointer to DHT11 handle structure
+ * @param pin_ctx Initialized NHAL pin context for the data pin
+ * @param config Protocol settings; all timeouts and periods must be non-zero,
+ *               each minimum must not exceed its maximum and a variant with
+ *               a decode routine must be set
+ * @return dht11_result_t Result of initialization
+ */
+dht11_result_t dht11_init_ex(dht11_handle_t *handle, struct nhal_pin_context *pin_ctx, const dht11_config_t *config);
+
 /**
  * @brief Read temperature and humidity from DHT11 sensor
  *
  * This function performs a complete DHT11 communication cycle and returns
- * the processed temperature and humidity values.
+ * the processed temperature and humidity values. When the cache is enabled
+ * with dht11_set_cache_max_age(), it behaves like dht11_read_cached().
  *
  * @param handle Pointer to initialized DHT11 handle
  * @param reading Pointer to store the temperature and humidity reading
@@ -67,6 +378,247 @@ dht11_result_t dht11_init(dht11_handle_t *handle, struct nhal_pin_context *pin_c
  */
 dht11_result_t dht11_read(dht11_handle_t *handle, dht11_reading_t *reading);
 
+/**
+ * @brief Read temperature and humidity in tenths without floating point
+ *
+ * Same as dht11_read(), which wraps this function. Suited to targets
+ * without an FPU, where the float conversion would pull in soft-float code.
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param reading Pointer to store the reading in 0.1 units
+ * @return dht11_result_t Result of the reading operation
+ */
+dht11_result_t dht11_read_fixed(dht11_handle_t *handle, dht11_reading_fixed_t *reading);
+
+/**
+ * @brief Make dht11_read() and dht11_read_cached() safe to call from several tasks
+ *
+ * Tasks that call in while a read is in flight wait for it and receive the
+ * same result, so the bus is hit once instead of once per task. Combine with
+ * the cache so that tasks arriving just after a read are not refused with
+ * DHT11_ERR_TOO_SOON. The other functions of the handle are not protected.
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param lock_ops Lock hooks (must stay valid), or NULL to disable locking
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_set_lock_ops(dht11_handle_t *handle, const dht11_lock_ops_t *lock_ops);
+
+/**
+ * @brief Get the most recent validated reading without blocking
+ *
+ * Every reading validated by dht11_read(), dht11_read_cached() or a
+ * non-blocking transaction is published to the handle. This function may be
+ * called from any number of tasks concurrently with the task that reads the
+ * sensor; it takes no lock and never returns a mix of two readings.
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param reading Pointer to store the reading
+ * @param time_ms Pointer to store the timestamp of the reading, or NULL
+ * @return dht11_result_t DHT11_ERR_NO_DATA before the first reading,
+ *         DHT11_ERR_IN_PROGRESS if publishes kept racing the copy
+ */
+dht11_result_t dht11_get_latest(const dht11_handle_t *handle, dht11_reading_t *reading, uint32_t *time_ms);
+
+/**
+ * @brief Get the most recent validated reading in tenths without blocking
+ *
+ * Fixed-point counterpart of dht11_get_latest(), with the same guarantees.
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param reading Pointer to store the reading in 0.1 units
+ * @param time_ms Pointer to store the timestamp of the reading, or NULL
+ * @return dht11_result_t Same as dht11_get_latest()
+ */
+dht11_result_t dht11_get_latest_fixed(const dht11_handle_t *handle, dht11_reading_fixed_t *reading, uint32_t *time_ms);
+
+/**
+ * @brief Enable or disable the self-calibrating bit threshold
+ *
+ * When enabled, the handle learns the high widths of '0' and '1' bits from
+ * frames that pass the checksum and places the threshold midway between them,
+ * tracking sensors and cable runs whose timing differs from the 26/70 us
+ * nominal. A frame that fails the checksum is decided again with a threshold
+ * split from its own pulse widths before it is rejected, and so is an
+ * all-zero frame whose pulses form two clusters. This lets the handle lock
+ * onto a sensor whose timing is far off from the start.
+ * Disabling restores the configured threshold (config.bit_threshold_us, set
+ * with dht11_init_ex()) and forgets what was learned.
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param enable true to learn the threshold, false for the configured threshold
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_set_adaptive_threshold(dht11_handle_t *handle, bool enable);
+
+/**
+ * @brief Get the bit threshold the next transaction will use
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param threshold_us Pointer to store the threshold in microseconds
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_get_bit_threshold(const dht11_handle_t *handle, uint8_t *threshold_us);
+
+/**
+ * @brief Enable or disable single-bit error correction
+ *
+ * Each bit's confidence is the distance of its high pulse from the threshold.
+ * When a frame fails the checksum, the least confident bits are flipped one
+ * at a time and the first flip that makes the checksum match is kept, which
+ * saves waiting another sampling period for a frame lost to one marginal
+ * pulse. Bits further than DHT11_CORRECTION_MAX_CONFIDENCE_US from the
+ * threshold are never flipped. The 8-bit checksum cannot prove that the right
+ * bit was flipped, so a corrected frame is flagged through
+ * dht11_get_frame_corrected() and still has to pass the range checks.
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param enable true to repair single-bit errors, false to reject the frame
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_set_error_correction(dht11_handle_t *handle, bool enable);
+
+/**
+ * @brief Check whether the last received frame was repaired by error correction
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param corrected Pointer to store true if a bit of the last frame was flipped
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_get_frame_corrected(const dht11_handle_t *handle, bool *corrected);
+
+/**
+ * @brief Attach a statistics block to the handle
+ *
+ * Once attached, every read attempt is counted and every transaction run by
+ * dht11_read_raw() or the non-blocking API is timed per phase. Timing takes
+ * a few extra microsecond timestamps per transaction, so it is opt-in.
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param stats Statistics block (must stay valid), or NULL to detach
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_set_stats(dht11_handle_t *handle, dht11_stats_t *stats);
+
+/**
+ * @brief Copy the counters of a statistics block without blocking its writer
+ *
+ * @param stats Statistics block attached to a handle
+ * @param counters Pointer to store the counters
+ * @return dht11_result_t DHT11_ERR_IN_PROGRESS if updates kept racing the copy
+ */
+dht11_result_t dht11_stats_snapshot(const dht11_stats_t *stats, dht11_stats_counters_t *counters);
+
+/**
+ * @brief Request that the counters be cleared
+ *
+ * The counters are zeroed by the owning task at its next update, so this is
+ * safe to call from any task.
+ *
+ * @param stats Statistics block attached to a handle
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_stats_reset(dht11_stats_t *stats);
+
+/**
+ * @brief Fill a filter configuration with the defaults from dht11_defs.h
+ *
+ * @param config Pointer to the configuration to fill
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_filter_config_default(dht11_filter_config_t *config);
+
+/**
+ * @brief Initialize a filter pipeline
+ *
+ * @param filter Pointer to the filter to initialize
+ * @param config Stage settings, copied into the filter
+ * @return dht11_result_t DHT11_ERR_INVALID_ARG if a setting is out of range
+ */
+dht11_result_t dht11_filter_init(dht11_filter_t *filter, const dht11_filter_config_t *config);
+
+/**
+ * @brief Clear the state of a filter pipeline, keeping its settings
+ *
+ * @param filter Pointer to initialized filter
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_filter_reset(dht11_filter_t *filter);
+
+/**
+ * @brief Pass one reading through a filter pipeline
+ *
+ * A reading that moves further than the allowed step from the last accepted
+ * one is rejected, unless max_rejections readings in a row were rejected
+ * before it, in which case the level is taken to have really changed.
+ *
+ * @param filter Pointer to initialized filter
+ * @param reading Validated reading in 0.1 units
+ * @param filtered Pointer to store the filtered reading, may equal reading
+ * @return dht11_result_t DHT11_ERR_OUTLIER if the reading was rejected,
+ *         in which case filtered is not written
+ */
+dht11_result_t dht11_filter_push(dht11_filter_t *filter, const dht11_reading_fixed_t *reading,
+                                 dht11_reading_fixed_t *filtered);
+
+/**
+ * @brief Attach a filter pipeline to the handle
+ *
+ * Once attached, every validated reading passes through the filter before
+ * it is returned, cached or published to dht11_get_latest(). Outliers are
+ * reported as DHT11_ERR_OUTLIER and never handed back to the caller.
+ * Non-blocking transactions feed the filter too and complete with
+ * DHT11_ERR_OUTLIER when it rejects their frame; their raw data is not
+ * filtered.
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param filter Initialized filter (must stay valid), or NULL to detach
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_set_filter(dht11_handle_t *handle, dht11_filter_t *filter);
+
+/**
+ * @brief Enable or disable the last-good-value cache
+ *
+ * With the cache enabled, dht11_read() serves the most recent validated
+ * reading without touching the bus while it is younger than max_age_ms.
+ * Every validated reading of the handle, including non-blocking and
+ * interrupt-driven transactions, refreshes the cache.
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param max_age_ms Maximum age of a cached reading, 0 disables the cache
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_set_cache_max_age(dht11_handle_t *handle, uint32_t max_age_ms);
+
+/**
+ * @brief Read temperature and humidity, served from the cache when possible
+ *
+ * A new bus transaction is only performed when the cached reading is older
+ * than the configured max age. If the sampling period has not elapsed yet,
+ * the older cached reading is returned with fresh set to false. If the bus
+ * transaction fails, the error is returned, and reading and info still
+ * receive the stale cached value when there is one.
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param reading Pointer to store the temperature and humidity reading
+ * @param info Optional pointer to store the age and freshness of the reading
+ * @return dht11_result_t Result of the reading operation
+ */
+dht11_result_t dht11_read_cached(dht11_handle_t *handle, dht11_reading_t *reading, dht11_cache_info_t *info);
+
+/**
+ * @brief Read through the cache in tenths without floating point
+ *
+ * Fixed-point counterpart of dht11_read_cached(), with the same behaviour.
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param reading Pointer to store the reading in 0.1 units
+ * @param info Optional pointer to store the age and freshness of the reading
+ * @return dht11_result_t Result of the reading operation
+ */
+dht11_result_t dht11_read_cached_fixed(dht11_handle_t *handle, dht11_reading_fixed_t *reading, dht11_cache_info_t *info);
+
 /**
  * @brief Read raw data from DHT11 sensor
  *
@@ -79,6 +631,120 @@ dht11_result_t dht11_read(dht11_handle_t *handle, dht11_reading_t *reading);
  */
 dht11_result_t dht11_read_raw(dht11_handle_t *handle, dht11_raw_data_t *raw_data);
 
+/**
+ * @brief Start a non-blocking read transaction
+ *
+ * Pulls the data line low to begin the start signal and returns immediately.
+ * The caller then drives the transaction with dht11_read_poll() until it
+ * stops returning DHT11_ERR_IN_PROGRESS.
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @return dht11_result_t DHT11_OK if the start signal was issued
+ */
+dht11_result_t dht11_read_start(dht11_handle_t *handle);
+
+/**
+ * @brief Advance a non-blocking read transaction
+ *
+ * Returns DHT11_ERR_IN_PROGRESS until the start signal deadline has passed.
+ * After that, the line is released and the response and data bits are
+ * received (about 4ms), and the transaction result is returned.
+ *
+ * @param handle Pointer to DHT11 handle with a started transaction
+ * @return dht11_result_t DHT11_ERR_IN_PROGRESS while pending, otherwise the transaction result
+ */
+dht11_result_t dht11_read_poll(dht11_handle_t *handle);
+
+/**
+ * @brief Get the result of a completed non-blocking read transaction
+ *
+ * @param handle Pointer to DHT11 handle with a started transaction
+ * @param raw_data Pointer to store the raw data
+ * @return dht11_result_t DHT11_ERR_IN_PROGRESS while pending, otherwise the transaction result
+ */
+dht11_result_t dht11_read_result(dht11_handle_t *handle, dht11_raw_data_t *raw_data);
+
+/**
+ * @brief Select how non-blocking transactions receive the data phase
+ *
+ * In DHT11_ACQ_INTERRUPT mode, dht11_read_poll() releases the line and then
+ * only drains the edges that the pin interrupt delivered via dht11_on_edge().
+ * It never busy-waits on the pin. DHT11_ACQ_OVERSAMPLED requires a sampler
+ * attached with dht11_set_sampler().
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param acquisition Acquisition mode
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_set_acquisition_mode(dht11_handle_t *handle, dht11_acquisition_t acquisition);
+
+/**
+ * @brief Attach a bulk sampler for DHT11_ACQ_OVERSAMPLED acquisition
+ *
+ * In oversampled mode the line is released and the whole response is sampled
+ * at a fixed rate into the buffer. It is then decoded without touching the
+ * bus. Each sample is replaced by the majority of the
+ * DHT11_OVERSAMPLE_VOTE_SAMPLES samples around it, and a level change only
+ * counts once it has held for DHT11_OVERSAMPLE_DEBOUNCE_SAMPLES samples.
+ * Spikes from a noisy line are dropped this way instead of being taken as
+ * edges. The window should cover DHT11_OVERSAMPLE_WINDOW_US. Oversampling
+ * applies to blocking reads and to non-blocking reads.
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param sampler Sampler hook (must stay valid), or NULL to detach
+ * @param buffer Buffer of (sample_count + 31) / 32 words (must stay valid)
+ * @param sample_count Samples per frame
+ * @param period_us Time between two samples in microseconds
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_set_sampler(dht11_handle_t *handle, const dht11_sampler_t *sampler,
+                                 uint32_t *buffer, size_t sample_count, uint32_t period_us);
+
+/**
+ * @brief Record a data line edge (interrupt context)
+ *
+ * Call this from the pin change interrupt with the new line level and a
+ * timestamp from the same clock as nhal_get_timestamp_microseconds(). The
+ * edge is pushed to a lock-free single-producer/single-consumer ring, so
+ * this function never blocks. If the ring is full, the edge is dropped and
+ * counted.
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param level Line level after the edge
+ * @param timestamp_us Edge timestamp in microseconds
+ */
+void dht11_on_edge(dht11_handle_t *handle, nhal_pin_state_t level, uint32_t timestamp_us);
+
+/**
+ * @brief Read a frame as a list of edge timestamps
+ *
+ * Sends the start signal and records the microsecond timestamp of every
+ * level change on the data line into the caller-provided buffer. The
+ * acquisition loop only samples the pin and the timestamp source; bit
+ * decisions are left to dht11_decode_edges().
+ *
+ * @param handle Pointer to initialized DHT11 handle
+ * @param edge_times_us Buffer to store edge timestamps (at least DHT11_FRAME_EDGES entries)
+ * @param capacity Number of entries available in edge_times_us
+ * @param edge_count Pointer to store the number of edges recorded
+ * @return dht11_result_t DHT11_OK if a complete frame was captured,
+ *         DHT11_ERR_TIMEOUT if the timestamp source stalled
+ */
+dht11_result_t dht11_read_edges(dht11_handle_t *handle, uint32_t *edge_times_us, size_t capacity, size_t *edge_count);
+
+/**
+ * @brief Decode a captured edge list into raw data
+ *
+ * The first edge is the falling edge of the sensor response. This function
+ * has no side effects and does not touch the HAL.
+ *
+ * @param edge_times_us Edge timestamps in microseconds
+ * @param edge_count Number of edges in edge_times_us
+ * @param raw_data Pointer to store the raw data
+ * @return dht11_result_t Result of decoding
+ */
+dht11_result_t dht11_decode_edges(const uint32_t *edge_times_us, size_t edge_count, dht11_raw_data_t *raw_data);
+
 /**
  * @brief Convert raw DHT11 data to processed reading
  *
@@ -88,6 +754,52 @@ dht11_result_t dht11_read_raw(dht11_handle_t *handle, dht11_raw_data_t *raw_data
  */
 dht11_result_t dht11_convert_raw_to_reading(const dht11_raw_data_t *raw_data, dht11_reading_t *reading);
 
+/**
+ * @brief Convert raw DHT11 data to a reading in tenths without floating point
+ *
+ * @param raw_data Pointer to raw data structure
+ * @param reading Pointer to store the reading in 0.1 units
+ * @return dht11_result_t Result of conversion
+ */
+dht11_result_t dht11_convert_raw_to_fixed(const dht11_raw_data_t *raw_data, dht11_reading_fixed_t *reading);
+
+/**
+ * @brief Convert raw data of a given sensor family to a processed reading
+ *
+ * Verifies the checksum, decodes the bytes the way the variant encodes them
+ * and checks the result against the variant's ranges. For 16-bit variants
+ * the fields of dht11_raw_data_t hold the high and low bytes of each value.
+ *
+ * @param variant Sensor family
+ * @param raw_data Pointer to raw data structure
+ * @param reading Pointer to store processed reading
+ * @return dht11_result_t Result of conversion
+ */
+dht11_result_t dht11_convert_raw_variant(const dht11_variant_t *variant, const dht11_raw_data_t *raw_data,
+                                         dht11_reading_t *reading);
+
+/**
+ * @brief Convert raw data of a given sensor family to a reading in tenths
+ *
+ * Fixed-point counterpart of dht11_convert_raw_variant().
+ *
+ * @param variant Sensor family
+ * @param raw_data Pointer to raw data structure
+ * @param reading Pointer to store the reading in 0.1 units
+ * @return dht11_result_t Result of conversion
+ */
+dht11_result_t dht11_convert_raw_variant_fixed(const dht11_variant_t *variant, const dht11_raw_data_t *raw_data,
+                                               dht11_reading_fixed_t *reading);
+
+/**
+ * @brief Convert a reading in tenths to floating point
+ *
+ * @param fixed Pointer to the reading in 0.1 units
+ * @param reading Pointer to store the floating-point reading
+ * @return dht11_result_t Result of conversion
+ */
+dht11_result_t dht11_fixed_to_reading(const dht11_reading_fixed_t *fixed, dht11_reading_t *reading);
+
 /**
  * @brief Verify checksum of raw DHT11 data
  *
@@ -0,0 +1,144 @@
+/**
+ * @file dht11_aggregate.h
+ * @brief Rolling min, max and mean of readings over cascading time windows
+ *
+ * Readings are summed into fixed-width buckets. When a bucket closes it
+ * enters its level's window and is merged into the open bucket of the next,
+ * coarser level. Each window keeps its buckets in a FIFO with running sums
+ * and monotonic queues of minima and maxima, so updates and queries take
+ * amortized constant time. All storage is inside dht11_aggregate_t, whose
+ * size is fixed by DHT11_AGGREGATE_LEVELS and DHT11_AGGREGATE_MAX_BUCKETS.
+ */
+#ifndef DHT11_AGGREGATE_H
+#define DHT11_AGGREGATE_H
+
+#include "dht11.h"
+
+#define DHT11_AGGREGATE_LEVELS          3       /**< Window levels, by default one minute, one hour and one day */
+
+/**
+ * @brief Bucket widths and window lengths of the levels
+ *
+ * Level L covers the open bucket plus the bucket_count[L] - 1 buckets
+ * before it. Each level's bucket width must be a multiple of the previous
+ * level's.
+ */
+typedef struct {
+    uint32_t bucket_ms[DHT11_AGGREGATE_LEVELS]; /**< Bucket width of each level */
+    uint8_t bucket_count[DHT11_AGGREGATE_LEVELS]; /**< Buckets per window, 2 to DHT11_AGGREGATE_MAX_BUCKETS */
+} dht11_aggregate_config_t;
+
+/**
+ * @brief Summary of the readings in one bucket
+ */
+typedef struct {
+    uint32_t index;                     /**< Bucket number, time since the first reading divided by the width */
+    uint32_t count;                     /**< Readings in the bucket */
+    int32_t humidity_sum;               /**< Sum of humidity in 0.1 %RH */
+    int32_t temperature_sum;            /**< Sum of temperature in 0.1 C */
+    dht11_reading_fixed_t min;          /**< Lowest humidity and temperature */
+    dht11_reading_fixed_t max;          /**< Highest humidity and temperature */
+} dht11_aggregate_bucket_t;
+
+/**
+ * @brief Monotonic queue of bucket slots, front holds the window's extreme
+ */
+typedef struct {
+    uint8_t slots[DHT11_AGGREGATE_MAX_BUCKETS]; /**< FIFO slots, oldest first */
+    uint8_t head;                       /**< Position of the front entry */
+    uint8_t length;                     /**< Entries in the queue */
+} dht11_aggregate_queue_t;
+
+/**
+ * @brief Window of one level
+ */
+typedef struct {
+    dht11_aggregate_bucket_t open;      /**< Bucket being filled */
+    dht11_aggregate_bucket_t buckets[DHT11_AGGREGATE_MAX_BUCKETS]; /**< Closed non-empty buckets in the window, FIFO */
+    uint8_t head;                       /**< Slot of the oldest closed bucket */
+    uint8_t length;                     /**< Closed buckets in the window */
+    int64_t humidity_sum;               /**< Sum over the closed buckets */
+    int64_t temperature_sum;            /**< Sum over the closed buckets */
+    uint32_t count;                     /**< Readings in the closed buckets */
+    dht11_aggregate_queue_t humidity_min; /**< Increasing humidity minima */
+    dht11_aggregate_queue_t humidity_max; /**< Decreasing humidity maxima */
+    dht11_aggregate_queue_t temperature_min; /**< Increasing temperature minima */
+    dht11_aggregate_queue_t temperature_max; /**< Decreasing temperature maxima */
+} dht11_aggregate_level_t;
+
+/**
+ * @brief Aggregator of one sensor's readings
+ */
+typedef struct {
+    dht11_aggregate_config_t config;    /**< Bucket widths and window lengths */
+    bool started;                       /**< true once a reading was added */
+    uint32_t last_time_ms;              /**< Timestamp of the last reading */
+    uint64_t elapsed_ms;                /**< Time from the first to the last reading */
+    dht11_aggregate_level_t levels[DHT11_AGGREGATE_LEVELS]; /**< Windows, finest first */
+} dht11_aggregate_t;
+
+/**
+ * @brief Statistics of one window
+ */
+typedef struct {
+    uint32_t count;                     /**< Readings in the window */
+    dht11_reading_fixed_t min;          /**< Lowest humidity and temperature */
+    dht11_reading_fixed_t max;          /**< Highest humidity and temperature */
+    dht11_reading_fixed_t mean;         /**< Mean humidity and temperature, rounded */
+} dht11_aggregate_window_t;
+
+/**
+ * @brief Fill an aggregator configuration with the defaults from dht11_defs.h
+ *
+ * The defaults are 5 s buckets over one minute, 1 min buckets over one hour
+ * and 1 h buckets over one day.
+ *
+ * @param config Pointer to the configuration to fill
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_aggregate_config_default(dht11_aggregate_config_t *config);
+
+/**
+ * @brief Initialize an aggregator
+ *
+ * @param aggregate Pointer to the aggregator to initialize
+ * @param config Bucket widths and window lengths, copied into the aggregator
+ * @return dht11_result_t DHT11_ERR_INVALID_ARG if the levels do not nest
+ */
+dht11_result_t dht11_aggregate_init(dht11_aggregate_t *aggregate, const dht11_aggregate_config_t *config);
+
+/**
+ * @brief Discard every reading, keeping the configuration
+ *
+ * @param aggregate Pointer to initialized aggregator
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_aggregate_reset(dht11_aggregate_t *aggregate);
+
+/**
+ * @brief Add a reading
+ *
+ * Feed it with the readings of dht11_read_fixed() or dht11_get_latest_fixed().
+ * Timestamps must not go backwards and may wrap; gaps longer than
+ * 49 days are not detected.
+ *
+ * @param aggregate Pointer to initialized aggregator
+ * @param reading Validated reading in 0.1 units
+ * @param time_ms Timestamp of the reading
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_aggregate_push(dht11_aggregate_t *aggregate, const dht11_reading_fixed_t *reading,
+                                    uint32_t time_ms);
+
+/**
+ * @brief Get the statistics of one level's window, ending at the last reading
+ *
+ * @param aggregate Pointer to initialized aggregator
+ * @param level Window level, 0 for the finest
+ * @param window Pointer to store the statistics
+ * @return dht11_result_t DHT11_ERR_NO_DATA if the window holds no readings
+ */
+dht11_result_t dht11_aggregate_query(const dht11_aggregate_t *aggregate, size_t level,
+                                     dht11_aggregate_window_t *window);
+
+#endif /* DHT11_AGGREGATE_H */
@@ -0,0 +1,76 @@
+/**
+ * @file dht11_batch.h
+ * @brief Conversion of many raw DHT11 frames in one call
+ *
+ * Meant for gateways that collect frames from many nodes. Every frame goes
+ * through the same checksum, decoding and range checks as
+ * dht11_convert_raw_to_fixed(), but the loop is branch-free so the compiler
+ * can vectorize it. Results are written to contiguous arrays, and a bitmap
+ * tells which items are valid.
+ */
+#ifndef DHT11_BATCH_H
+#define DHT11_BATCH_H
+
+#include "dht11.h"
+
+/**
+ * @brief Number of 32-bit bitmap words needed for count items
+ */
+#define DHT11_BATCH_BITMAP_WORDS(count) (((count) + 31u) / 32u)
+
+/**
+ * @brief Raw frames as separate byte arrays (structure of arrays)
+ *
+ * Element i of every array belongs to frame i.
+ */
+typedef struct {
+    const uint8_t *humidity_integer;    /**< Humidity integer bytes */
+    const uint8_t *humidity_decimal;    /**< Humidity decimal bytes */
+    const uint8_t *temperature_integer; /**< Temperature integer bytes */
+    const uint8_t *temperature_decimal; /**< Temperature decimal bytes */
+    const uint8_t *checksum;            /**< Checksum bytes */
+} dht11_raw_soa_t;
+
+/**
+ * @brief Output arrays of a batch conversion
+ *
+ * Bit (i % 32) of valid[i / 32] is set when item i passed the checksum and
+ * range checks; bits past the last item are cleared. Only the bitmap is
+ * authoritative: the values of an invalid item are unspecified.
+ */
+typedef struct {
+    int16_t *humidity_x10;              /**< count entries, humidity in 0.1 %RH */
+    int16_t *temperature_x10;           /**< count entries, temperature in 0.1 C */
+    uint32_t *valid;                    /**< DHT11_BATCH_BITMAP_WORDS(count) entries */
+} dht11_batch_out_t;
+
+/**
+ * @brief Convert an array of raw DHT11 frames
+ *
+ * Uses the DHT11 byte encoding and the default ranges of dht11_defs.h.
+ *
+ * @param raw_data Array of count raw frames
+ * @param count Number of frames
+ * @param out Output arrays
+ * @param valid_count Pointer to store the number of valid items, or NULL
+ * @return dht11_result_t DHT11_OK if the batch was converted (see out->valid for each item)
+ */
+dht11_result_t dht11_convert_batch(const dht11_raw_data_t *raw_data, size_t count,
+                                   const dht11_batch_out_t *out, size_t *valid_count);
+
+/**
+ * @brief Convert raw DHT11 frames held as separate byte arrays
+ *
+ * Same as dht11_convert_batch(). The unit-stride byte loads of this layout
+ * vectorize better than the 5-byte records of dht11_raw_data_t.
+ *
+ * @param raw_data Byte arrays of count frames
+ * @param count Number of frames
+ * @param out Output arrays
+ * @param valid_count Pointer to store the number of valid items, or NULL
+ * @return dht11_result_t DHT11_OK if the batch was converted (see out->valid for each item)
+ */
+dht11_result_t dht11_convert_batch_soa(const dht11_raw_soa_t *raw_data, size_t count,
+                                       const dht11_batch_out_t *out, size_t *valid_count);
+
+#endif /* DHT11_BATCH_H */
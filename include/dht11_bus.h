@@ -0,0 +1,67 @@
+/**
+ * @file dht11_bus.h
+ * @brief Scheduler that pipelines reads across many DHT11 sensors
+ *
+ * The bus drives every handle through the non-blocking read API. Start
+ * signals of ready sensors overlap, but their starts are staggered so that
+ * each start signal ends in its own data slot of DHT11_BUS_DATA_SLOT_MS.
+ * Blocking data phases therefore never delay another sensor's start signal
+ * beyond its nominal length. Interrupt-mode handles need no slot.
+ */
+#ifndef DHT11_BUS_H
+#define DHT11_BUS_H
+
+#include "dht11.h"
+
+/**
+ * @brief Called when a sensor transaction on the bus completes
+ *
+ * @param handle Handle whose transaction completed
+ * @param index Index of the handle in the bus
+ * @param result Transaction result
+ * @param raw_data Raw data of the transaction (valid when result is DHT11_OK)
+ * @param user_data User pointer passed to dht11_bus_init()
+ */
+typedef void (*dht11_bus_callback_t)(dht11_handle_t *handle, size_t index, dht11_result_t result,
+                                     const dht11_raw_data_t *raw_data, void *user_data);
+
+typedef struct {
+    dht11_handle_t **handles;           /**< Initialized handles served by the bus */
+    size_t handle_count;                /**< Number of handles */
+    dht11_bus_callback_t callback;      /**< Completion callback */
+    void *user_data;                    /**< User pointer passed to the callback */
+    size_t next_index;                  /**< Round-robin position for the next data phase */
+    bool slot_reserved;                 /**< true while a started handle's data slot lies ahead */
+    uint32_t slot_free_ms;              /**< End of the last reserved data slot */
+} dht11_bus_t;
+
+/**
+ * @brief Initialize a DHT11 bus scheduler
+ *
+ * @param bus Pointer to bus structure
+ * @param handles Array of initialized handles, each on its own pin
+ * @param handle_count Number of handles in the array
+ * @param callback Completion callback (may be NULL)
+ * @param user_data User pointer passed to the callback
+ * @return dht11_result_t Result of initialization
+ */
+dht11_result_t dht11_bus_init(dht11_bus_t *bus, dht11_handle_t **handles, size_t handle_count,
+                              dht11_bus_callback_t callback, void *user_data);
+
+/**
+ * @brief Run one scheduler step
+ *
+ * Starts a transaction on every idle handle whose sampling period has
+ * elapsed and whose start signal would end in a free data slot, then
+ * advances pending transactions. At most one blocking data phase runs per
+ * call, so a step costs at most about one frame time. A handle whose
+ * transaction failed is not restarted before its sampling period elapses.
+ *
+ * @param bus Pointer to initialized bus
+ * @param next_service_ms Optional pointer to store the milliseconds until the bus next needs service;
+ *                        call again then so that start signals end on time
+ * @return dht11_result_t DHT11_OK on success
+ */
+dht11_result_t dht11_bus_process(dht11_bus_t *bus, uint32_t *next_service_ms);
+
+#endif /* DHT11_BUS_H */
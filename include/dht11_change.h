@@ -0,0 +1,84 @@
+/**
+ * @file dht11_change.h
+ * @brief Change detection to publish only readings that moved
+ *
+ * A reading is emitted when humidity or temperature has moved more than its
+ * dead-band away from the last emitted reading, or when nothing has been
+ * emitted for the heartbeat interval. Comparing against the last emitted
+ * reading rather than the previous one gives hysteresis: a value wobbling
+ * inside the band never emits, and slow drift emits once it adds up.
+ */
+#ifndef DHT11_CHANGE_H
+#define DHT11_CHANGE_H
+
+#include "dht11.h"
+
+#define DHT11_CHANGE_FIRST          (1u << 0)   /**< First reading since init or reset */
+#define DHT11_CHANGE_HUMIDITY       (1u << 1)   /**< Humidity moved past its band */
+#define DHT11_CHANGE_TEMPERATURE    (1u << 2)   /**< Temperature moved past its band */
+#define DHT11_CHANGE_HEARTBEAT      (1u << 3)   /**< Heartbeat interval elapsed */
+
+/**
+ * @brief Dead-bands and heartbeat of a change detector
+ */
+typedef struct {
+    int16_t humidity_band_x10;          /**< Largest humidity change suppressed, 0.1 %RH; 0 emits on any change */
+    int16_t temperature_band_x10;       /**< Largest temperature change suppressed, 0.1 C; 0 emits on any change */
+    uint32_t heartbeat_ms;              /**< Longest time without an emitted reading, 0 to disable */
+} dht11_change_config_t;
+
+/**
+ * @brief Change detector of one sensor's readings
+ */
+typedef struct {
+    dht11_change_config_t config;       /**< Dead-bands and heartbeat */
+    bool primed;                        /**< true once a reading was emitted */
+    dht11_reading_fixed_t emitted;      /**< Last emitted reading */
+    uint32_t emitted_time_ms;           /**< Timestamp of the last emitted reading */
+    uint32_t emitted_count;             /**< Readings emitted, including heartbeats */
+    uint32_t heartbeat_count;           /**< Readings emitted only because of the heartbeat */
+    uint32_t suppressed_count;          /**< Readings suppressed */
+} dht11_change_t;
+
+/**
+ * @brief Fill a change detector configuration with the defaults from dht11_defs.h
+ *
+ * @param config Pointer to the configuration to fill
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_change_config_default(dht11_change_config_t *config);
+
+/**
+ * @brief Initialize a change detector
+ *
+ * @param change Pointer to the detector to initialize
+ * @param config Dead-bands and heartbeat, copied into the detector
+ * @return dht11_result_t DHT11_ERR_INVALID_ARG if a band is negative
+ */
+dht11_result_t dht11_change_init(dht11_change_t *change, const dht11_change_config_t *config);
+
+/**
+ * @brief Forget the last emitted reading and clear the counters, keeping the configuration
+ *
+ * @param change Pointer to initialized detector
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_change_reset(dht11_change_t *change);
+
+/**
+ * @brief Decide whether a reading should be published
+ *
+ * Feed it with the readings of dht11_read_fixed() or
+ * dht11_convert_raw_to_fixed(). Timestamps may wrap.
+ *
+ * @param change Pointer to initialized detector
+ * @param reading Validated reading in 0.1 units
+ * @param time_ms Timestamp of the reading
+ * @param events Pointer to store the DHT11_CHANGE_* reasons to emit,
+ *               0 when the reading is suppressed
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_change_push(dht11_change_t *change, const dht11_reading_fixed_t *reading, uint32_t time_ms,
+                                 uint8_t *events);
+
+#endif /* DHT11_CHANGE_H */
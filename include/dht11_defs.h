@@ -21,6 +21,8 @@
 #define DHT11_TIMEOUT_US                1000    /**< General timeout in microseconds */
 #define DHT11_RESPONSE_TIMEOUT_US       200     /**< Timeout for DHT11 response signals in microseconds */
 #define DHT11_BIT_TIMEOUT_US            200     /**< Timeout for bit transmission in microseconds */
+#define DHT11_BIT_LOW_TIMEOUT_US        100     /**< Timeout for the low phase preceding each bit in microseconds */
+#define DHT11_BIT_HIGH_TIMEOUT_US       100     /**< Timeout for the high phase carrying each bit in microseconds */
 #define DHT11_DATA_BITS                 40      /**< Total number of data bits */
 #define DHT11_MIN_SAMPLING_PERIOD_MS    2000    /**< Minimum time between readings in milliseconds */
 
@@ -28,6 +30,108 @@
 
 #define DHT11_PULSE_THRESHOLD_US        40      /**< Threshold for distinguishing '0' from '1' bits */
 #define DHT11_DATA_BYTES                5       /**< Number of data bytes (humidity_int, humidity_dec, temp_int, temp_dec, checksum) */
+#define DHT11_FRAME_EDGES               84      /**< Edges in a complete frame: response (2), data bits (80), end of frame (2) */
+#define DHT11_OVERSAMPLE_WINDOW_US      5600    /**< Sampling window covering a late response and a slow frame */
+
+/* DHT11 Driver Limits */
+
+#ifndef DHT11_WAIT_MAX_POLLS
+#define DHT11_WAIT_MAX_POLLS            10000   /**< Backstop on consecutive pin polls that see a stalled timestamp source */
+#endif
+
+#ifndef DHT11_BUS_DATA_SLOT_MS
+#define DHT11_BUS_DATA_SLOT_MS          6       /**< Time a bus reserves for one blocking data phase */
+#endif
+
+#ifndef DHT11_LATEST_MAX_RETRIES
+#define DHT11_LATEST_MAX_RETRIES        8       /**< Attempts dht11_get_latest() makes while racing a publish */
+#endif
+
+#ifndef DHT11_ADAPTIVE_MIN_SEPARATION_US
+#define DHT11_ADAPTIVE_MIN_SEPARATION_US 16     /**< Closest '0' and '1' clusters the adaptive threshold will split */
+#endif
+
+#ifndef DHT11_ADAPTIVE_WEIGHT_SHIFT
+#define DHT11_ADAPTIVE_WEIGHT_SHIFT     2       /**< Each good frame moves the learned clusters by 1/2^shift of the difference */
+#endif
+
+#ifndef DHT11_CORRECTION_CANDIDATES
+#define DHT11_CORRECTION_CANDIDATES     3       /**< Least confident bits tried when correcting a checksum mismatch */
+#endif
+
+#ifndef DHT11_CORRECTION_MAX_CONFIDENCE_US
+#define DHT11_CORRECTION_MAX_CONFIDENCE_US 12   /**< Bits further than this from the threshold are never flipped */
+#endif
+
+#ifndef DHT11_OVERSAMPLE_VOTE_SAMPLES
+#define DHT11_OVERSAMPLE_VOTE_SAMPLES   3       /**< Odd window of samples whose majority sets each filtered sample */
+#endif
+
+#if DHT11_OVERSAMPLE_VOTE_SAMPLES < 1 || (DHT11_OVERSAMPLE_VOTE_SAMPLES % 2) == 0
+#error "DHT11_OVERSAMPLE_VOTE_SAMPLES must be odd so that every vote has a majority"
+#endif
+
+#ifndef DHT11_OVERSAMPLE_DEBOUNCE_SAMPLES
+#define DHT11_OVERSAMPLE_DEBOUNCE_SAMPLES 3     /**< Filtered samples a new level must hold to count as an edge */
+#endif
+
+#ifndef DHT11_FILTER_MEDIAN_MAX
+#define DHT11_FILTER_MEDIAN_MAX         7       /**< Largest median window of a filter pipeline */
+#endif
+
+#define DHT11_FILTER_HUMIDITY_STEP_X10  100     /**< Default largest humidity change between readings in 0.1 %RH */
+#define DHT11_FILTER_TEMPERATURE_STEP_X10 50    /**< Default largest temperature change between readings in 0.1 C */
+#define DHT11_FILTER_MAX_REJECTIONS     3       /**< Default consecutive rejections before a new level is accepted */
+#define DHT11_FILTER_MEDIAN_WINDOW      3       /**< Default median window */
+#define DHT11_FILTER_EMA_SHIFT          2       /**< Default average weight of 1/4 for each new reading */
+
+#ifndef DHT11_AGGREGATE_MAX_BUCKETS
+#define DHT11_AGGREGATE_MAX_BUCKETS     60      /**< Buckets per aggregate window level (at most 255) */
+#endif
+
+#define DHT11_AGGREGATE_MINUTE_BUCKET_MS 5000   /**< Default bucket width of the one-minute window */
+#define DHT11_AGGREGATE_MINUTE_BUCKETS  12      /**< Default buckets of the one-minute window */
+#define DHT11_AGGREGATE_HOUR_BUCKET_MS  60000   /**< Default bucket width of the one-hour window */
+#define DHT11_AGGREGATE_HOUR_BUCKETS    60      /**< Default buckets of the one-hour window */
+#define DHT11_AGGREGATE_DAY_BUCKET_MS   3600000 /**< Default bucket width of the one-day window */
+#define DHT11_AGGREGATE_DAY_BUCKETS     24      /**< Default buckets of the one-day window */
+
+#define DHT11_CHANGE_HUMIDITY_BAND_X10  10      /**< Default humidity dead-band of the change detector */
+#define DHT11_CHANGE_TEMPERATURE_BAND_X10 5     /**< Default temperature dead-band of the change detector */
+#define DHT11_CHANGE_HEARTBEAT_MS       300000  /**< Default longest silence of the change detector */
+
+#ifndef DHT11_HISTORY_BLOCK_BYTES
+#define DHT11_HISTORY_BLOCK_BYTES       64      /**< Bytes per history block, each starting with a keyframe (at least 32) */
+#endif
+
+#if DHT11_HISTORY_BLOCK_BYTES < 32
+#error "DHT11_HISTORY_BLOCK_BYTES must be at least 32 to hold a keyframe and a full record"
+#endif
+
+#ifndef DHT11_STATS_MAX_RETRIES
+#define DHT11_STATS_MAX_RETRIES         8       /**< Attempts dht11_stats_snapshot() makes while racing an update */
+#endif
+
+
+#ifndef DHT11_EDGE_RING_SIZE
+#define DHT11_EDGE_RING_SIZE            128     /**< Edge ring entries per handle for interrupt acquisition (power of two, >= DHT11_FRAME_EDGES) */
+#endif
+
+#ifndef DHT11_STATS_HISTOGRAM_BUCKETS
+#define DHT11_STATS_HISTOGRAM_BUCKETS   16      /**< Power-of-two latency buckets; the last one is open-ended */
+#endif
+
+#ifndef DHT11_STATS_PULSE_BUCKETS
+#define DHT11_STATS_PULSE_BUCKETS       32      /**< Linear pulse-width buckets; the last one is open-ended */
+#endif
+
+#ifndef DHT11_STATS_PULSE_BUCKET_US
+#define DHT11_STATS_PULSE_BUCKET_US     4       /**< Width of one pulse-width bucket in microseconds */
+#endif
+
+#ifndef DHT11_PORT_MAX_SENSORS
+#define DHT11_PORT_MAX_SENSORS          16      /**< Maximum sensors sampled together on one GPIO port */
+#endif
 
 /* DHT11 Data Validation Constants */
 
@@ -35,5 +139,9 @@
 #define DHT11_HUMIDITY_MAX              100.0f  /**< Maximum valid humidity percentage */
 #define DHT11_TEMPERATURE_MIN           -40.0f  /**< Minimum valid temperature in Celsius */
 #define DHT11_TEMPERATURE_MAX           80.0f   /**< Maximum valid temperature in Celsius */
+#define DHT11_HUMIDITY_MIN_X10          0       /**< Minimum valid humidity in 0.1 %RH */
+#define DHT11_HUMIDITY_MAX_X10          1000    /**< Maximum valid humidity in 0.1 %RH */
+#define DHT11_TEMPERATURE_MIN_X10       (-400)  /**< Minimum valid temperature in 0.1 C */
+#define DHT11_TEMPERATURE_MAX_X10       800     /**< Maximum valid temperature in 0.1 C */
 
 #endif /* DHT11_DEFS_H */
\ No newline at end of file
@@ -0,0 +1,106 @@
+/**
+ * @file dht11_history.h
+ * @brief Compact on-device history of readings in a fixed byte ring
+ *
+ * The ring is split into blocks of DHT11_HISTORY_BLOCK_BYTES. Each block
+ * starts with a keyframe reading stored as varints of its absolute time,
+ * interval and values, and every further reading is stored as deltas from
+ * the one before. A reading whose
+ * values and interval did not change takes one byte. When the ring is full
+ * the oldest block is dropped, so a block always decodes on its own.
+ *
+ * Record layout after the keyframe, one header byte then optional varints:
+ *   bit 0     always 1; a 0 byte ends the block early
+ *   bits 3-1  temperature delta code
+ *   bits 6-4  humidity delta code
+ *   bit 7     interval differs from the previous one, varint seconds follow
+ * Delta codes 0 to 6 are zigzag-encoded deltas of -3 to +3 steps. Code 7
+ * is followed by the zigzag varint delta in 0.1 units.
+ */
+#ifndef DHT11_HISTORY_H
+#define DHT11_HISTORY_H
+
+#include "dht11.h"
+
+/**
+ * @brief History ring over a caller-provided buffer
+ */
+typedef struct {
+    uint8_t *buffer;                    /**< Ring storage, block_count blocks */
+    size_t block_count;                 /**< Blocks in the ring */
+    uint8_t step_x10;                   /**< Reading resolution in 0.1 units */
+    size_t oldest_block;                /**< Block holding the oldest reading */
+    size_t newest_block;                /**< Block being written */
+    size_t used_blocks;                 /**< Blocks holding readings, 0 when empty */
+    size_t write_offset;                /**< Next free byte of the newest block */
+    uint32_t last_time_s;               /**< Time of the newest reading */
+    uint32_t last_interval_s;           /**< Interval before the newest reading */
+    dht11_reading_fixed_t last;         /**< Newest reading */
+    uint32_t appended;                  /**< Readings appended since init, including dropped ones */
+} dht11_history_t;
+
+/**
+ * @brief Position of a decoder walking the history from oldest to newest
+ *
+ * Appending to the history invalidates its iterators.
+ */
+typedef struct {
+    const dht11_history_t *history;     /**< History being decoded */
+    size_t block;                       /**< Block being decoded */
+    size_t blocks_left;                 /**< Blocks after the current one */
+    size_t offset;                      /**< Next byte of the current block, 0 before its keyframe */
+    uint32_t time_s;                    /**< Time of the last decoded reading */
+    uint32_t interval_s;                /**< Interval before the last decoded reading */
+    dht11_reading_fixed_t reading;      /**< Last decoded reading */
+} dht11_history_iter_t;
+
+/**
+ * @brief Initialize a history over a buffer
+ *
+ * @param history Pointer to the history to initialize
+ * @param buffer Storage, at least two blocks; a partial block at the end is unused
+ * @param size Size of buffer in bytes
+ * @param step_x10 Resolution of the readings in 0.1 units, 10 for a DHT11
+ *                 and 1 for the 16-bit variants; finer changes still round-trip
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_history_init(dht11_history_t *history, uint8_t *buffer, size_t size, uint8_t step_x10);
+
+/**
+ * @brief Append a reading, dropping the oldest block if the ring is full
+ *
+ * @param history Pointer to initialized history
+ * @param reading Reading in 0.1 units
+ * @param time_s Time of the reading in seconds, never earlier than the previous one
+ * @return dht11_result_t DHT11_ERR_INVALID_ARG if time_s goes backwards
+ */
+dht11_result_t dht11_history_append(dht11_history_t *history, const dht11_reading_fixed_t *reading, uint32_t time_s);
+
+/**
+ * @brief Bytes of the ring holding readings
+ *
+ * @param history Pointer to initialized history
+ * @return Bytes used, 0 for an empty or NULL history
+ */
+size_t dht11_history_bytes_used(const dht11_history_t *history);
+
+/**
+ * @brief Start decoding at the oldest reading
+ *
+ * @param history Pointer to initialized history
+ * @param iter Pointer to the iterator to initialize
+ * @return dht11_result_t Result of the operation
+ */
+dht11_result_t dht11_history_iter_init(const dht11_history_t *history, dht11_history_iter_t *iter);
+
+/**
+ * @brief Decode the next reading
+ *
+ * @param iter Pointer to initialized iterator
+ * @param reading Pointer to store the reading
+ * @param time_s Pointer to store the time of the reading, or NULL
+ * @return dht11_result_t DHT11_ERR_NO_DATA after the newest reading
+ */
+dht11_result_t dht11_history_next(dht11_history_iter_t *iter, dht11_reading_fixed_t *reading, uint32_t *time_s);
+
+#endif /* DHT11_HISTORY_H */
@@ -0,0 +1,87 @@
+/**
+ * @file dht11_port.h
+ * @brief Parallel acquisition of several DHT11 sensors wired to one GPIO port
+ *
+ * All sensors of a group are triggered together and the whole port input
+ * register is sampled in a single loop. Every sensor's frame is then decoded
+ * from the same sample buffer, so one ~4ms data window serves the whole group.
+ */
+#ifndef DHT11_PORT_H
+#define DHT11_PORT_H
+
+#include "dht11.h"
+
+/**
+ * @brief Port access hooks provided by the platform
+ *
+ * The NHAL pin interface works on single pins, so port-wide access is
+ * supplied by the application.
+ */
+typedef struct {
+    nhal_result_t (*drive_low)(void *port_ctx, uint32_t pin_mask);  /**< Configure masked pins as outputs driven low */
+    nhal_result_t (*release)(void *port_ctx, uint32_t pin_mask);    /**< Configure masked pins as inputs with pull-up */
+    uint32_t (*read)(void *port_ctx);                               /**< Read the port input register */
+} dht11_port_ops_t;
+
+typedef struct {
+    uint32_t timestamp_us;              /**< Time the port value was first seen */
+    uint32_t levels;                    /**< Port input register masked to the group's pins */
+} dht11_port_sample_t;
+
+typedef struct {
+    const dht11_port_ops_t *ops;        /**< Port access hooks */
+    void *port_ctx;                     /**< Context passed to the hooks */
+    uint32_t pin_masks[DHT11_PORT_MAX_SENSORS]; /**< Single-bit mask of each sensor's pin */
+    size_t sensor_count;                /**< Number of sensors in the group */
+    uint32_t group_mask;                /**< Union of all sensor pin masks */
+    uint32_t last_reading_time_ms;      /**< Timestamp of last group reading (for rate limiting) */
+} dht11_port_group_t;
+
+/**
+ * @brief Initialize a group of sensors sharing one GPIO port
+ *
+ * @param group Pointer to group structure
+ * @param ops Port access hooks
+ * @param port_ctx Context passed to the hooks
+ * @param pin_masks Single-bit pin mask of each sensor (distinct bits)
+ * @param sensor_count Number of sensors (at most DHT11_PORT_MAX_SENSORS)
+ * @return dht11_result_t Result of initialization
+ */
+dht11_result_t dht11_port_init(dht11_port_group_t *group, const dht11_port_ops_t *ops, void *port_ctx,
+                               const uint32_t *pin_masks, size_t sensor_count);
+
+/**
+ * @brief Trigger all sensors of the group and sample their frames together
+ *
+ * Only port values that differ from the previous sample are stored, so a
+ * buffer of DHT11_FRAME_EDGES entries per sensor always holds a full window.
+ * The group's sampling period restarts after every window, since some
+ * sensors may have transmitted even if others did not.
+ *
+ * @param group Pointer to initialized group
+ * @param samples Buffer to store the port samples
+ * @param capacity Number of entries available in samples
+ * @param sample_count Pointer to store the number of samples recorded
+ * @return dht11_result_t DHT11_OK if sampling completed, DHT11_ERR_TIMEOUT
+ *         if the timestamp source stalled
+ */
+dht11_result_t dht11_port_read_samples(dht11_port_group_t *group, dht11_port_sample_t *samples,
+                                       size_t capacity, size_t *sample_count);
+
+/**
+ * @brief Decode every sensor's frame from a shared sample buffer
+ *
+ * The samples are walked once. Changed bits of each sample are dispatched to
+ * the per-sensor edge decoders. This function does not touch the HAL.
+ *
+ * @param group Pointer to initialized group
+ * @param samples Port samples from dht11_port_read_samples()
+ * @param sample_count Number of samples
+ * @param raw_data Array of sensor_count entries to store each sensor's raw data
+ * @param results Array of sensor_count entries to store each sensor's result
+ * @return dht11_result_t DHT11_OK if the buffer was decoded (see results for each sensor)
+ */
+dht11_result_t dht11_port_decode(const dht11_port_group_t *group, const dht11_port_sample_t *samples,
+                                 size_t sample_count, dht11_raw_data_t *raw_data, dht11_result_t *results);
+
+#endif /* DHT11_PORT_H */
@@ -0,0 +1,54 @@
+/**
+ * @file dht11_psychro.h
+ * @brief Dew point, heat index and absolute humidity without floating point
+ *
+ * Saturation vapour pressure over water comes from a table of the Magnus
+ * formula (6.112 hPa, 17.62, 243.12 C) at every whole degree, interpolated
+ * on tenths. Dew point inverts the same table, and absolute humidity follows
+ * from the vapour pressure and the ideal gas law. Heat index is the NWS
+ * Rothfusz regression, tabulated at every whole degree and %RH from 27 to
+ * 50 C and interpolated on tenths; elsewhere the polynomial is evaluated in
+ * 64-bit integers. Results are within 0.1 of the floating-point formulas;
+ * see the tests for the bounds.
+ */
+#ifndef DHT11_PSYCHRO_H
+#define DHT11_PSYCHRO_H
+
+#include "dht11.h"
+
+#define DHT11_PSYCHRO_DEW_POINT_MIN_X10 (-600)  /**< Lowest dew point reported; lower ones are clamped */
+
+/**
+ * @brief Metrics derived from one reading
+ */
+typedef struct {
+    int16_t dew_point_x10;              /**< Dew point in 0.1 C */
+    int16_t heat_index_x10;             /**< Heat index (apparent temperature) in 0.1 C */
+    uint16_t absolute_humidity_x100;    /**< Water vapour density in 0.01 g/m3 */
+} dht11_psychro_t;
+
+/**
+ * @brief Derive the metrics of a reading
+ *
+ * @param reading Reading in 0.1 units
+ * @param metrics Pointer to store the metrics
+ * @return dht11_result_t DHT11_ERR_INVALID_DATA if the reading is outside
+ *         0 to 100 %RH or -40 to 80 C
+ */
+dht11_result_t dht11_psychro_compute(const dht11_reading_fixed_t *reading, dht11_psychro_t *metrics);
+
+/**
+ * @brief Derive the metrics of a raw DHT11 frame
+ *
+ * The frame is converted with dht11_convert_raw_to_fixed(), whose whole
+ * degrees index the vapour pressure table directly. Convert frames of other
+ * sensor families with dht11_convert_raw_variant_fixed() and call
+ * dht11_psychro_compute().
+ *
+ * @param raw_data Pointer to raw data structure
+ * @param metrics Pointer to store the metrics
+ * @return dht11_result_t Result of the conversion or of dht11_psychro_compute()
+ */
+dht11_result_t dht11_psychro_from_raw(const dht11_raw_data_t *raw_data, dht11_psychro_t *metrics);
+
+#endif /* DHT11_PSYCHRO_H */
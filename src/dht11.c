@@ -4,65 +4,237 @@
  */
 
 #include "dht11.h"
+#include "dht11_internal.h"
 #include <string.h>
 
+#if (DHT11_EDGE_RING_SIZE & (DHT11_EDGE_RING_SIZE - 1)) != 0 || DHT11_EDGE_RING_SIZE < DHT11_FRAME_EDGES
+#error "DHT11_EDGE_RING_SIZE must be a power of two and hold a complete frame"
+#endif
 
-static bool wait_for_pin_state(struct nhal_pin_context *pin_ctx, nhal_pin_state_t expected_state, uint32_t timeout_us)
+// Ring indices are shared between the pin interrupt and task context
+#define RING_LOAD_ACQUIRE(ptr)          __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define RING_STORE_RELEASE(ptr, value)  __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+
+
+static bool wait_for_pin_state(struct nhal_pin_context *pin_ctx, nhal_pin_state_t expected_state, uint32_t timeout_us, uint32_t *timestamp_us)
 {
-    uint32_t elapsed_us = 0;
     nhal_pin_state_t current_state;
+    uint32_t start_us = (uint32_t)nhal_get_timestamp_microseconds();
+    uint32_t last_us = start_us;
+    uint32_t stalled_polls = 0;
 
 
-    while (elapsed_us < timeout_us) {
+    // Only polls that see the same timestamp count toward the backstop, so
+    // fast pin reads never end a wait before its deadline
+    while (stalled_polls < DHT11_WAIT_MAX_POLLS) {
         nhal_result_t result = nhal_pin_get_state(pin_ctx, &current_state);
         if (result != NHAL_OK) {
             return false;
         }
 
+        uint32_t now_us = (uint32_t)nhal_get_timestamp_microseconds();
         if (current_state == expected_state) {
+            if (timestamp_us != NULL) {
+                *timestamp_us = now_us;
+            }
             return true;
         }
 
-        nhal_delay_microseconds(1);
-        elapsed_us++;
+        if ((uint32_t)(now_us - start_us) >= timeout_us) {
+            return false;
+        }
+
+        if (now_us == last_us) {
+            stalled_polls++;
+        } else {
+            stalled_polls = 0;
+            last_us = now_us;
+        }
     }
 
     return false;
 }
 
 
-static uint32_t measure_pulse_duration(struct nhal_pin_context *pin_ctx, nhal_pin_state_t pulse_state, uint32_t timeout_us)
+static bool measure_pulse_duration(struct nhal_pin_context *pin_ctx, nhal_pin_state_t pulse_state, uint32_t start_timeout_us, uint32_t pulse_timeout_us, uint32_t *start_us, uint32_t *duration_us)
 {
     uint32_t start_time, end_time;
 
 
     // Wait for pulse to start
-    if (!wait_for_pin_state(pin_ctx, pulse_state, timeout_us)) {
-        return 0;
+    if (!wait_for_pin_state(pin_ctx, pulse_state, start_timeout_us, &start_time)) {
+        return false;
     }
-
-    start_time = nhal_get_timestamp_microseconds();
+    *start_us = start_time;
 
     // Wait for pulse to end
     nhal_pin_state_t opposite_state = (pulse_state == NHAL_PIN_HIGH) ? NHAL_PIN_LOW : NHAL_PIN_HIGH;
-    if (!wait_for_pin_state(pin_ctx, opposite_state, timeout_us)) {
-        return 0;
+    if (!wait_for_pin_state(pin_ctx, opposite_state, pulse_timeout_us, &end_time)) {
+        return false;
+    }
+
+    *duration_us = end_time - start_time;
+    return true;
+}
+
+
+static const dht11_config_t default_config = {
+    .start_signal_ms = DHT11_START_SIGNAL_MS,
+    .start_signal_high_us = DHT11_START_SIGNAL_HIGH_US,
+    .response_timeout_us = DHT11_RESPONSE_TIMEOUT_US,
+    .bit_timeout_us = DHT11_BIT_TIMEOUT_US,
+    .bit_low_timeout_us = DHT11_BIT_LOW_TIMEOUT_US,
+    .bit_high_timeout_us = DHT11_BIT_HIGH_TIMEOUT_US,
+    .bit_threshold_us = DHT11_PULSE_THRESHOLD_US,
+    .min_sampling_period_ms = DHT11_MIN_SAMPLING_PERIOD_MS,
+    .humidity_min_x10 = DHT11_HUMIDITY_MIN_X10,
+    .humidity_max_x10 = DHT11_HUMIDITY_MAX_X10,
+    .temperature_min_x10 = DHT11_TEMPERATURE_MIN_X10,
+    .temperature_max_x10 = DHT11_TEMPERATURE_MAX_X10,
+    .variant = &dht11_variant_dht11,
+};
+
+
+// Longest gap allowed before the next edge, given the edges seen so far
+static uint32_t idle_timeout_us(const dht11_config_t *config, size_t edge_count)
+{
+    return (edge_count < 2) ? config->response_timeout_us : config->bit_timeout_us;
+}
+
+
+static dht11_result_t capture_edges(const dht11_handle_t *handle, uint32_t *edge_times_us, size_t max_edges, size_t *edge_count)
+{
+    struct nhal_pin_context *pin_ctx = handle->pin_ctx;
+    nhal_pin_state_t level = NHAL_PIN_HIGH;  // Line is released and pulled up
+    nhal_pin_state_t current_state;
+    uint32_t last_edge_us = (uint32_t)nhal_get_timestamp_microseconds();
+    uint32_t last_us = last_edge_us;
+    uint32_t stalled_polls = 0;
+    size_t count = 0;
+
+
+    while (count < max_edges) {
+        if (nhal_pin_get_state(pin_ctx, &current_state) != NHAL_OK) {
+            *edge_count = count;
+            return DHT11_ERR_PIN_ERROR;
+        }
+
+        uint32_t now_us = (uint32_t)nhal_get_timestamp_microseconds();
+        if (now_us != last_us) {
+            stalled_polls = 0;
+            last_us = now_us;
+        } else if (++stalled_polls >= DHT11_WAIT_MAX_POLLS) {
+            // Same backstop as wait_for_pin_state(): the idle timeout can
+            // never expire on a stalled timestamp source
+            *edge_count = count;
+            return DHT11_ERR_TIMEOUT;
+        }
+
+        if (current_state != level) {
+            level = current_state;
+            edge_times_us[count++] = now_us;
+            last_edge_us = now_us;
+        } else if ((uint32_t)(now_us - last_edge_us) >= idle_timeout_us(&handle->config, count)) {
+            break;
+        }
+    }
+
+    *edge_count = count;
+    return DHT11_OK;
+}
+
+
+static bool config_is_valid(const dht11_config_t *config)
+{
+    return config->start_signal_ms != 0 &&
+           config->response_timeout_us != 0 &&
+           config->bit_timeout_us != 0 &&
+           config->bit_low_timeout_us != 0 &&
+           config->bit_high_timeout_us != 0 &&
+           config->bit_threshold_us != 0 &&
+           config->min_sampling_period_ms != 0 &&
+           config->humidity_min_x10 <= config->humidity_max_x10 &&
+           config->temperature_min_x10 <= config->temperature_max_x10 &&
+           config->variant != NULL &&
+           config->variant->decode != NULL;
+}
+
+
+dht11_result_t dht11_config_default(dht11_config_t *config)
+{
+    if (config == NULL) {
+        return DHT11_ERR_INVALID_ARG;
     }
 
-    end_time = nhal_get_timestamp_microseconds();
-    uint32_t duration = (uint32_t)(end_time - start_time);
-    return duration;
+    *config = default_config;
+    return DHT11_OK;
 }
 
+dht11_result_t dht11_config_for_variant(dht11_config_t *config, const dht11_variant_t *variant)
+{
+    if (config == NULL || variant == NULL || variant->decode == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    *config = default_config;
+    config->start_signal_ms = variant->start_signal_ms;
+    config->min_sampling_period_ms = variant->min_sampling_period_ms;
+    config->humidity_min_x10 = variant->humidity_min_x10;
+    config->humidity_max_x10 = variant->humidity_max_x10;
+    config->temperature_min_x10 = variant->temperature_min_x10;
+    config->temperature_max_x10 = variant->temperature_max_x10;
+    config->variant = variant;
+    return DHT11_OK;
+}
 
 dht11_result_t dht11_init(dht11_handle_t *handle, struct nhal_pin_context *pin_ctx)
 {
-    if (handle == NULL || pin_ctx == NULL) {
+    return dht11_init_ex(handle, pin_ctx, &default_config);
+}
+
+dht11_result_t dht11_init_ex(dht11_handle_t *handle, struct nhal_pin_context *pin_ctx, const dht11_config_t *config)
+{
+    if (handle == NULL || pin_ctx == NULL || config == NULL || !config_is_valid(config)) {
         return DHT11_ERR_INVALID_ARG;
     }
 
     handle->pin_ctx = pin_ctx;
+    handle->config = *config;
     handle->last_reading_time_ms = 0;
+    handle->state = DHT11_STATE_IDLE;
+    handle->start_signal_time_ms = 0;
+    handle->async_result = DHT11_ERR_INVALID_ARG;
+    memset(&handle->async_raw_data, 0, sizeof(handle->async_raw_data));
+    handle->acquisition = DHT11_ACQ_POLLING;
+    handle->last_activity_us = 0;
+    dht11_decoder_reset(&handle->decoder);
+    memset(&handle->edge_ring, 0, sizeof(handle->edge_ring));
+    handle->cache_max_age_ms = 0;
+    handle->cache_valid = false;
+    handle->cached_time_ms = 0;
+    memset(&handle->cached_reading, 0, sizeof(handle->cached_reading));
+    handle->lock_ops = NULL;
+    handle->read_in_flight = false;
+    handle->read_generation = 0;
+    handle->shared_result = DHT11_OK;
+    memset(&handle->shared_reading, 0, sizeof(handle->shared_reading));
+    memset(&handle->shared_info, 0, sizeof(handle->shared_info));
+    memset(&handle->latest, 0, sizeof(handle->latest));
+    handle->adaptive_threshold = false;
+    handle->threshold_us = config->bit_threshold_us;
+    handle->zero_high_x16 = 0;
+    handle->one_high_x16 = 0;
+    handle->sampler = NULL;
+    handle->sample_buffer = NULL;
+    handle->sample_count = 0;
+    handle->sample_period_us = 0;
+    handle->error_correction = false;
+    handle->correction_attempted = false;
+    handle->frame_corrected = false;
+    handle->filter = NULL;
+    handle->stats = NULL;
+    handle->stats_phase = DHT11_PHASE_COUNT;
+    handle->stats_last_failed = false;
 
     // Initialize pin as output with pull-up, set to HIGH
     nhal_result_t pin_result = nhal_pin_set_direction(pin_ctx, NHAL_PIN_DIR_OUTPUT, NHAL_PIN_PMODE_PULL_UP);
@@ -87,7 +259,7 @@ bool dht11_is_ready_for_reading(dht11_handle_t *handle)
     uint32_t current_time = nhal_get_timestamp_milliseconds();
     uint32_t time_since_last = current_time - handle->last_reading_time_ms;
 
-    return (time_since_last >= DHT11_MIN_SAMPLING_PERIOD_MS);
+    return (time_since_last >= handle->config.min_sampling_period_ms);
 }
 
 bool dht11_verify_checksum(const dht11_raw_data_t *raw_data)
@@ -104,129 +276,1000 @@ bool dht11_verify_checksum(const dht11_raw_data_t *raw_data)
     return (calculated_checksum == raw_data->checksum);
 }
 
-dht11_result_t dht11_convert_raw_to_reading(const dht11_raw_data_t *raw_data, dht11_reading_t *reading)
+static dht11_result_t convert_raw(const dht11_config_t *config, const dht11_raw_data_t *raw_data, dht11_reading_fixed_t *reading)
 {
-    if (raw_data == NULL || reading == NULL) {
-        return DHT11_ERR_INVALID_ARG;
-    }
-
     if (!dht11_verify_checksum(raw_data)) {
         return DHT11_ERR_CHECKSUM;
     }
 
-    // DHT11 provides integer values only (decimal parts are always 0)
-    reading->humidity = (float)raw_data->humidity_integer + (float)raw_data->humidity_decimal / 10.0f;
-    reading->temperature = (float)raw_data->temperature_integer + (float)raw_data->temperature_decimal / 10.0f;
+    config->variant->decode(raw_data, reading);
 
     // Validate ranges
-    if (reading->humidity < DHT11_HUMIDITY_MIN || reading->humidity > DHT11_HUMIDITY_MAX) {
+    if (reading->humidity_x10 < config->humidity_min_x10 || reading->humidity_x10 > config->humidity_max_x10) {
         return DHT11_ERR_INVALID_DATA;
     }
 
-    if (reading->temperature < DHT11_TEMPERATURE_MIN || reading->temperature > DHT11_TEMPERATURE_MAX) {
+    if (reading->temperature_x10 < config->temperature_min_x10 || reading->temperature_x10 > config->temperature_max_x10) {
         return DHT11_ERR_INVALID_DATA;
     }
 
     return DHT11_OK;
 }
 
-dht11_result_t dht11_read_raw(dht11_handle_t *handle, dht11_raw_data_t *raw_data)
+// The float API is a wrapper over the fixed-point one; a conversion that
+// failed the checksum leaves the reading untouched
+static dht11_result_t wrap_conversion(dht11_result_t result, const dht11_reading_fixed_t *fixed, dht11_reading_t *reading)
 {
-    if (handle == NULL || raw_data == NULL) {
+    if (result == DHT11_OK || result == DHT11_ERR_INVALID_DATA) {
+        dht11_fixed_to_reading(fixed, reading);
+    }
+    return result;
+}
+
+dht11_result_t dht11_fixed_to_reading(const dht11_reading_fixed_t *fixed, dht11_reading_t *reading)
+{
+    if (fixed == NULL || reading == NULL) {
         return DHT11_ERR_INVALID_ARG;
     }
 
-    if (!dht11_is_ready_for_reading(handle)) {
-        return DHT11_ERR_TOO_SOON;
+    reading->humidity = (float)fixed->humidity_x10 / 10.0f;
+    reading->temperature = (float)fixed->temperature_x10 / 10.0f;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_convert_raw_to_fixed(const dht11_raw_data_t *raw_data, dht11_reading_fixed_t *reading)
+{
+    if (raw_data == NULL || reading == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    return convert_raw(&default_config, raw_data, reading);
+}
+
+dht11_result_t dht11_convert_raw_to_reading(const dht11_raw_data_t *raw_data, dht11_reading_t *reading)
+{
+    dht11_reading_fixed_t fixed;
+
+    if (raw_data == NULL || reading == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    return wrap_conversion(convert_raw(&default_config, raw_data, &fixed), &fixed, reading);
+}
+
+dht11_result_t dht11_convert_raw_variant_fixed(const dht11_variant_t *variant, const dht11_raw_data_t *raw_data,
+                                               dht11_reading_fixed_t *reading)
+{
+    dht11_config_t config;
+
+    if (raw_data == NULL || reading == NULL || dht11_config_for_variant(&config, variant) != DHT11_OK) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    return convert_raw(&config, raw_data, reading);
+}
+
+dht11_result_t dht11_convert_raw_variant(const dht11_variant_t *variant, const dht11_raw_data_t *raw_data,
+                                         dht11_reading_t *reading)
+{
+    dht11_reading_fixed_t fixed;
+
+    if (reading == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    return wrap_conversion(dht11_convert_raw_variant_fixed(variant, raw_data, &fixed), &fixed, reading);
+}
+
+static bool transaction_in_progress(const dht11_handle_t *handle)
+{
+    return handle->state == DHT11_STATE_START_SIGNAL || handle->state == DHT11_STATE_RECEIVING;
+}
+
+
+// Every transaction decodes into the handle's decoder from scratch
+static void start_frame_decoder(dht11_handle_t *handle)
+{
+    dht11_decoder_reset(&handle->decoder);
+    handle->decoder.timing = &handle->bit_timing;
+    handle->decoder.threshold_us = handle->threshold_us;
+    handle->correction_attempted = false;
+    handle->frame_corrected = false;
+}
+
+
+static uint16_t learn_width(uint16_t learned_x16, uint32_t sample_x16)
+{
+    // The first frame seeds the cluster, later ones move it by a fraction
+    if (learned_x16 == 0) {
+        return (uint16_t)sample_x16;
+    }
+
+    int32_t delta = (int32_t)sample_x16 - (int32_t)learned_x16;
+    return (uint16_t)((int32_t)learned_x16 + delta / (1 << DHT11_ADAPTIVE_WEIGHT_SHIFT));
+}
+
+
+static void learn_bit_timing(dht11_handle_t *handle)
+{
+    const dht11_edge_decoder_t *decoder = &handle->decoder;
+    uint32_t sums[2] = {0, 0};
+    uint32_t counts[2] = {0, 0};
+
+    for (int bit = 0; bit < DHT11_DATA_BITS; bit++) {
+        int one = (decoder->data_bytes[bit >> 3] >> (7 - (bit & 7))) & 1;
+        sums[one] += handle->bit_timing.high_us[bit];
+        counts[one]++;
+    }
+
+    if (counts[0] != 0) {
+        handle->zero_high_x16 = learn_width(handle->zero_high_x16, sums[0] * 16u / counts[0]);
+    }
+    if (counts[1] != 0) {
+        handle->one_high_x16 = learn_width(handle->one_high_x16, sums[1] * 16u / counts[1]);
+    }
+
+    if (handle->zero_high_x16 != 0 && handle->one_high_x16 != 0) {
+        handle->threshold_us = (uint8_t)((handle->zero_high_x16 + handle->one_high_x16 + 16u) / 32u);
+    }
+}
+
+
+// An all-zero frame passes the checksum, so a threshold above every high
+// pulse of the frame would go unnoticed without this check
+static bool frame_is_blank(const dht11_edge_decoder_t *decoder)
+{
+    for (int i = 0; i < DHT11_DATA_BYTES; i++) {
+        if (decoder->data_bytes[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// In adaptive mode a checksum failure or a blank frame is decided again with
+// a threshold split from its own pulse widths
+static dht11_result_t resplit_frame(dht11_handle_t *handle, dht11_raw_data_t *raw_data, dht11_result_t result)
+{
+    dht11_edge_decoder_t *decoder = &handle->decoder;
+
+    if (result != DHT11_ERR_CHECKSUM && !(result == DHT11_OK && frame_is_blank(decoder))) {
+        return result;
+    }
+
+    uint8_t original_us = decoder->threshold_us;
+    uint8_t split_us = dht11_decoder_split_threshold(decoder);
+    if (split_us == 0 || split_us == original_us) {
+        return result;
+    }
+
+    dht11_decoder_redecide(decoder, split_us);
+    dht11_result_t resplit = dht11_decoder_finish(decoder, raw_data);
+    if (resplit != DHT11_OK) {
+        dht11_decoder_redecide(decoder, original_us);
+        dht11_decoder_finish(decoder, raw_data);
+        return result;
+    }
+
+    return resplit;
+}
+
+
+// Checks the decoded frame, then tries the opt-in recovery steps before a
+// checksum failure costs another sampling period
+static dht11_result_t finish_frame(dht11_handle_t *handle, dht11_raw_data_t *raw_data)
+{
+    dht11_edge_decoder_t *decoder = &handle->decoder;
+    dht11_result_t result = dht11_decoder_finish(decoder, raw_data);
+
+    if (handle->adaptive_threshold) {
+        result = resplit_frame(handle, raw_data, result);
+    }
+
+    if (result == DHT11_ERR_CHECKSUM && handle->error_correction) {
+        handle->correction_attempted = true;
+        if (dht11_decoder_correct(decoder)) {
+            handle->frame_corrected = true;
+            result = dht11_decoder_finish(decoder, raw_data);
+        }
+    }
+
+    if (result == DHT11_OK && handle->adaptive_threshold) {
+        learn_bit_timing(handle);
     }
-    uint8_t data_bytes[DHT11_DATA_BYTES] = {0};
 
-    // Step 1: Send start signal
+    return result;
+}
+
+
+static dht11_result_t send_start_signal_low(dht11_handle_t *handle)
+{
+    start_frame_decoder(handle);
+
     nhal_result_t pin_result = nhal_pin_set_direction(handle->pin_ctx, NHAL_PIN_DIR_OUTPUT, NHAL_PIN_PMODE_PULL_UP);
     if (pin_result != NHAL_OK) {
         return DHT11_ERR_PIN_ERROR;
     }
 
-    // Pull low for 18ms
     pin_result = nhal_pin_set_state(handle->pin_ctx, NHAL_PIN_LOW);
     if (pin_result != NHAL_OK) {
         return DHT11_ERR_PIN_ERROR;
     }
-    nhal_delay_milliseconds(DHT11_START_SIGNAL_MS);
 
+    return DHT11_OK;
+}
+
+
+static dht11_result_t release_line(dht11_handle_t *handle)
+{
     // Pull high for 20-40us
-    pin_result = nhal_pin_set_state(handle->pin_ctx, NHAL_PIN_HIGH);
+    nhal_result_t pin_result = nhal_pin_set_state(handle->pin_ctx, NHAL_PIN_HIGH);
     if (pin_result != NHAL_OK) {
         return DHT11_ERR_PIN_ERROR;
     }
-    nhal_delay_microseconds(DHT11_START_SIGNAL_HIGH_US);
+    nhal_delay_microseconds(handle->config.start_signal_high_us);
 
-    // Step 2: Switch to input mode and wait for DHT11 response
+    // Switch to input mode so the DHT11 can drive the line
     pin_result = nhal_pin_set_direction(handle->pin_ctx, NHAL_PIN_DIR_INPUT, NHAL_PIN_PMODE_PULL_UP);
     if (pin_result != NHAL_OK) {
         return DHT11_ERR_PIN_ERROR;
     }
 
+    return DHT11_OK;
+}
+
+
+static dht11_result_t receive_oversampled(dht11_handle_t *handle, dht11_raw_data_t *raw_data)
+{
+    const dht11_sampler_t *sampler = handle->sampler;
+
+    uint32_t start_us = (uint32_t)nhal_get_timestamp_microseconds();
+    if (sampler->sample(sampler->ctx, handle->sample_buffer, handle->sample_count, handle->sample_period_us) != NHAL_OK) {
+        return DHT11_ERR_PIN_ERROR;
+    }
+
+    // The bus is idle from here on, decoding works on the buffer alone
+    dht11_decoder_status_t status = dht11_oversample_decode(handle, start_us);
+    if (status == DHT11_DECODER_DESYNC) {
+        return DHT11_ERR_INVALID_DATA;
+    }
+    if (status != DHT11_DECODER_COMPLETE) {
+        return (handle->decoder.edge_count == 0) ? DHT11_ERR_NO_RESPONSE : DHT11_ERR_TIMEOUT;
+    }
+
+    handle->last_reading_time_ms = nhal_get_timestamp_milliseconds();
+    return finish_frame(handle, raw_data);
+}
+
+
+static dht11_result_t receive_frame(dht11_handle_t *handle, dht11_raw_data_t *raw_data)
+{
+    dht11_edge_decoder_t *decoder = &handle->decoder;
+
+    dht11_result_t result = release_line(handle);
+    if (result != DHT11_OK) {
+        return result;
+    }
+    dht11_stats_mark(handle);
+
+    if (handle->acquisition == DHT11_ACQ_OVERSAMPLED) {
+        return receive_oversampled(handle, raw_data);
+    }
+
     // Wait for DHT11 to pull low (response signal)
-    if (!wait_for_pin_state(handle->pin_ctx, NHAL_PIN_LOW, DHT11_TIMEOUT_US)) {
+    if (!wait_for_pin_state(handle->pin_ctx, NHAL_PIN_LOW, handle->config.response_timeout_us, NULL)) {
         return DHT11_ERR_NO_RESPONSE;
     }
 
     // Wait for DHT11 to pull high (preparation for data transmission)
-    if (!wait_for_pin_state(handle->pin_ctx, NHAL_PIN_HIGH, DHT11_TIMEOUT_US)) {
+    if (!wait_for_pin_state(handle->pin_ctx, NHAL_PIN_HIGH, handle->config.response_timeout_us, NULL)) {
         return DHT11_ERR_NO_RESPONSE;
     }
 
-    // Step 3: Read 40 bits of data
-    for (int byte_idx = 0; byte_idx < DHT11_DATA_BYTES; byte_idx++) {
-        for (int bit_idx = 7; bit_idx >= 0; bit_idx--) {
-            // Wait for bit transmission to start (low signal)
-            if (!wait_for_pin_state(handle->pin_ctx, NHAL_PIN_LOW, DHT11_TIMEOUT_US)) {
-                return DHT11_ERR_TIMEOUT;
-            }
-
-            // Measure the high pulse duration to determine bit value
-            uint32_t high_duration = measure_pulse_duration(handle->pin_ctx, NHAL_PIN_HIGH, DHT11_TIMEOUT_US);
-            if (high_duration == 0) {
-                return DHT11_ERR_TIMEOUT;
-            }
+    // Read 40 bits of data; the first bit starts when the response high phase ends
+    uint32_t bit_start_timeout_us = handle->config.response_timeout_us;
+    bool complete = false;
+    while (!complete) {
+        // Wait for bit transmission to start (low signal)
+        uint32_t low_start_us;
+        if (!wait_for_pin_state(handle->pin_ctx, NHAL_PIN_LOW, bit_start_timeout_us, &low_start_us)) {
+            return DHT11_ERR_TIMEOUT;
+        }
+        if (decoder->bit_count == 0) {
+            // The response ends where the first bit starts
+            dht11_stats_mark(handle);
+        }
+        bit_start_timeout_us = handle->config.bit_low_timeout_us;
 
-            // Bit decision: >threshold = '1', <threshold = '0'
-            if (high_duration > DHT11_PULSE_THRESHOLD_US) {
-                data_bytes[byte_idx] |= (1 << bit_idx);
-            }
+        // Measure the high pulse duration to determine bit value
+        uint32_t high_start_us;
+        uint32_t high_duration;
+        if (!measure_pulse_duration(handle->pin_ctx, NHAL_PIN_HIGH, handle->config.bit_low_timeout_us,
+                                    handle->config.bit_high_timeout_us, &high_start_us, &high_duration)) {
+            return DHT11_ERR_TIMEOUT;
         }
-    }
 
-    // Step 4: Parse received data
-    raw_data->humidity_integer = data_bytes[0];
-    raw_data->humidity_decimal = data_bytes[1];
-    raw_data->temperature_integer = data_bytes[2];
-    raw_data->temperature_decimal = data_bytes[3];
-    raw_data->checksum = data_bytes[4];
+        complete = dht11_decoder_push_bit(decoder, high_start_us - low_start_us, high_duration);
+    }
 
     // Update last reading time
     handle->last_reading_time_ms = nhal_get_timestamp_milliseconds();
 
-    // Verify checksum
-    if (!dht11_verify_checksum(raw_data)) {
-        return DHT11_ERR_CHECKSUM;
+    // Parse received data and verify checksum
+    return finish_frame(handle, raw_data);
+}
+
+static dht11_result_t blocking_transaction(dht11_handle_t *handle, dht11_raw_data_t *raw_data)
+{
+    if (transaction_in_progress(handle)) {
+        return DHT11_ERR_IN_PROGRESS;
     }
 
-    return DHT11_OK;
+    if (!dht11_is_ready_for_reading(handle)) {
+        return DHT11_ERR_TOO_SOON;
+    }
+
+    // Step 1: Send start signal, pull low for 18ms
+    dht11_stats_begin(handle);
+    dht11_result_t result = send_start_signal_low(handle);
+    if (result != DHT11_OK) {
+        return result;
+    }
+    nhal_delay_milliseconds(handle->config.start_signal_ms);
+
+    // Step 2: Release the line and receive the response and data bits
+    return receive_frame(handle, raw_data);
 }
 
-dht11_result_t dht11_read(dht11_handle_t *handle, dht11_reading_t *reading)
+dht11_result_t dht11_read_raw(dht11_handle_t *handle, dht11_raw_data_t *raw_data)
 {
-    if (handle == NULL || reading == NULL) {
+    if (handle == NULL || raw_data == NULL) {
         return DHT11_ERR_INVALID_ARG;
     }
 
-    dht11_raw_data_t raw_data;
-    dht11_result_t result = dht11_read_raw(handle, &raw_data);
+    dht11_result_t result = blocking_transaction(handle, raw_data);
+    dht11_stats_end(handle, result, handle->acquisition != DHT11_ACQ_OVERSAMPLED);
+    return result;
+}
+
+dht11_result_t dht11_read_edges(dht11_handle_t *handle, uint32_t *edge_times_us, size_t capacity, size_t *edge_count)
+{
+    if (handle == NULL || edge_times_us == NULL || edge_count == NULL || capacity < DHT11_FRAME_EDGES) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    *edge_count = 0;
+
+    if (transaction_in_progress(handle)) {
+        return DHT11_ERR_IN_PROGRESS;
+    }
+
+    if (!dht11_is_ready_for_reading(handle)) {
+        return DHT11_ERR_TOO_SOON;
+    }
+
+    dht11_result_t result = send_start_signal_low(handle);
+    if (result != DHT11_OK) {
+        return result;
+    }
+    nhal_delay_milliseconds(handle->config.start_signal_ms);
+
+    result = release_line(handle);
+    if (result != DHT11_OK) {
+        return result;
+    }
+
+    result = capture_edges(handle, edge_times_us, DHT11_FRAME_EDGES, edge_count);
     if (result != DHT11_OK) {
         return result;
     }
 
-    return dht11_convert_raw_to_reading(&raw_data, reading);
+    if (*edge_count == 0) {
+        return DHT11_ERR_NO_RESPONSE;
+    }
+
+    if (*edge_count < DHT11_DECODER_MIN_EDGES) {
+        return DHT11_ERR_TIMEOUT;
+    }
+
+    handle->last_reading_time_ms = nhal_get_timestamp_milliseconds();
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_decode_edges(const uint32_t *edge_times_us, size_t edge_count, dht11_raw_data_t *raw_data)
+{
+    if (edge_times_us == NULL || raw_data == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    if (edge_count < 2) {
+        return DHT11_ERR_NO_RESPONSE;
+    }
+
+    if (edge_count < DHT11_DECODER_MIN_EDGES) {
+        return DHT11_ERR_TIMEOUT;
+    }
+
+    dht11_edge_decoder_t decoder;
+    dht11_decoder_reset(&decoder);
+
+    for (size_t i = 0; i < DHT11_DECODER_MIN_EDGES; i++) {
+        dht11_decoder_push(&decoder, edge_times_us[i]);
+    }
+
+    return dht11_decoder_finish(&decoder, raw_data);
+}
+
+// Seqlock writer: the sequence is odd while the words are being replaced
+static void publish_latest(dht11_handle_t *handle, const dht11_reading_fixed_t *reading)
+{
+    dht11_latest_t *latest = &handle->latest;
+    uint32_t sequence = __atomic_load_n(&latest->sequence, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&latest->sequence, sequence + 1u, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&latest->temperature_x10, (uint32_t)(int32_t)reading->temperature_x10, __ATOMIC_RELAXED);
+    __atomic_store_n(&latest->humidity_x10, (uint32_t)(int32_t)reading->humidity_x10, __ATOMIC_RELAXED);
+    __atomic_store_n(&latest->time_ms, handle->last_reading_time_ms, __ATOMIC_RELAXED);
+    __atomic_store_n(&latest->sequence, sequence + 2u, __ATOMIC_RELEASE);
+}
+
+// An outlier leaves reading untouched, so the caller never sees it
+static dht11_result_t record_reading(dht11_handle_t *handle, const dht11_raw_data_t *raw_data, dht11_reading_fixed_t *reading)
+{
+    dht11_reading_fixed_t converted;
+
+    dht11_result_t result = convert_raw(&handle->config, raw_data, &converted);
+    if (result != DHT11_OK) {
+        if (result == DHT11_ERR_INVALID_DATA) {
+            *reading = converted;
+        }
+        return result;
+    }
+
+    if (handle->filter != NULL) {
+        result = dht11_filter_push(handle->filter, &converted, reading);
+        if (result != DHT11_OK) {
+            return result;
+        }
+    } else {
+        *reading = converted;
+    }
+
+    publish_latest(handle, reading);
+    if (handle->cache_max_age_ms != 0) {
+        handle->cached_reading = *reading;
+        handle->cached_time_ms = handle->last_reading_time_ms;
+        handle->cache_valid = true;
+    }
+
+    return DHT11_OK;
+}
+
+
+static void complete_transaction(dht11_handle_t *handle, dht11_result_t result)
+{
+    // The raw result stands for frames out of range, as for dht11_read_raw(),
+    // but a filter rejection fails the transaction like a blocking read
+    if (result == DHT11_OK) {
+        dht11_reading_fixed_t reading;
+        if (record_reading(handle, &handle->async_raw_data, &reading) == DHT11_ERR_OUTLIER) {
+            result = DHT11_ERR_OUTLIER;
+        }
+    }
+
+    handle->async_result = result;
+    handle->state = DHT11_STATE_COMPLETE;
+    dht11_stats_end(handle, result, handle->acquisition == DHT11_ACQ_POLLING);
+}
+
+
+static dht11_result_t begin_interrupt_receive(dht11_handle_t *handle)
+{
+    dht11_edge_ring_t *ring = &handle->edge_ring;
+
+    dht11_result_t result = release_line(handle);
+    if (result != DHT11_OK) {
+        complete_transaction(handle, result);
+        return result;
+    }
+    dht11_stats_mark(handle);
+
+    // Discard edges caused by driving the start signal
+    RING_STORE_RELEASE(&ring->tail, RING_LOAD_ACQUIRE(&ring->head));
+    start_frame_decoder(handle);
+    handle->last_activity_us = (uint32_t)nhal_get_timestamp_microseconds();
+    handle->state = DHT11_STATE_RECEIVING;
+
+    return DHT11_ERR_IN_PROGRESS;
+}
+
+
+static dht11_result_t drain_edge_ring(dht11_handle_t *handle)
+{
+    dht11_edge_ring_t *ring = &handle->edge_ring;
+    dht11_edge_decoder_t *decoder = &handle->decoder;
+    uint16_t tail = ring->tail;
+    uint16_t head = RING_LOAD_ACQUIRE(&ring->head);
+
+
+    while (tail != head) {
+        uint16_t slot = tail & (DHT11_EDGE_RING_SIZE - 1u);
+        uint32_t timestamp_us = ring->timestamp_us[slot];
+        nhal_pin_state_t level = (nhal_pin_state_t)ring->level[slot];
+        tail++;
+
+        dht11_decoder_status_t status = dht11_decoder_push_edge(decoder, level, timestamp_us);
+        if (status == DHT11_DECODER_DESYNC) {
+            RING_STORE_RELEASE(&ring->tail, tail);
+            complete_transaction(handle, DHT11_ERR_INVALID_DATA);
+            return DHT11_ERR_INVALID_DATA;
+        }
+
+        if (status != DHT11_DECODER_SKIPPED) {
+            handle->last_activity_us = timestamp_us;
+        }
+
+        if (status == DHT11_DECODER_PENDING && decoder->edge_count == DHT11_DECODER_FIRST_BIT_RISE) {
+            // The response ends where the first bit starts
+            dht11_stats_mark_at(handle, timestamp_us);
+        }
+
+        if (status == DHT11_DECODER_COMPLETE) {
+            RING_STORE_RELEASE(&ring->tail, tail);
+            handle->last_reading_time_ms = nhal_get_timestamp_milliseconds();
+            complete_transaction(handle, finish_frame(handle, &handle->async_raw_data));
+            return handle->async_result;
+        }
+    }
+    RING_STORE_RELEASE(&ring->tail, tail);
+
+    // Edges queued while draining keep the frame alive
+    uint32_t now_us = (uint32_t)nhal_get_timestamp_microseconds();
+    if (RING_LOAD_ACQUIRE(&ring->head) != tail) {
+        return DHT11_ERR_IN_PROGRESS;
+    }
+
+    uint32_t idle_us = now_us - handle->last_activity_us;
+    if ((int32_t)idle_us >= (int32_t)idle_timeout_us(&handle->config, decoder->edge_count)) {
+        dht11_result_t result = (decoder->edge_count == 0) ? DHT11_ERR_NO_RESPONSE : DHT11_ERR_TIMEOUT;
+        complete_transaction(handle, result);
+        return result;
+    }
+
+    return DHT11_ERR_IN_PROGRESS;
+}
+
+dht11_result_t dht11_set_acquisition_mode(dht11_handle_t *handle, dht11_acquisition_t acquisition)
+{
+    if (handle == NULL || (acquisition != DHT11_ACQ_POLLING && acquisition != DHT11_ACQ_INTERRUPT &&
+                           acquisition != DHT11_ACQ_OVERSAMPLED)) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    if (acquisition == DHT11_ACQ_OVERSAMPLED && handle->sampler == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    if (transaction_in_progress(handle)) {
+        return DHT11_ERR_IN_PROGRESS;
+    }
+
+    handle->acquisition = acquisition;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_set_sampler(dht11_handle_t *handle, const dht11_sampler_t *sampler,
+                                 uint32_t *buffer, size_t sample_count, uint32_t period_us)
+{
+    if (handle == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    if (sampler != NULL && (sampler->sample == NULL || buffer == NULL || sample_count == 0 || period_us == 0)) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    if (transaction_in_progress(handle)) {
+        return DHT11_ERR_IN_PROGRESS;
+    }
+
+    // Detaching the sampler falls back to polling
+    if (sampler == NULL && handle->acquisition == DHT11_ACQ_OVERSAMPLED) {
+        handle->acquisition = DHT11_ACQ_POLLING;
+    }
+
+    handle->sampler = sampler;
+    handle->sample_buffer = (sampler != NULL) ? buffer : NULL;
+    handle->sample_count = (sampler != NULL) ? sample_count : 0;
+    handle->sample_period_us = (sampler != NULL) ? period_us : 0;
+    return DHT11_OK;
+}
+
+void dht11_on_edge(dht11_handle_t *handle, nhal_pin_state_t level, uint32_t timestamp_us)
+{
+    if (handle == NULL) {
+        return;
+    }
+
+    dht11_edge_ring_t *ring = &handle->edge_ring;
+    uint16_t head = ring->head;
+
+    if ((uint16_t)(head - RING_LOAD_ACQUIRE(&ring->tail)) >= DHT11_EDGE_RING_SIZE) {
+        ring->dropped++;
+        return;
+    }
+
+    uint16_t slot = head & (DHT11_EDGE_RING_SIZE - 1u);
+    ring->timestamp_us[slot] = timestamp_us;
+    ring->level[slot] = (uint8_t)level;
+    RING_STORE_RELEASE(&ring->head, (uint16_t)(head + 1u));
+}
+
+dht11_result_t dht11_read_start(dht11_handle_t *handle)
+{
+    if (handle == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    if (transaction_in_progress(handle)) {
+        dht11_stats_end(handle, DHT11_ERR_IN_PROGRESS, false);
+        return DHT11_ERR_IN_PROGRESS;
+    }
+
+    if (!dht11_is_ready_for_reading(handle)) {
+        dht11_stats_end(handle, DHT11_ERR_TOO_SOON, false);
+        return DHT11_ERR_TOO_SOON;
+    }
+
+    dht11_stats_begin(handle);
+    dht11_result_t result = send_start_signal_low(handle);
+    if (result != DHT11_OK) {
+        dht11_stats_end(handle, result, false);
+        return result;
+    }
+
+    handle->start_signal_time_ms = nhal_get_timestamp_milliseconds();
+    handle->async_result = DHT11_ERR_IN_PROGRESS;
+    handle->state = DHT11_STATE_START_SIGNAL;
+
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_read_poll(dht11_handle_t *handle)
+{
+    if (handle == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    switch (handle->state) {
+    case DHT11_STATE_START_SIGNAL: {
+        // The millisecond tick may advance right after the start timestamp was
+        // taken, so require one extra tick to guarantee the full low phase
+        uint32_t elapsed_ms = nhal_get_timestamp_milliseconds() - handle->start_signal_time_ms;
+        if (elapsed_ms <= handle->config.start_signal_ms) {
+            return DHT11_ERR_IN_PROGRESS;
+        }
+
+        if (handle->acquisition == DHT11_ACQ_INTERRUPT) {
+            return begin_interrupt_receive(handle);
+        }
+
+        complete_transaction(handle, receive_frame(handle, &handle->async_raw_data));
+        return handle->async_result;
+    }
+
+    case DHT11_STATE_RECEIVING:
+        return drain_edge_ring(handle);
+
+    case DHT11_STATE_COMPLETE:
+        return handle->async_result;
+
+    case DHT11_STATE_IDLE:
+    default:
+        return DHT11_ERR_INVALID_ARG;
+    }
+}
+
+dht11_result_t dht11_read_result(dht11_handle_t *handle, dht11_raw_data_t *raw_data)
+{
+    if (handle == NULL || raw_data == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    switch (handle->state) {
+    case DHT11_STATE_START_SIGNAL:
+    case DHT11_STATE_RECEIVING:
+        return DHT11_ERR_IN_PROGRESS;
+
+    case DHT11_STATE_COMPLETE:
+        *raw_data = handle->async_raw_data;
+        return handle->async_result;
+
+    case DHT11_STATE_IDLE:
+    default:
+        return DHT11_ERR_INVALID_ARG;
+    }
+}
+
+dht11_result_t dht11_set_adaptive_threshold(dht11_handle_t *handle, bool enable)
+{
+    if (handle == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    handle->adaptive_threshold = enable;
+    handle->threshold_us = handle->config.bit_threshold_us;
+    handle->zero_high_x16 = 0;
+    handle->one_high_x16 = 0;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_get_bit_threshold(const dht11_handle_t *handle, uint8_t *threshold_us)
+{
+    if (handle == NULL || threshold_us == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    *threshold_us = handle->threshold_us;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_set_error_correction(dht11_handle_t *handle, bool enable)
+{
+    if (handle == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    handle->error_correction = enable;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_get_frame_corrected(const dht11_handle_t *handle, bool *corrected)
+{
+    if (handle == NULL || corrected == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    *corrected = handle->frame_corrected;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_set_cache_max_age(dht11_handle_t *handle, uint32_t max_age_ms)
+{
+    if (handle == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    handle->cache_max_age_ms = max_age_ms;
+    if (max_age_ms == 0) {
+        handle->cache_valid = false;
+    }
+
+    return DHT11_OK;
+}
+
+// Like dht11_read_raw(), but the statistics count the result after the
+// conversion and filter, which is the one the caller receives
+static dht11_result_t read_reading(dht11_handle_t *handle, dht11_reading_fixed_t *reading)
+{
+    dht11_raw_data_t raw_data;
+
+    dht11_result_t result = blocking_transaction(handle, &raw_data);
+    if (result == DHT11_OK) {
+        result = record_reading(handle, &raw_data, reading);
+    }
+    dht11_stats_end(handle, result, handle->acquisition != DHT11_ACQ_OVERSAMPLED);
+    return result;
+}
+
+static dht11_result_t read_cached_unlocked(dht11_handle_t *handle, dht11_reading_fixed_t *reading, dht11_cache_info_t *info)
+{
+    uint32_t now_ms = nhal_get_timestamp_milliseconds();
+    uint32_t age_ms = now_ms - handle->cached_time_ms;
+
+    if (handle->cache_valid && age_ms <= handle->cache_max_age_ms) {
+        *reading = handle->cached_reading;
+        if (info != NULL) {
+            info->age_ms = age_ms;
+            info->fresh = true;
+        }
+        return DHT11_OK;
+    }
+
+    dht11_result_t result = read_reading(handle, reading);
+    if (result == DHT11_OK) {
+        if (info != NULL) {
+            info->age_ms = 0;
+            info->fresh = true;
+        }
+        return DHT11_OK;
+    }
+
+    if (handle->cache_valid) {
+        // Serve the stale value; only a rate-limited refresh counts as success
+        *reading = handle->cached_reading;
+        if (info != NULL) {
+            info->age_ms = age_ms;
+            info->fresh = false;
+        }
+        if (result == DHT11_ERR_TOO_SOON) {
+            return DHT11_OK;
+        }
+    }
+
+    return result;
+}
+
+static dht11_result_t read_unlocked(dht11_handle_t *handle, bool cached, dht11_reading_fixed_t *reading, dht11_cache_info_t *info)
+{
+    if (cached || handle->cache_max_age_ms != 0) {
+        return read_cached_unlocked(handle, reading, info);
+    }
+
+    dht11_result_t result = read_reading(handle, reading);
+    if (result == DHT11_OK && info != NULL) {
+        info->age_ms = 0;
+        info->fresh = true;
+    }
+    return result;
+}
+
+// Readings are at most a few hundred tenths, so this never matches a real one
+#define READING_UNSET   INT16_MIN
+
+// Runs a read for the first caller and hands its result to every caller
+// that arrives while it is in flight; like an unlocked read, a caller's
+// reading is only written when the read produced a value
+static dht11_result_t coalesced_read(dht11_handle_t *handle, bool cached, dht11_reading_fixed_t *reading, dht11_cache_info_t *info)
+{
+    const dht11_lock_ops_t *ops = handle->lock_ops;
+
+    if (ops == NULL) {
+        return read_unlocked(handle, cached, reading, info);
+    }
+
+    ops->lock(ops->ctx);
+    if (handle->read_in_flight) {
+        uint32_t generation = handle->read_generation;
+        while (handle->read_generation == generation) {
+            ops->wait(ops->ctx);
+        }
+    } else {
+        handle->read_in_flight = true;
+        ops->unlock(ops->ctx);
+
+        dht11_reading_fixed_t shared_reading = {READING_UNSET, READING_UNSET};
+        dht11_cache_info_t shared_info = {0};
+        dht11_result_t result = read_unlocked(handle, cached, &shared_reading, &shared_info);
+
+        ops->lock(ops->ctx);
+        handle->shared_result = result;
+        handle->shared_reading = shared_reading;
+        handle->shared_info = shared_info;
+        handle->read_in_flight = false;
+        handle->read_generation++;
+        ops->notify_all(ops->ctx);
+    }
+
+    dht11_result_t result = handle->shared_result;
+    if (handle->shared_reading.humidity_x10 != READING_UNSET) {
+        *reading = handle->shared_reading;
+        if (info != NULL) {
+            *info = handle->shared_info;
+        }
+    }
+    ops->unlock(ops->ctx);
+
+    return result;
+}
+
+dht11_result_t dht11_set_lock_ops(dht11_handle_t *handle, const dht11_lock_ops_t *lock_ops)
+{
+    if (handle == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    if (lock_ops != NULL &&
+        (lock_ops->lock == NULL || lock_ops->unlock == NULL || lock_ops->wait == NULL || lock_ops->notify_all == NULL)) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    handle->lock_ops = lock_ops;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_get_latest_fixed(const dht11_handle_t *handle, dht11_reading_fixed_t *reading, uint32_t *time_ms)
+{
+    if (handle == NULL || reading == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    const dht11_latest_t *latest = &handle->latest;
+
+    for (int attempt = 0; attempt < DHT11_LATEST_MAX_RETRIES; attempt++) {
+        uint32_t before = __atomic_load_n(&latest->sequence, __ATOMIC_ACQUIRE);
+        if (before == 0) {
+            return DHT11_ERR_NO_DATA;
+        }
+        if (before & 1u) {
+            continue;
+        }
+
+        uint32_t temperature_x10 = __atomic_load_n(&latest->temperature_x10, __ATOMIC_RELAXED);
+        uint32_t humidity_x10 = __atomic_load_n(&latest->humidity_x10, __ATOMIC_RELAXED);
+        uint32_t published_ms = __atomic_load_n(&latest->time_ms, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&latest->sequence, __ATOMIC_RELAXED) == before) {
+            reading->temperature_x10 = (int16_t)(int32_t)temperature_x10;
+            reading->humidity_x10 = (int16_t)(int32_t)humidity_x10;
+            if (time_ms != NULL) {
+                *time_ms = published_ms;
+            }
+            return DHT11_OK;
+        }
+    }
+
+    return DHT11_ERR_IN_PROGRESS;
+}
+
+dht11_result_t dht11_get_latest(const dht11_handle_t *handle, dht11_reading_t *reading, uint32_t *time_ms)
+{
+    dht11_reading_fixed_t fixed;
+
+    if (reading == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    dht11_result_t result = dht11_get_latest_fixed(handle, &fixed, time_ms);
+    if (result == DHT11_OK) {
+        dht11_fixed_to_reading(&fixed, reading);
+    }
+    return result;
+}
+
+dht11_result_t dht11_read_cached_fixed(dht11_handle_t *handle, dht11_reading_fixed_t *reading, dht11_cache_info_t *info)
+{
+    if (handle == NULL || reading == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    return coalesced_read(handle, true, reading, info);
+}
+
+dht11_result_t dht11_read_fixed(dht11_handle_t *handle, dht11_reading_fixed_t *reading)
+{
+    if (handle == NULL || reading == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    return coalesced_read(handle, false, reading, NULL);
+}
+
+static dht11_result_t read_float(dht11_handle_t *handle, bool cached, dht11_reading_t *reading, dht11_cache_info_t *info)
+{
+    dht11_reading_fixed_t fixed = {READING_UNSET, READING_UNSET};
+
+    if (handle == NULL || reading == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    // Failed reads may still hand back a value, e.g. a stale cached one
+    dht11_result_t result = coalesced_read(handle, cached, &fixed, info);
+    if (fixed.humidity_x10 != READING_UNSET) {
+        dht11_fixed_to_reading(&fixed, reading);
+    }
+    return result;
+}
+
+dht11_result_t dht11_read_cached(dht11_handle_t *handle, dht11_reading_t *reading, dht11_cache_info_t *info)
+{
+    return read_float(handle, true, reading, info);
+}
+
+dht11_result_t dht11_read(dht11_handle_t *handle, dht11_reading_t *reading)
+{
+    return read_float(handle, false, reading, NULL);
 }
@@ -0,0 +1,297 @@
+/**
+ * @file dht11_aggregate.c
+ * @brief Implementation of cascading rolling-window aggregates
+ *
+ * Every level's open bucket always holds the bucket the last reading falls
+ * in, so the open buckets of the finer levels all lie inside the open bucket
+ * of a coarser one. A query of level L therefore combines the closed buckets
+ * of L with the open buckets of levels 0 to L.
+ */
+
+#include "dht11_aggregate.h"
+#include <string.h>
+
+typedef enum {
+    QUEUE_HUMIDITY_MIN = 0,
+    QUEUE_HUMIDITY_MAX,
+    QUEUE_TEMPERATURE_MIN,
+    QUEUE_TEMPERATURE_MAX,
+    QUEUE_COUNT
+} queue_kind_t;
+
+
+static uint8_t ring_at(uint8_t head, uint8_t offset)
+{
+    return (uint8_t)((head + offset) % DHT11_AGGREGATE_MAX_BUCKETS);
+}
+
+
+static void bucket_clear(dht11_aggregate_bucket_t *bucket, uint32_t index)
+{
+    memset(bucket, 0, sizeof(*bucket));
+    bucket->index = index;
+}
+
+
+static int16_t min16(int16_t a, int16_t b)
+{
+    return (a < b) ? a : b;
+}
+
+
+static int16_t max16(int16_t a, int16_t b)
+{
+    return (a > b) ? a : b;
+}
+
+
+static void bucket_merge(dht11_aggregate_bucket_t *into, const dht11_aggregate_bucket_t *from)
+{
+    if (from->count == 0) {
+        return;
+    }
+
+    if (into->count == 0) {
+        into->min = from->min;
+        into->max = from->max;
+    } else {
+        into->min.humidity_x10 = min16(into->min.humidity_x10, from->min.humidity_x10);
+        into->min.temperature_x10 = min16(into->min.temperature_x10, from->min.temperature_x10);
+        into->max.humidity_x10 = max16(into->max.humidity_x10, from->max.humidity_x10);
+        into->max.temperature_x10 = max16(into->max.temperature_x10, from->max.temperature_x10);
+    }
+    into->count += from->count;
+    into->humidity_sum += from->humidity_sum;
+    into->temperature_sum += from->temperature_sum;
+}
+
+
+static dht11_aggregate_queue_t *level_queue(dht11_aggregate_level_t *level, queue_kind_t kind)
+{
+    switch (kind) {
+    case QUEUE_HUMIDITY_MIN: return &level->humidity_min;
+    case QUEUE_HUMIDITY_MAX: return &level->humidity_max;
+    case QUEUE_TEMPERATURE_MIN: return &level->temperature_min;
+    default: return &level->temperature_max;
+    }
+}
+
+
+static int16_t queue_key(const dht11_aggregate_bucket_t *bucket, queue_kind_t kind)
+{
+    switch (kind) {
+    case QUEUE_HUMIDITY_MIN: return bucket->min.humidity_x10;
+    case QUEUE_HUMIDITY_MAX: return bucket->max.humidity_x10;
+    case QUEUE_TEMPERATURE_MIN: return bucket->min.temperature_x10;
+    default: return bucket->max.temperature_x10;
+    }
+}
+
+
+// An older bucket can never be the extreme again once a newer one is at
+// least as extreme, since the newer one leaves the window later
+static void queue_push(dht11_aggregate_level_t *level, queue_kind_t kind, uint8_t slot)
+{
+    dht11_aggregate_queue_t *queue = level_queue(level, kind);
+    int16_t key = queue_key(&level->buckets[slot], kind);
+    bool is_min = (kind == QUEUE_HUMIDITY_MIN || kind == QUEUE_TEMPERATURE_MIN);
+
+    while (queue->length > 0) {
+        int16_t back = queue_key(&level->buckets[queue->slots[ring_at(queue->head, (uint8_t)(queue->length - 1u))]], kind);
+        if (is_min ? (key > back) : (key < back)) {
+            break;
+        }
+        queue->length--;
+    }
+
+    queue->slots[ring_at(queue->head, queue->length)] = slot;
+    queue->length++;
+}
+
+
+static void fifo_push(dht11_aggregate_level_t *level, const dht11_aggregate_bucket_t *bucket)
+{
+    uint8_t slot = ring_at(level->head, level->length);
+
+    level->buckets[slot] = *bucket;
+    level->length++;
+    level->count += bucket->count;
+    level->humidity_sum += bucket->humidity_sum;
+    level->temperature_sum += bucket->temperature_sum;
+
+    for (int kind = 0; kind < QUEUE_COUNT; kind++) {
+        queue_push(level, (queue_kind_t)kind, slot);
+    }
+}
+
+
+static void fifo_pop(dht11_aggregate_level_t *level)
+{
+    uint8_t slot = level->head;
+    const dht11_aggregate_bucket_t *bucket = &level->buckets[slot];
+
+    level->count -= bucket->count;
+    level->humidity_sum -= bucket->humidity_sum;
+    level->temperature_sum -= bucket->temperature_sum;
+
+    for (int kind = 0; kind < QUEUE_COUNT; kind++) {
+        dht11_aggregate_queue_t *queue = level_queue(level, (queue_kind_t)kind);
+        if (queue->length > 0 && queue->slots[queue->head] == slot) {
+            queue->head = ring_at(queue->head, 1);
+            queue->length--;
+        }
+    }
+
+    level->head = ring_at(level->head, 1);
+    level->length--;
+}
+
+
+// Drops closed buckets that fell out of a window ending in bucket index
+static void expire(dht11_aggregate_level_t *level, uint32_t index, uint8_t bucket_count)
+{
+    while (level->length > 0 && level->buckets[level->head].index + bucket_count <= index) {
+        fifo_pop(level);
+    }
+}
+
+
+static int16_t mean_of(int64_t sum, uint32_t count)
+{
+    int64_t half = count / 2u;
+    return (int16_t)((sum < 0) ? -((-sum + half) / count) : (sum + half) / count);
+}
+
+
+dht11_result_t dht11_aggregate_config_default(dht11_aggregate_config_t *config)
+{
+    if (config == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    config->bucket_ms[0] = DHT11_AGGREGATE_MINUTE_BUCKET_MS;
+    config->bucket_count[0] = DHT11_AGGREGATE_MINUTE_BUCKETS;
+    config->bucket_ms[1] = DHT11_AGGREGATE_HOUR_BUCKET_MS;
+    config->bucket_count[1] = DHT11_AGGREGATE_HOUR_BUCKETS;
+    config->bucket_ms[2] = DHT11_AGGREGATE_DAY_BUCKET_MS;
+    config->bucket_count[2] = DHT11_AGGREGATE_DAY_BUCKETS;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_aggregate_init(dht11_aggregate_t *aggregate, const dht11_aggregate_config_t *config)
+{
+    if (aggregate == NULL || config == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    for (size_t level = 0; level < DHT11_AGGREGATE_LEVELS; level++) {
+        if (config->bucket_ms[level] == 0 || config->bucket_count[level] < 2 ||
+            config->bucket_count[level] > DHT11_AGGREGATE_MAX_BUCKETS) {
+            return DHT11_ERR_INVALID_ARG;
+        }
+        if (level > 0 && (config->bucket_ms[level] <= config->bucket_ms[level - 1] ||
+                          config->bucket_ms[level] % config->bucket_ms[level - 1] != 0)) {
+            return DHT11_ERR_INVALID_ARG;
+        }
+    }
+
+    memset(aggregate, 0, sizeof(*aggregate));
+    aggregate->config = *config;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_aggregate_reset(dht11_aggregate_t *aggregate)
+{
+    if (aggregate == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    dht11_aggregate_config_t config = aggregate->config;
+    memset(aggregate, 0, sizeof(*aggregate));
+    aggregate->config = config;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_aggregate_push(dht11_aggregate_t *aggregate, const dht11_reading_fixed_t *reading,
+                                    uint32_t time_ms)
+{
+    if (aggregate == NULL || reading == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    if (aggregate->started) {
+        aggregate->elapsed_ms += (uint32_t)(time_ms - aggregate->last_time_ms);
+    }
+    aggregate->started = true;
+    aggregate->last_time_ms = time_ms;
+
+    // Close the buckets the reading has moved past, finest first so that
+    // each closed bucket reaches the coarser level before that one closes
+    for (size_t i = 0; i < DHT11_AGGREGATE_LEVELS; i++) {
+        dht11_aggregate_level_t *level = &aggregate->levels[i];
+        uint8_t bucket_count = aggregate->config.bucket_count[i];
+        uint32_t index = (uint32_t)(aggregate->elapsed_ms / aggregate->config.bucket_ms[i]);
+
+        if (index != level->open.index) {
+            dht11_aggregate_bucket_t closed = level->open;
+            bucket_clear(&level->open, index);
+            expire(level, index, bucket_count);
+
+            if (closed.count != 0) {
+                if (closed.index + bucket_count > index) {
+                    fifo_push(level, &closed);
+                }
+                if (i + 1 < DHT11_AGGREGATE_LEVELS) {
+                    bucket_merge(&aggregate->levels[i + 1].open, &closed);
+                }
+            }
+        }
+    }
+
+    dht11_aggregate_bucket_t single;
+    bucket_clear(&single, 0);
+    single.count = 1;
+    single.humidity_sum = reading->humidity_x10;
+    single.temperature_sum = reading->temperature_x10;
+    single.min = *reading;
+    single.max = *reading;
+    bucket_merge(&aggregate->levels[0].open, &single);
+
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_aggregate_query(const dht11_aggregate_t *aggregate, size_t level,
+                                     dht11_aggregate_window_t *window)
+{
+    if (aggregate == NULL || window == NULL || level >= DHT11_AGGREGATE_LEVELS) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    const dht11_aggregate_level_t *closed = &aggregate->levels[level];
+    dht11_aggregate_bucket_t total;
+    bucket_clear(&total, 0);
+
+    // Seed with the extremes and count of the closed buckets; their sums
+    // can exceed a bucket's, so they are added to the open ones at the end
+    if (closed->length > 0) {
+        total.count = closed->count;
+        total.min.humidity_x10 = closed->buckets[closed->humidity_min.slots[closed->humidity_min.head]].min.humidity_x10;
+        total.max.humidity_x10 = closed->buckets[closed->humidity_max.slots[closed->humidity_max.head]].max.humidity_x10;
+        total.min.temperature_x10 = closed->buckets[closed->temperature_min.slots[closed->temperature_min.head]].min.temperature_x10;
+        total.max.temperature_x10 = closed->buckets[closed->temperature_max.slots[closed->temperature_max.head]].max.temperature_x10;
+    }
+    for (size_t i = 0; i <= level; i++) {
+        bucket_merge(&total, &aggregate->levels[i].open);
+    }
+
+    if (total.count == 0) {
+        return DHT11_ERR_NO_DATA;
+    }
+
+    window->count = total.count;
+    window->min = total.min;
+    window->max = total.max;
+    window->mean.humidity_x10 = mean_of(closed->humidity_sum + total.humidity_sum, total.count);
+    window->mean.temperature_x10 = mean_of(closed->temperature_sum + total.temperature_sum, total.count);
+    return DHT11_OK;
+}
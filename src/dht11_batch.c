@@ -0,0 +1,124 @@
+/**
+ * @file dht11_batch.c
+ * @brief Implementation of batch conversion of raw DHT11 frames
+ */
+
+#include "dht11_batch.h"
+
+// Items per bitmap word, converted as one block
+#define BATCH_BLOCK     32u
+
+
+// Same checks as convert_raw() with the default config, without branches so
+// the loop vectorizes. ok[i] is set to 1 if frame i is valid.
+static void convert_block(const uint8_t *restrict humidity_integer, const uint8_t *restrict humidity_decimal,
+                          const uint8_t *restrict temperature_integer, const uint8_t *restrict temperature_decimal,
+                          const uint8_t *restrict checksum, size_t n,
+                          int16_t *restrict humidity_x10, int16_t *restrict temperature_x10, uint8_t *restrict ok)
+{
+    for (size_t i = 0; i < n; i++) {
+        uint8_t sum = (uint8_t)(humidity_integer[i] + humidity_decimal[i] + temperature_integer[i] + temperature_decimal[i]);
+        int16_t humidity = (int16_t)(humidity_integer[i] * 10 + humidity_decimal[i]);
+        int16_t temperature = (int16_t)(temperature_integer[i] * 10 + temperature_decimal[i]);
+
+        humidity_x10[i] = humidity;
+        temperature_x10[i] = temperature;
+        ok[i] = (uint8_t)((sum == checksum[i]) &
+                          (humidity >= DHT11_HUMIDITY_MIN_X10) & (humidity <= DHT11_HUMIDITY_MAX_X10) &
+                          (temperature >= DHT11_TEMPERATURE_MIN_X10) & (temperature <= DHT11_TEMPERATURE_MAX_X10));
+    }
+}
+
+
+static uint32_t pack_block(const uint8_t *ok, size_t n)
+{
+    uint32_t word = 0;
+
+    for (size_t j = 0; j < n; j++) {
+        word |= (uint32_t)ok[j] << j;
+    }
+
+    return word;
+}
+
+
+static size_t count_valid(const uint32_t *valid, size_t count)
+{
+    size_t total = 0;
+
+    for (size_t w = 0; w < DHT11_BATCH_BITMAP_WORDS(count); w++) {
+        total += (size_t)__builtin_popcount(valid[w]);
+    }
+
+    return total;
+}
+
+
+static bool out_is_valid(const dht11_batch_out_t *out)
+{
+    return out != NULL && out->humidity_x10 != NULL && out->temperature_x10 != NULL && out->valid != NULL;
+}
+
+
+dht11_result_t dht11_convert_batch(const dht11_raw_data_t *raw_data, size_t count,
+                                   const dht11_batch_out_t *out, size_t *valid_count)
+{
+    uint8_t bytes[DHT11_DATA_BYTES][BATCH_BLOCK];
+    uint8_t ok[BATCH_BLOCK];
+
+    if ((raw_data == NULL && count > 0) || !out_is_valid(out)) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    for (size_t base = 0; base < count; base += BATCH_BLOCK) {
+        size_t n = (count - base < BATCH_BLOCK) ? count - base : BATCH_BLOCK;
+
+        // 5-byte records do not load into vector lanes, so split the block first
+        for (size_t j = 0; j < n; j++) {
+            bytes[0][j] = raw_data[base + j].humidity_integer;
+            bytes[1][j] = raw_data[base + j].humidity_decimal;
+            bytes[2][j] = raw_data[base + j].temperature_integer;
+            bytes[3][j] = raw_data[base + j].temperature_decimal;
+            bytes[4][j] = raw_data[base + j].checksum;
+        }
+
+        convert_block(bytes[0], bytes[1], bytes[2], bytes[3], bytes[4], n,
+                      out->humidity_x10 + base, out->temperature_x10 + base, ok);
+        out->valid[base / BATCH_BLOCK] = pack_block(ok, n);
+    }
+
+    if (valid_count != NULL) {
+        *valid_count = count_valid(out->valid, count);
+    }
+
+    return DHT11_OK;
+}
+
+
+dht11_result_t dht11_convert_batch_soa(const dht11_raw_soa_t *raw_data, size_t count,
+                                       const dht11_batch_out_t *out, size_t *valid_count)
+{
+    uint8_t ok[BATCH_BLOCK];
+
+    if (raw_data == NULL || !out_is_valid(out) ||
+        (count > 0 && (raw_data->humidity_integer == NULL || raw_data->humidity_decimal == NULL ||
+                       raw_data->temperature_integer == NULL || raw_data->temperature_decimal == NULL ||
+                       raw_data->checksum == NULL))) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    for (size_t base = 0; base < count; base += BATCH_BLOCK) {
+        size_t n = (count - base < BATCH_BLOCK) ? count - base : BATCH_BLOCK;
+
+        convert_block(raw_data->humidity_integer + base, raw_data->humidity_decimal + base,
+                      raw_data->temperature_integer + base, raw_data->temperature_decimal + base,
+                      raw_data->checksum + base, n, out->humidity_x10 + base, out->temperature_x10 + base, ok);
+        out->valid[base / BATCH_BLOCK] = pack_block(ok, n);
+    }
+
+    if (valid_count != NULL) {
+        *valid_count = count_valid(out->valid, count);
+    }
+
+    return DHT11_OK;
+}
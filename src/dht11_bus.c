@@ -0,0 +1,178 @@
+/**
+ * @file dht11_bus.c
+ * @brief Implementation of the DHT11 multi-sensor bus scheduler
+ */
+
+#include "dht11_bus.h"
+
+
+// A failed transaction waits out the sampling period like a successful one,
+// so a dead sensor cannot take a data slot on every step
+static void back_off(dht11_handle_t *handle)
+{
+    handle->last_reading_time_ms = nhal_get_timestamp_milliseconds();
+}
+
+
+static void complete_handle(dht11_bus_t *bus, size_t index, dht11_result_t result)
+{
+    dht11_raw_data_t raw_data = {0};
+
+    if (result != DHT11_OK) {
+        back_off(bus->handles[index]);
+    }
+
+    dht11_read_result(bus->handles[index], &raw_data);
+    if (bus->callback != NULL) {
+        bus->callback(bus->handles[index], index, result, &raw_data, bus->user_data);
+    }
+}
+
+
+// Interrupt mode only releases the line when the start signal ends
+static bool needs_data_slot(const dht11_handle_t *handle)
+{
+    return handle->acquisition != DHT11_ACQ_INTERRUPT;
+}
+
+
+// Milliseconds until a start signal begun on the handle would end after the
+// last reserved data slot
+static uint32_t time_until_slot(const dht11_bus_t *bus, const dht11_handle_t *handle, uint32_t now_ms)
+{
+    if (!bus->slot_reserved || !needs_data_slot(handle)) {
+        return 0;
+    }
+
+    int32_t wait_ms = (int32_t)(bus->slot_free_ms - (now_ms + handle->config.start_signal_ms + 1));
+    return (wait_ms > 0) ? (uint32_t)wait_ms : 0;
+}
+
+
+static uint32_t time_until_service(const dht11_bus_t *bus, const dht11_handle_t *handle, uint32_t now_ms)
+{
+    switch (handle->state) {
+    case DHT11_STATE_START_SIGNAL: {
+        uint32_t elapsed_ms = now_ms - handle->start_signal_time_ms;
+        uint32_t start_signal_ms = handle->config.start_signal_ms;
+        return (elapsed_ms > start_signal_ms) ? 0 : (start_signal_ms + 1) - elapsed_ms;
+    }
+
+    case DHT11_STATE_RECEIVING:
+        return 0;
+
+    case DHT11_STATE_IDLE:
+    case DHT11_STATE_COMPLETE:
+    default: {
+        uint32_t elapsed_ms = now_ms - handle->last_reading_time_ms;
+        uint32_t period_ms = handle->config.min_sampling_period_ms;
+        uint32_t slot_ms = time_until_slot(bus, handle, now_ms);
+        uint32_t ready_ms = (elapsed_ms >= period_ms) ? 0 : period_ms - elapsed_ms;
+        return (ready_ms > slot_ms) ? ready_ms : slot_ms;
+    }
+    }
+}
+
+
+dht11_result_t dht11_bus_init(dht11_bus_t *bus, dht11_handle_t **handles, size_t handle_count,
+                              dht11_bus_callback_t callback, void *user_data)
+{
+    if (bus == NULL || handles == NULL || handle_count == 0) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    for (size_t i = 0; i < handle_count; i++) {
+        if (handles[i] == NULL) {
+            return DHT11_ERR_INVALID_ARG;
+        }
+    }
+
+    bus->handles = handles;
+    bus->handle_count = handle_count;
+    bus->callback = callback;
+    bus->user_data = user_data;
+    bus->next_index = 0;
+    bus->slot_reserved = false;
+    bus->slot_free_ms = 0;
+
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_bus_process(dht11_bus_t *bus, uint32_t *next_service_ms)
+{
+    if (bus == NULL || bus->handles == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    uint32_t now_ms = nhal_get_timestamp_milliseconds();
+    if (bus->slot_reserved && (int32_t)(bus->slot_free_ms - now_ms) <= 0) {
+        bus->slot_reserved = false;
+    }
+
+    // Phase 1: start every sensor that may be read and whose start signal
+    // ends in a free data slot; their start signals overlap
+    for (size_t i = 0; i < bus->handle_count; i++) {
+        dht11_handle_t *handle = bus->handles[i];
+        if (handle->state != DHT11_STATE_IDLE && handle->state != DHT11_STATE_COMPLETE) {
+            continue;
+        }
+        // Checked here so that statistics count caller attempts, not bus polls
+        if (!dht11_is_ready_for_reading(handle) || time_until_slot(bus, handle, now_ms) != 0) {
+            continue;
+        }
+
+        dht11_result_t result = dht11_read_start(handle);
+        if (result == DHT11_OK && needs_data_slot(handle)) {
+            bus->slot_free_ms = handle->start_signal_time_ms + handle->config.start_signal_ms + 1 +
+                                DHT11_BUS_DATA_SLOT_MS;
+            bus->slot_reserved = true;
+        } else if (result != DHT11_OK) {
+            back_off(handle);
+            if (bus->callback != NULL) {
+                bus->callback(handle, i, result, NULL, bus->user_data);
+            }
+        }
+    }
+
+    // Phase 2: advance pending transactions, one blocking data phase per step
+    bool data_phase_done = false;
+    for (size_t n = 0; n < bus->handle_count; n++) {
+        size_t i = (bus->next_index + n) % bus->handle_count;
+        dht11_handle_t *handle = bus->handles[i];
+
+        if (handle->state == DHT11_STATE_START_SIGNAL) {
+            if (data_phase_done && needs_data_slot(handle)) {
+                continue;
+            }
+
+            dht11_result_t result = dht11_read_poll(handle);
+            if (result == DHT11_ERR_IN_PROGRESS) {
+                continue;
+            }
+
+            data_phase_done = true;
+            bus->next_index = (i + 1) % bus->handle_count;
+            complete_handle(bus, i, result);
+        } else if (handle->state == DHT11_STATE_RECEIVING) {
+            dht11_result_t result = dht11_read_poll(handle);
+            if (result != DHT11_ERR_IN_PROGRESS) {
+                complete_handle(bus, i, result);
+            }
+        }
+    }
+
+    if (next_service_ms != NULL) {
+        uint32_t next_ms = UINT32_MAX;
+
+        now_ms = nhal_get_timestamp_milliseconds();
+        for (size_t i = 0; i < bus->handle_count; i++) {
+            uint32_t due_ms = time_until_service(bus, bus->handles[i], now_ms);
+            if (due_ms < next_ms) {
+                next_ms = due_ms;
+            }
+        }
+        *next_service_ms = next_ms;
+    }
+
+    return DHT11_OK;
+}
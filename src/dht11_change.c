@@ -0,0 +1,91 @@
+/**
+ * @file dht11_change.c
+ * @brief Implementation of hysteresis-based change detection
+ */
+
+#include "dht11_change.h"
+#include <string.h>
+
+
+static bool outside_band(int16_t value, int16_t reference, int16_t band)
+{
+    int32_t delta = (int32_t)value - reference;
+    return delta > band || delta < -band;
+}
+
+
+dht11_result_t dht11_change_config_default(dht11_change_config_t *config)
+{
+    if (config == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    config->humidity_band_x10 = DHT11_CHANGE_HUMIDITY_BAND_X10;
+    config->temperature_band_x10 = DHT11_CHANGE_TEMPERATURE_BAND_X10;
+    config->heartbeat_ms = DHT11_CHANGE_HEARTBEAT_MS;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_change_init(dht11_change_t *change, const dht11_change_config_t *config)
+{
+    if (change == NULL || config == NULL || config->humidity_band_x10 < 0 || config->temperature_band_x10 < 0) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    memset(change, 0, sizeof(*change));
+    change->config = *config;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_change_reset(dht11_change_t *change)
+{
+    if (change == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    dht11_change_config_t config = change->config;
+    memset(change, 0, sizeof(*change));
+    change->config = config;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_change_push(dht11_change_t *change, const dht11_reading_fixed_t *reading, uint32_t time_ms,
+                                 uint8_t *events)
+{
+    if (change == NULL || reading == NULL || events == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    uint8_t reasons = 0;
+
+    if (!change->primed) {
+        reasons = DHT11_CHANGE_FIRST;
+    } else {
+        if (outside_band(reading->humidity_x10, change->emitted.humidity_x10, change->config.humidity_band_x10)) {
+            reasons |= DHT11_CHANGE_HUMIDITY;
+        }
+        if (outside_band(reading->temperature_x10, change->emitted.temperature_x10,
+                         change->config.temperature_band_x10)) {
+            reasons |= DHT11_CHANGE_TEMPERATURE;
+        }
+        if (change->config.heartbeat_ms != 0 &&
+            (uint32_t)(time_ms - change->emitted_time_ms) >= change->config.heartbeat_ms) {
+            if (reasons == 0) {
+                change->heartbeat_count++;
+            }
+            reasons |= DHT11_CHANGE_HEARTBEAT;
+        }
+    }
+
+    if (reasons == 0) {
+        change->suppressed_count++;
+    } else {
+        change->primed = true;
+        change->emitted = *reading;
+        change->emitted_time_ms = time_ms;
+        change->emitted_count++;
+    }
+
+    *events = reasons;
+    return DHT11_OK;
+}
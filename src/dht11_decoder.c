@@ -0,0 +1,206 @@
+/**
+ * @file dht11_decoder.c
+ * @brief Incremental edge-timestamp decoder shared by the acquisition paths
+ */
+
+#include "dht11_internal.h"
+#include <string.h>
+
+
+void dht11_decoder_reset(dht11_edge_decoder_t *decoder)
+{
+    memset(decoder, 0, sizeof(*decoder));
+    decoder->threshold_us = DHT11_PULSE_THRESHOLD_US;
+}
+
+static uint8_t saturate_us(uint32_t duration_us)
+{
+    return (duration_us > UINT8_MAX) ? UINT8_MAX : (uint8_t)duration_us;
+}
+
+bool dht11_decoder_push_bit(dht11_edge_decoder_t *decoder, uint32_t low_us, uint32_t high_us)
+{
+    uint8_t bit = decoder->bit_count;
+    if (bit >= DHT11_DATA_BITS) {
+        return true;
+    }
+
+    // Bit decision: >threshold = '1', <threshold = '0'
+    if (high_us > decoder->threshold_us) {
+        decoder->data_bytes[bit >> 3] |= (uint8_t)(0x80u >> (bit & 7u));
+    }
+
+    if (decoder->timing != NULL) {
+        decoder->timing->low_us[bit] = saturate_us(low_us);
+        decoder->timing->high_us[bit] = saturate_us(high_us);
+    }
+
+    decoder->bit_count = (uint8_t)(bit + 1u);
+    return decoder->bit_count >= DHT11_DATA_BITS;
+}
+
+bool dht11_decoder_push(dht11_edge_decoder_t *decoder, uint32_t timestamp_us)
+{
+    uint16_t index = decoder->edge_count++;
+
+    if (index >= DHT11_DECODER_FIRST_BIT_RISE) {
+        uint16_t bit = (uint16_t)((index - DHT11_DECODER_FIRST_BIT_RISE) >> 1);
+        uint32_t duration_us = timestamp_us - decoder->last_edge_us;
+
+        if (((index - DHT11_DECODER_FIRST_BIT_RISE) & 1u) == 0) {
+            // Rising edges end the low phase preceding a bit
+            decoder->pending_low_us = duration_us;
+        } else if (bit < DHT11_DATA_BITS) {
+            // Falling edges after the first bit rise end a high pulse
+            dht11_decoder_push_bit(decoder, decoder->pending_low_us, duration_us);
+        }
+    }
+
+    decoder->last_edge_us = timestamp_us;
+    return decoder->edge_count >= DHT11_DECODER_MIN_EDGES;
+}
+
+dht11_decoder_status_t dht11_decoder_push_edge(dht11_edge_decoder_t *decoder, nhal_pin_state_t level, uint32_t timestamp_us)
+{
+    // The frame starts with the falling edge of the response
+    if (decoder->edge_count == 0 && level != NHAL_PIN_LOW) {
+        return DHT11_DECODER_SKIPPED;
+    }
+
+    // Falling and rising edges alternate; a mismatch means an edge was lost
+    nhal_pin_state_t expected = (decoder->edge_count & 1u) ? NHAL_PIN_HIGH : NHAL_PIN_LOW;
+    if (level != expected) {
+        return DHT11_DECODER_DESYNC;
+    }
+
+    return dht11_decoder_push(decoder, timestamp_us) ? DHT11_DECODER_COMPLETE : DHT11_DECODER_PENDING;
+}
+
+uint8_t dht11_decoder_split_threshold(const dht11_edge_decoder_t *decoder)
+{
+    const uint8_t *high_us = decoder->timing->high_us;
+    uint32_t min_us = UINT8_MAX;
+    uint32_t max_us = 0;
+
+    for (int bit = 0; bit < DHT11_DATA_BITS; bit++) {
+        if (high_us[bit] < min_us) {
+            min_us = high_us[bit];
+        }
+        if (high_us[bit] > max_us) {
+            max_us = high_us[bit];
+        }
+    }
+    if (max_us - min_us < DHT11_ADAPTIVE_MIN_SEPARATION_US) {
+        return 0;
+    }
+
+    // Two-means clustering, seeded midway between the extremes so a frame that
+    // lies entirely on one side of the current threshold can still be split
+    uint32_t threshold_us = (min_us + max_us) / 2u;
+    for (int iteration = 0; iteration < 8; iteration++) {
+        uint32_t sums[2] = {0, 0};
+        uint32_t counts[2] = {0, 0};
+
+        for (int bit = 0; bit < DHT11_DATA_BITS; bit++) {
+            int cluster = high_us[bit] > threshold_us;
+            sums[cluster] += high_us[bit];
+            counts[cluster]++;
+        }
+
+        if (counts[0] == 0 || counts[1] == 0) {
+            return 0;
+        }
+
+        uint32_t zero_us = sums[0] / counts[0];
+        uint32_t one_us = sums[1] / counts[1];
+        if (one_us - zero_us < DHT11_ADAPTIVE_MIN_SEPARATION_US) {
+            return 0;
+        }
+
+        uint32_t split_us = (zero_us + one_us) / 2u;
+        if (split_us == threshold_us) {
+            break;
+        }
+        threshold_us = split_us;
+    }
+
+    return (uint8_t)threshold_us;
+}
+
+void dht11_decoder_redecide(dht11_edge_decoder_t *decoder, uint8_t threshold_us)
+{
+    memset(decoder->data_bytes, 0, sizeof(decoder->data_bytes));
+    decoder->threshold_us = threshold_us;
+
+    for (int bit = 0; bit < decoder->bit_count; bit++) {
+        if (decoder->timing->high_us[bit] > threshold_us) {
+            decoder->data_bytes[bit >> 3] |= (uint8_t)(0x80u >> (bit & 7));
+        }
+    }
+}
+
+uint8_t dht11_decoder_confidence(const dht11_edge_decoder_t *decoder, int bit)
+{
+    uint8_t high_us = decoder->timing->high_us[bit];
+    return (high_us > decoder->threshold_us) ? (uint8_t)(high_us - decoder->threshold_us)
+                                             : (uint8_t)(decoder->threshold_us - high_us);
+}
+
+static bool bytes_checksum_valid(const uint8_t *data_bytes)
+{
+    uint8_t sum = (uint8_t)(data_bytes[0] + data_bytes[1] + data_bytes[2] + data_bytes[3]);
+    return sum == data_bytes[4];
+}
+
+bool dht11_decoder_correct(dht11_edge_decoder_t *decoder)
+{
+    int candidates[DHT11_CORRECTION_CANDIDATES];
+    int count = 0;
+
+    // Keep the least confident bits, ordered by rising confidence
+    for (int bit = 0; bit < decoder->bit_count; bit++) {
+        uint8_t confidence = dht11_decoder_confidence(decoder, bit);
+        if (confidence > DHT11_CORRECTION_MAX_CONFIDENCE_US) {
+            continue;
+        }
+
+        if (count == DHT11_CORRECTION_CANDIDATES &&
+            confidence >= dht11_decoder_confidence(decoder, candidates[count - 1])) {
+            continue;
+        }
+
+        int slot = (count < DHT11_CORRECTION_CANDIDATES) ? count++ : count - 1;
+        while (slot > 0 && dht11_decoder_confidence(decoder, candidates[slot - 1]) > confidence) {
+            candidates[slot] = candidates[slot - 1];
+            slot--;
+        }
+        candidates[slot] = bit;
+    }
+
+    for (int i = 0; i < count; i++) {
+        uint8_t mask = (uint8_t)(0x80u >> (candidates[i] & 7));
+
+        decoder->data_bytes[candidates[i] >> 3] ^= mask;
+        if (bytes_checksum_valid(decoder->data_bytes)) {
+            return true;
+        }
+        decoder->data_bytes[candidates[i] >> 3] ^= mask;
+    }
+
+    return false;
+}
+
+dht11_result_t dht11_decoder_finish(const dht11_edge_decoder_t *decoder, dht11_raw_data_t *raw_data)
+{
+    raw_data->humidity_integer = decoder->data_bytes[0];
+    raw_data->humidity_decimal = decoder->data_bytes[1];
+    raw_data->temperature_integer = decoder->data_bytes[2];
+    raw_data->temperature_decimal = decoder->data_bytes[3];
+    raw_data->checksum = decoder->data_bytes[4];
+
+    if (!dht11_verify_checksum(raw_data)) {
+        return DHT11_ERR_CHECKSUM;
+    }
+
+    return DHT11_OK;
+}
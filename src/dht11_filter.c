@@ -0,0 +1,174 @@
+/**
+ * @file dht11_filter.c
+ * @brief Outlier rejection, median and moving average over fixed-point readings
+ *
+ * Every stage works on 0.1 unit integers and keeps its state in the filter,
+ * so a reading costs at most a few passes over DHT11_FILTER_MEDIAN_MAX
+ * entries and no floating point.
+ */
+
+#include "dht11.h"
+#include <string.h>
+
+
+static int32_t distance(int16_t a, int16_t b)
+{
+    int32_t difference = (int32_t)a - (int32_t)b;
+    return (difference < 0) ? -difference : difference;
+}
+
+
+static bool is_outlier(int16_t value, const dht11_filter_channel_t *channel, int16_t max_step)
+{
+    return max_step != 0 && distance(value, channel->last_accepted_x10) > max_step;
+}
+
+
+// Replaces the oldest entry of the window and keeps the sorted copy in order
+static int16_t median_push(dht11_filter_channel_t *channel, int16_t value, uint8_t size)
+{
+    uint8_t count = channel->window_fill;
+
+    if (count == size) {
+        int16_t oldest = channel->window[channel->window_head];
+        uint8_t i = 0;
+        while (channel->sorted[i] != oldest) {
+            i++;
+        }
+        memmove(&channel->sorted[i], &channel->sorted[i + 1], (size_t)(count - i - 1) * sizeof(int16_t));
+        count--;
+
+        channel->window[channel->window_head] = value;
+        channel->window_head = (uint8_t)((channel->window_head + 1u) % size);
+    } else {
+        channel->window[count] = value;
+        channel->window_fill++;
+    }
+
+    uint8_t i = count;
+    while (i > 0 && channel->sorted[i - 1] > value) {
+        channel->sorted[i] = channel->sorted[i - 1];
+        i--;
+    }
+    channel->sorted[i] = value;
+
+    return channel->sorted[count / 2u];
+}
+
+
+// Rounds half away from zero without relying on the sign of a right shift
+static int16_t round_q8(int32_t value_q8)
+{
+    return (int16_t)((value_q8 < 0) ? -((-value_q8 + 128) / 256) : (value_q8 + 128) / 256);
+}
+
+
+static int16_t average_push(dht11_filter_channel_t *channel, int16_t value, uint8_t shift, bool first)
+{
+    int32_t value_q8 = (int32_t)value * 256;
+
+    if (first) {
+        channel->average_q8 = value_q8;
+    } else {
+        channel->average_q8 += (value_q8 - channel->average_q8) / (1 << shift);
+    }
+
+    return round_q8(channel->average_q8);
+}
+
+
+static int16_t channel_push(dht11_filter_channel_t *channel, const dht11_filter_config_t *config,
+                            int16_t value, bool first)
+{
+    channel->last_accepted_x10 = value;
+
+    if (config->median_window > 1) {
+        value = median_push(channel, value, config->median_window);
+    }
+    if (config->ema_shift != 0) {
+        value = average_push(channel, value, config->ema_shift, first);
+    }
+
+    return value;
+}
+
+
+dht11_result_t dht11_filter_config_default(dht11_filter_config_t *config)
+{
+    if (config == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    config->max_humidity_step_x10 = DHT11_FILTER_HUMIDITY_STEP_X10;
+    config->max_temperature_step_x10 = DHT11_FILTER_TEMPERATURE_STEP_X10;
+    config->max_rejections = DHT11_FILTER_MAX_REJECTIONS;
+    config->median_window = DHT11_FILTER_MEDIAN_WINDOW;
+    config->ema_shift = DHT11_FILTER_EMA_SHIFT;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_filter_init(dht11_filter_t *filter, const dht11_filter_config_t *config)
+{
+    if (filter == NULL || config == NULL ||
+        config->max_humidity_step_x10 < 0 || config->max_temperature_step_x10 < 0 ||
+        ((config->max_humidity_step_x10 != 0 || config->max_temperature_step_x10 != 0) && config->max_rejections == 0) ||
+        config->median_window == 0 || config->median_window > DHT11_FILTER_MEDIAN_MAX ||
+        (config->median_window % 2u) == 0 || config->ema_shift > 15) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    memset(filter, 0, sizeof(*filter));
+    filter->config = *config;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_filter_reset(dht11_filter_t *filter)
+{
+    if (filter == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    dht11_filter_config_t config = filter->config;
+    memset(filter, 0, sizeof(*filter));
+    filter->config = config;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_filter_push(dht11_filter_t *filter, const dht11_reading_fixed_t *reading,
+                                 dht11_reading_fixed_t *filtered)
+{
+    if (filter == NULL || reading == NULL || filtered == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    const dht11_filter_config_t *config = &filter->config;
+    dht11_reading_fixed_t input = *reading;
+    bool first = !filter->primed;
+
+    // A frame that passed the checksum can still be wrong in one field, so
+    // the whole reading is dropped when either channel jumps
+    if (!first && filter->rejections < config->max_rejections &&
+        (is_outlier(input.humidity_x10, &filter->humidity, config->max_humidity_step_x10) ||
+         is_outlier(input.temperature_x10, &filter->temperature, config->max_temperature_step_x10))) {
+        filter->rejections++;
+        filter->rejected++;
+        return DHT11_ERR_OUTLIER;
+    }
+
+    filter->rejections = 0;
+    filter->primed = true;
+    filtered->humidity_x10 = channel_push(&filter->humidity, config, input.humidity_x10, first);
+    filtered->temperature_x10 = channel_push(&filter->temperature, config, input.temperature_x10, first);
+    filter->accepted++;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_set_filter(dht11_handle_t *handle, dht11_filter_t *filter)
+{
+    if (handle == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    handle->filter = filter;
+    return DHT11_OK;
+}
@@ -0,0 +1,253 @@
+/**
+ * @file dht11_history.c
+ * @brief Implementation of the delta and varint encoded history ring
+ */
+
+#include "dht11_history.h"
+#include <string.h>
+
+#define HEADER_PRESENT          0x01u
+#define HEADER_INTERVAL         0x80u
+#define HEADER_HUMIDITY_SHIFT   4
+#define HEADER_TEMPERATURE_SHIFT 1
+#define CODE_MASK               0x07u
+#define CODE_ESCAPE             7u
+#define CODE_MAX_STEPS          3
+
+// Header, interval and two escaped deltas
+#define RECORD_MAX_BYTES        12
+
+
+static uint32_t zigzag(int32_t value)
+{
+    return (value < 0) ? (uint32_t)(-(value + 1)) * 2u + 1u : (uint32_t)value * 2u;
+}
+
+
+static int32_t unzigzag(uint32_t value)
+{
+    return (value & 1u) ? -(int32_t)(value / 2u) - 1 : (int32_t)(value / 2u);
+}
+
+
+static size_t put_varint(uint8_t *out, uint32_t value)
+{
+    size_t length = 0;
+
+    while (value >= 0x80u) {
+        out[length++] = (uint8_t)(value | 0x80u);
+        value >>= 7;
+    }
+    out[length++] = (uint8_t)value;
+
+    return length;
+}
+
+
+static bool get_varint(const uint8_t *block, size_t *offset, uint32_t *value)
+{
+    uint32_t result = 0;
+
+    for (unsigned shift = 0; shift < 35 && *offset < DHT11_HISTORY_BLOCK_BYTES; shift += 7) {
+        uint8_t byte = block[(*offset)++];
+        result |= (uint32_t)(byte & 0x7Fu) << shift;
+        if ((byte & 0x80u) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+static uint8_t *block_at(const dht11_history_t *history, size_t block)
+{
+    return history->buffer + block * DHT11_HISTORY_BLOCK_BYTES;
+}
+
+
+// Small multiples of the resolution fit in the header, the rest is escaped
+static uint8_t delta_code(const dht11_history_t *history, int32_t delta, uint8_t *out, size_t *length)
+{
+    int32_t step = history->step_x10;
+
+    if (delta % step == 0 && delta / step >= -CODE_MAX_STEPS && delta / step <= CODE_MAX_STEPS) {
+        return (uint8_t)zigzag(delta / step);
+    }
+
+    *length += put_varint(out + *length, zigzag(delta));
+    return CODE_ESCAPE;
+}
+
+
+static bool apply_code(const dht11_history_t *history, uint8_t code, const uint8_t *block, size_t *offset,
+                       int16_t *value)
+{
+    uint32_t escaped;
+
+    if (code != CODE_ESCAPE) {
+        *value = (int16_t)(*value + unzigzag(code) * history->step_x10);
+        return true;
+    }
+    if (!get_varint(block, offset, &escaped)) {
+        return false;
+    }
+    *value = (int16_t)(*value + unzigzag(escaped));
+    return true;
+}
+
+
+static void start_block(dht11_history_t *history, size_t block, const dht11_reading_fixed_t *reading,
+                        uint32_t time_s, uint32_t interval_s)
+{
+    uint8_t *out = block_at(history, block);
+    size_t length = 0;
+
+    memset(out, 0, DHT11_HISTORY_BLOCK_BYTES);
+    length += put_varint(out + length, time_s);
+    length += put_varint(out + length, interval_s);
+    length += put_varint(out + length, zigzag(reading->humidity_x10));
+    length += put_varint(out + length, zigzag(reading->temperature_x10));
+
+    history->newest_block = block;
+    history->write_offset = length;
+}
+
+
+dht11_result_t dht11_history_init(dht11_history_t *history, uint8_t *buffer, size_t size, uint8_t step_x10)
+{
+    if (history == NULL || buffer == NULL || step_x10 == 0 || size / DHT11_HISTORY_BLOCK_BYTES < 2) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    memset(history, 0, sizeof(*history));
+    history->buffer = buffer;
+    history->block_count = size / DHT11_HISTORY_BLOCK_BYTES;
+    history->step_x10 = step_x10;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_history_append(dht11_history_t *history, const dht11_reading_fixed_t *reading, uint32_t time_s)
+{
+    if (history == NULL || reading == NULL || history->buffer == NULL ||
+        (history->used_blocks > 0 && time_s < history->last_time_s)) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    uint32_t interval_s = (history->used_blocks > 0) ? time_s - history->last_time_s : 0;
+
+    if (history->used_blocks == 0) {
+        start_block(history, 0, reading, time_s, interval_s);
+        history->oldest_block = 0;
+        history->used_blocks = 1;
+    } else {
+        uint8_t record[RECORD_MAX_BYTES];
+        size_t length = 1;
+        uint8_t header = HEADER_PRESENT;
+
+        if (interval_s != history->last_interval_s) {
+            header |= HEADER_INTERVAL;
+            length += put_varint(record + length, interval_s);
+        }
+        header |= (uint8_t)(delta_code(history, (int32_t)reading->humidity_x10 - history->last.humidity_x10,
+                                       record, &length) << HEADER_HUMIDITY_SHIFT);
+        header |= (uint8_t)(delta_code(history, (int32_t)reading->temperature_x10 - history->last.temperature_x10,
+                                       record, &length) << HEADER_TEMPERATURE_SHIFT);
+        record[0] = header;
+
+        if (history->write_offset + length <= DHT11_HISTORY_BLOCK_BYTES) {
+            memcpy(block_at(history, history->newest_block) + history->write_offset, record, length);
+            history->write_offset += length;
+        } else {
+            size_t next = (history->newest_block + 1u) % history->block_count;
+            if (history->used_blocks == history->block_count) {
+                history->oldest_block = (history->oldest_block + 1u) % history->block_count;
+            } else {
+                history->used_blocks++;
+            }
+            start_block(history, next, reading, time_s, interval_s);
+        }
+    }
+
+    history->last = *reading;
+    history->last_time_s = time_s;
+    history->last_interval_s = interval_s;
+    history->appended++;
+    return DHT11_OK;
+}
+
+size_t dht11_history_bytes_used(const dht11_history_t *history)
+{
+    if (history == NULL || history->used_blocks == 0) {
+        return 0;
+    }
+
+    return (history->used_blocks - 1u) * DHT11_HISTORY_BLOCK_BYTES + history->write_offset;
+}
+
+dht11_result_t dht11_history_iter_init(const dht11_history_t *history, dht11_history_iter_t *iter)
+{
+    if (history == NULL || iter == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    memset(iter, 0, sizeof(*iter));
+    iter->history = history;
+    iter->block = history->oldest_block;
+    if (history->used_blocks == 0) {
+        iter->offset = DHT11_HISTORY_BLOCK_BYTES;
+    } else {
+        iter->blocks_left = history->used_blocks - 1u;
+    }
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_history_next(dht11_history_iter_t *iter, dht11_reading_fixed_t *reading, uint32_t *time_s)
+{
+    if (iter == NULL || reading == NULL || iter->history == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    const dht11_history_t *history = iter->history;
+    const uint8_t *block = block_at(history, iter->block);
+
+    if (iter->offset != 0 && (iter->offset >= DHT11_HISTORY_BLOCK_BYTES || block[iter->offset] == 0)) {
+        if (iter->blocks_left == 0) {
+            return DHT11_ERR_NO_DATA;
+        }
+        iter->block = (iter->block + 1u) % history->block_count;
+        iter->blocks_left--;
+        iter->offset = 0;
+        block = block_at(history, iter->block);
+    }
+
+    if (iter->offset == 0) {
+        uint32_t humidity;
+        uint32_t temperature;
+        if (!get_varint(block, &iter->offset, &iter->time_s) || !get_varint(block, &iter->offset, &iter->interval_s) ||
+            !get_varint(block, &iter->offset, &humidity) || !get_varint(block, &iter->offset, &temperature)) {
+            return DHT11_ERR_INVALID_DATA;
+        }
+        iter->reading.humidity_x10 = (int16_t)unzigzag(humidity);
+        iter->reading.temperature_x10 = (int16_t)unzigzag(temperature);
+    } else {
+        uint8_t header = block[iter->offset++];
+        if ((header & HEADER_INTERVAL) != 0 && !get_varint(block, &iter->offset, &iter->interval_s)) {
+            return DHT11_ERR_INVALID_DATA;
+        }
+        if (!apply_code(history, (header >> HEADER_HUMIDITY_SHIFT) & CODE_MASK, block, &iter->offset,
+                        &iter->reading.humidity_x10) ||
+            !apply_code(history, (header >> HEADER_TEMPERATURE_SHIFT) & CODE_MASK, block, &iter->offset,
+                        &iter->reading.temperature_x10)) {
+            return DHT11_ERR_INVALID_DATA;
+        }
+        iter->time_s += iter->interval_s;
+    }
+
+    *reading = iter->reading;
+    if (time_s != NULL) {
+        *time_s = iter->time_s;
+    }
+    return DHT11_OK;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file dht11_internal.h
+ * @brief Internal helpers shared between the DHT11 driver translation units
+ *
+ * Not part of the public API.
+ */
+#ifndef DHT11_INTERNAL_H
+#define DHT11_INTERNAL_H
+
+#include "dht11.h"
+
+/* Edge layout: response low/high, then a falling and a rising edge per bit.
+ * The high pulse of bit N spans from edge (3 + 2N) to edge (4 + 2N). */
+#define DHT11_DECODER_FIRST_BIT_RISE    3
+#define DHT11_DECODER_MIN_EDGES         (DHT11_DECODER_FIRST_BIT_RISE + 2 * DHT11_DATA_BITS)
+
+typedef enum {
+    DHT11_DECODER_PENDING = 0,          /**< Edge consumed, frame not complete yet */
+    DHT11_DECODER_COMPLETE,             /**< Edge consumed, last data bit decoded */
+    DHT11_DECODER_SKIPPED,              /**< Edge ignored while waiting for the response */
+    DHT11_DECODER_DESYNC,               /**< Edge level out of sequence, an edge was lost */
+} dht11_decoder_status_t;
+
+/**
+ * @brief Reset the incremental edge decoder for a new frame
+ */
+void dht11_decoder_reset(dht11_edge_decoder_t *decoder);
+
+/**
+ * @brief Decide the next bit from its measured low and high phases
+ *
+ * Shared by the edge decoder and the polling receiver so every acquisition
+ * path makes the same decision and records the same pulse widths.
+ *
+ * @return true once all data bits were decided
+ */
+bool dht11_decoder_push_bit(dht11_edge_decoder_t *decoder, uint32_t low_us, uint32_t high_us);
+
+/**
+ * @brief Feed the next edge timestamp of a frame
+ *
+ * @return true once the falling edge ending the last data bit was consumed
+ */
+bool dht11_decoder_push(dht11_edge_decoder_t *decoder, uint32_t timestamp_us);
+
+/**
+ * @brief Feed an edge with its level, checking that levels alternate
+ *
+ * Rising edges before the response are skipped.
+ */
+dht11_decoder_status_t dht11_decoder_push_edge(dht11_edge_decoder_t *decoder, nhal_pin_state_t level, uint32_t timestamp_us);
+
+/**
+ * @brief Copy the decoded bytes to raw data and verify the checksum
+ */
+dht11_result_t dht11_decoder_finish(const dht11_edge_decoder_t *decoder, dht11_raw_data_t *raw_data);
+
+/**
+ * @brief Split the high widths of a decoded frame into two clusters
+ *
+ * Requires recorded timing and all data bits.
+ *
+ * @return Threshold midway between the clusters, or 0 if the frame does not
+ *         show two clusters at least DHT11_ADAPTIVE_MIN_SEPARATION_US apart
+ */
+uint8_t dht11_decoder_split_threshold(const dht11_edge_decoder_t *decoder);
+
+/**
+ * @brief Decide every bit again from the recorded high widths
+ */
+void dht11_decoder_redecide(dht11_edge_decoder_t *decoder, uint8_t threshold_us);
+
+/**
+ * @brief Distance of a bit's high width from the threshold it was decided with
+ *
+ * Requires recorded timing. Bits close to the threshold are the likeliest
+ * to have been misread.
+ */
+uint8_t dht11_decoder_confidence(const dht11_edge_decoder_t *decoder, int bit);
+
+/**
+ * @brief Try to repair a frame that fails the checksum by flipping one bit
+ *
+ * Tries the DHT11_CORRECTION_CANDIDATES least confident bits whose confidence
+ * is at most DHT11_CORRECTION_MAX_CONFIDENCE_US, least confident first, and
+ * keeps the first flip that makes the checksum match. Requires recorded timing.
+ *
+ * @return true if a flipped bit made the checksum match
+ */
+bool dht11_decoder_correct(dht11_edge_decoder_t *decoder);
+
+/**
+ * @brief Decode the handle's sample buffer into its decoder
+ *
+ * Filters the samples by majority vote and debounce, then feeds the
+ * remaining edges to the decoder. Sample i is timed at start_us + i * period.
+ *
+ * @return DHT11_DECODER_COMPLETE once the last data bit was decoded,
+ *         DHT11_DECODER_DESYNC on an out-of-sequence edge, otherwise
+ *         DHT11_DECODER_PENDING when the samples ran out
+ */
+dht11_decoder_status_t dht11_oversample_decode(dht11_handle_t *handle, uint32_t start_us);
+
+/**
+ * @brief Start timing a transaction if a statistics block is attached
+ */
+void dht11_stats_begin(dht11_handle_t *handle);
+
+/**
+ * @brief End the current phase now and move to the next one
+ */
+void dht11_stats_mark(dht11_handle_t *handle);
+
+/**
+ * @brief End the current phase at an edge timestamp and move to the next one
+ */
+void dht11_stats_mark_at(dht11_handle_t *handle, uint32_t timestamp_us);
+
+/**
+ * @brief Count a read attempt and, if a transaction was timed, record its phases
+ *
+ * @param polled true if the response and data phases were received by polling the pin
+ */
+void dht11_stats_end(dht11_handle_t *handle, dht11_result_t result, bool polled);
+
+#endif /* DHT11_INTERNAL_H */
@@ -0,0 +1,74 @@
+/**
+ * @file dht11_oversample.c
+ * @brief Offline decoding of a bulk-sampled data line with glitch rejection
+ */
+
+#include "dht11_internal.h"
+
+
+static uint32_t sample_at(const uint32_t *samples, size_t count, long index)
+{
+    // The window is clamped at both ends of the buffer
+    if (index < 0) {
+        index = 0;
+    } else if ((size_t)index >= count) {
+        index = (long)count - 1;
+    }
+
+    return (samples[(size_t)index >> 5] >> ((size_t)index & 31u)) & 1u;
+}
+
+
+dht11_decoder_status_t dht11_oversample_decode(dht11_handle_t *handle, uint32_t start_us)
+{
+    const uint32_t *samples = handle->sample_buffer;
+    size_t count = handle->sample_count;
+    dht11_edge_decoder_t *decoder = &handle->decoder;
+    const long half = DHT11_OVERSAMPLE_VOTE_SAMPLES / 2;
+
+    // Released line is pulled up
+    bool stable_high = true;
+    size_t run_start = 0;
+    uint32_t run_length = 0;
+
+    // High samples in the vote window, kept as a running sum
+    uint32_t highs = 0;
+    for (long k = -half - 1; k < half; k++) {
+        highs += sample_at(samples, count, k);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        highs += sample_at(samples, count, (long)i + half);
+        highs -= sample_at(samples, count, (long)i - half - 1);
+        bool high = highs > (uint32_t)half;
+
+        if (high == stable_high) {
+            run_length = 0;
+            continue;
+        }
+        if (run_length++ == 0) {
+            run_start = i;
+        }
+        if (run_length < DHT11_OVERSAMPLE_DEBOUNCE_SAMPLES) {
+            continue;
+        }
+
+        // The edge is placed where the new level started, not where it was confirmed
+        stable_high = high;
+        run_length = 0;
+
+        uint32_t timestamp_us = start_us + (uint32_t)run_start * handle->sample_period_us;
+        dht11_decoder_status_t status =
+            dht11_decoder_push_edge(decoder, high ? NHAL_PIN_HIGH : NHAL_PIN_LOW, timestamp_us);
+
+        if (status == DHT11_DECODER_PENDING && decoder->edge_count == DHT11_DECODER_FIRST_BIT_RISE) {
+            // The response ends where the first bit starts
+            dht11_stats_mark_at(handle, timestamp_us);
+        }
+        if (status == DHT11_DECODER_COMPLETE || status == DHT11_DECODER_DESYNC) {
+            return status;
+        }
+    }
+
+    return DHT11_DECODER_PENDING;
+}
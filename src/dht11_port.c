@@ -0,0 +1,168 @@
+/**
+ * @file dht11_port.c
+ * @brief Implementation of port-parallel DHT11 acquisition
+ */
+
+#include "dht11_port.h"
+#include "dht11_internal.h"
+#include <string.h>
+
+
+static bool is_single_bit(uint32_t mask)
+{
+    return mask != 0 && (mask & (mask - 1u)) == 0;
+}
+
+
+static uint8_t bit_position(uint32_t mask)
+{
+    uint8_t position = 0;
+
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        position++;
+    }
+
+    return position;
+}
+
+
+dht11_result_t dht11_port_init(dht11_port_group_t *group, const dht11_port_ops_t *ops, void *port_ctx,
+                               const uint32_t *pin_masks, size_t sensor_count)
+{
+    if (group == NULL || ops == NULL || pin_masks == NULL ||
+        ops->drive_low == NULL || ops->release == NULL || ops->read == NULL ||
+        sensor_count == 0 || sensor_count > DHT11_PORT_MAX_SENSORS) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    uint32_t group_mask = 0;
+    for (size_t i = 0; i < sensor_count; i++) {
+        if (!is_single_bit(pin_masks[i]) || (group_mask & pin_masks[i]) != 0) {
+            return DHT11_ERR_INVALID_ARG;
+        }
+        group_mask |= pin_masks[i];
+    }
+
+    group->ops = ops;
+    group->port_ctx = port_ctx;
+    memcpy(group->pin_masks, pin_masks, sensor_count * sizeof(pin_masks[0]));
+    group->sensor_count = sensor_count;
+    group->group_mask = group_mask;
+    group->last_reading_time_ms = 0;
+
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_port_read_samples(dht11_port_group_t *group, dht11_port_sample_t *samples,
+                                       size_t capacity, size_t *sample_count)
+{
+    if (group == NULL || group->ops == NULL || samples == NULL || sample_count == NULL || capacity == 0) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    *sample_count = 0;
+
+    uint32_t time_since_last = nhal_get_timestamp_milliseconds() - group->last_reading_time_ms;
+    if (time_since_last < DHT11_MIN_SAMPLING_PERIOD_MS) {
+        return DHT11_ERR_TOO_SOON;
+    }
+
+    // Start signal for every sensor of the group at once
+    if (group->ops->drive_low(group->port_ctx, group->group_mask) != NHAL_OK) {
+        return DHT11_ERR_PIN_ERROR;
+    }
+    nhal_delay_milliseconds(DHT11_START_SIGNAL_MS);
+
+    if (group->ops->release(group->port_ctx, group->group_mask) != NHAL_OK) {
+        return DHT11_ERR_PIN_ERROR;
+    }
+
+    // Sample the port until the lines have been idle for a full timeout
+    uint32_t previous = group->group_mask;  // Released lines are pulled up
+    uint32_t last_change_us = (uint32_t)nhal_get_timestamp_microseconds();
+    uint32_t last_us = last_change_us;
+    uint32_t stalled_polls = 0;
+    dht11_result_t result = DHT11_OK;
+    size_t count = 0;
+
+    while (count < capacity) {
+        uint32_t levels = group->ops->read(group->port_ctx) & group->group_mask;
+        uint32_t now_us = (uint32_t)nhal_get_timestamp_microseconds();
+
+        // The idle timeout never expires on a stalled timestamp source
+        if (now_us != last_us) {
+            stalled_polls = 0;
+            last_us = now_us;
+        } else if (++stalled_polls >= DHT11_WAIT_MAX_POLLS) {
+            result = DHT11_ERR_TIMEOUT;
+            break;
+        }
+
+        if (levels != previous) {
+            samples[count].timestamp_us = now_us;
+            samples[count].levels = levels;
+            count++;
+            previous = levels;
+            last_change_us = now_us;
+        } else if ((uint32_t)(now_us - last_change_us) >= DHT11_RESPONSE_TIMEOUT_US) {
+            break;
+        }
+    }
+
+    *sample_count = count;
+    group->last_reading_time_ms = nhal_get_timestamp_milliseconds();
+
+    return result;
+}
+
+dht11_result_t dht11_port_decode(const dht11_port_group_t *group, const dht11_port_sample_t *samples,
+                                 size_t sample_count, dht11_raw_data_t *raw_data, dht11_result_t *results)
+{
+    if (group == NULL || raw_data == NULL || results == NULL || (samples == NULL && sample_count > 0)) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    dht11_edge_decoder_t decoders[DHT11_PORT_MAX_SENSORS];
+    uint8_t sensor_of_bit[32];
+    uint32_t active_mask = group->group_mask;
+    uint32_t previous = group->group_mask;
+
+    for (size_t i = 0; i < group->sensor_count; i++) {
+        dht11_decoder_reset(&decoders[i]);
+        sensor_of_bit[bit_position(group->pin_masks[i])] = (uint8_t)i;
+        results[i] = DHT11_ERR_IN_PROGRESS;
+    }
+
+    for (size_t s = 0; s < sample_count && active_mask != 0; s++) {
+        uint32_t changed = (samples[s].levels ^ previous) & active_mask;
+        previous = samples[s].levels;
+
+        // Dispatch each changed bit to its sensor's decoder
+        while (changed != 0) {
+            uint32_t mask = changed & (~changed + 1u);
+            changed &= ~mask;
+
+            uint8_t sensor = sensor_of_bit[bit_position(mask)];
+            nhal_pin_state_t level = (samples[s].levels & mask) ? NHAL_PIN_HIGH : NHAL_PIN_LOW;
+            dht11_decoder_status_t status = dht11_decoder_push_edge(&decoders[sensor], level, samples[s].timestamp_us);
+
+            if (status == DHT11_DECODER_COMPLETE) {
+                results[sensor] = dht11_decoder_finish(&decoders[sensor], &raw_data[sensor]);
+                active_mask &= ~mask;
+            } else if (status == DHT11_DECODER_DESYNC) {
+                results[sensor] = DHT11_ERR_INVALID_DATA;
+                active_mask &= ~mask;
+            }
+        }
+    }
+
+    // Sensors whose frame never completed
+    for (size_t i = 0; i < group->sensor_count; i++) {
+        if (results[i] == DHT11_ERR_IN_PROGRESS) {
+            results[i] = (decoders[i].edge_count == 0) ? DHT11_ERR_NO_RESPONSE : DHT11_ERR_TIMEOUT;
+        }
+    }
+
+    return DHT11_OK;
+}
@@ -0,0 +1,433 @@
+/**
+ * @file dht11_psychro.c
+ * @brief Implementation of fixed-point psychrometric metrics
+ */
+
+#include "dht11_psychro.h"
+
+#define TABLE_MIN_C             (-60)
+#define TABLE_MAX_C             80
+#define TABLE_SIZE              (TABLE_MAX_C - TABLE_MIN_C + 1)
+
+// Saturation vapour pressure over water in mPa, one entry per degree from
+// TABLE_MIN_C: round(611.2 * exp(17.62 * T / (243.12 + T)) * 1000)
+static const uint32_t saturation_mpa[TABLE_SIZE] = {
+    1901, 2158, 2447, 2771, 3134, 3539, 3992, 4497,                                 // -60 C
+    5060, 5686, 6382, 7155, 8011, 8960, 10010, 11171,                               // -52 C
+    12452, 13865, 15423, 17137, 19021, 21092, 23364, 25855,                         // -44 C
+    28584, 31571, 34836, 38403, 42297, 46543, 51169, 56205,                         // -36 C
+    61683, 67636, 74102, 81117, 88723, 96964, 105885, 115534,                       // -28 C
+    125965, 137232, 149392, 162508, 176645, 191871, 208259, 225886,                 // -20 C
+    244833, 265184, 287031, 310468, 335593, 362514, 391339, 422185,                 // -12 C
+    455173, 490431, 528093, 568301, 611200, 656946, 705700, 757632,                 // -4 C
+    812918, 871743, 934300, 1000793, 1071430, 1146433, 1226030, 1310462,            // 4 C
+    1399976, 1494834, 1595306, 1701672, 1814226, 1933273, 2059129, 2192122,         // 12 C
+    2332596, 2480904, 2637415, 2802511, 2976588, 3160057, 3353343, 3556889,         // 20 C
+    3771149, 3996598, 4233724, 4483033, 4745050, 5020314, 5309386, 5612842,         // 28 C
+    5931279, 6265314, 6615581, 6982737, 7367458, 7770442, 8192406, 8634094,         // 36 C
+    9096266, 9579710, 10085234, 10613672, 11165880, 11742740, 12345158, 12974067,   // 44 C
+    13630424, 14315214, 15029448, 15774163, 16550428, 17359335, 18202007, 19079598, // 52 C
+    19993287, 20944289, 21933843, 22963224, 24033735, 25146714, 26303529, 27505581, // 60 C
+    28754305, 30051169, 31397675, 32795361, 34245797, 35750593, 37311389, 38929867, // 68 C
+    40607743, 42346769, 44148737, 46015477, 47948855,                               // 76 C
+};
+
+// Rothfusz coefficients scaled by 1e8, in the order of the terms
+// 1, T, R, TR, T^2, R^2, T^2 R, T R^2, T^2 R^2 (T in F, R in %)
+#define HI_C0                   (-4237900000LL)
+#define HI_C1                   204901523LL
+#define HI_C2                   1014333127LL
+#define HI_C3                   (-22475541LL)
+#define HI_C4                   (-683783LL)
+#define HI_C5                   (-5481717LL)
+#define HI_C6                   122874LL
+#define HI_C7                   85282LL
+#define HI_C8                   (-199LL)
+
+// Water vapour density is e * M / (R * T); M / R in g K/J, scaled by 1e5
+#define VAPOUR_CONSTANT         216679LL
+
+#define HEAT_TABLE_MIN_C        27
+#define HEAT_TABLE_MAX_C        50
+#define HEAT_TABLE_ROWS         (HEAT_TABLE_MAX_C - HEAT_TABLE_MIN_C + 1)
+#define HEAT_TABLE_COLUMNS      101
+
+// Rothfusz heat index with the NWS adjustments in 0.01 C, one row per degree
+// from HEAT_TABLE_MIN_C and one column per %RH, computed with the integer
+// polynomial of heat_index_of() at each grid point. The table starts above
+// 80 F, where the adjustments jump, and ends at the top of the DHT11 range
+static const int16_t heat_index_x100[HEAT_TABLE_ROWS][HEAT_TABLE_COLUMNS] = {
+    { 2504,  2510,  2517,  2523,  2529,  2536,  2542,  2549,  2556,  2563,  2570,  2577,  2584,  // 27 C
+      2592,  2594,  2596,  2598,  2601,  2603,  2606,  2609,  2611,  2614,  2617,  2621,  2624,
+      2627,  2631,  2634,  2638,  2642,  2646,  2650,  2654,  2658,  2663,  2667,  2672,  2677,
+      2681,  2686,  2691,  2697,  2702,  2707,  2713,  2718,  2724,  2730,  2736,  2742,  2748,
+      2754,  2760,  2767,  2774,  2780,  2787,  2794,  2801,  2808,  2815,  2823,  2830,  2838,
+      2845,  2853,  2861,  2869,  2877,  2886,  2894,  2902,  2911,  2920,  2928,  2937,  2946,
+      2955,  2965,  2974,  2983,  2993,  3003,  3012,  3022,  3040,  3057,  3074,  3092,  3109,
+      3127,  3145,  3162,  3180,  3199,  3217,  3235,  3253,  3272,  3291},
+    { 2577,  2582,  2587,  2593,  2599,  2605,  2612,  2618,  2625,  2632,  2639,  2647,  2655,  // 28 C
+      2662,  2663,  2665,  2666,  2668,  2670,  2672,  2674,  2677,  2680,  2683,  2686,  2689,
+      2693,  2697,  2701,  2705,  2710,  2714,  2719,  2724,  2730,  2735,  2741,  2747,  2753,
+      2760,  2766,  2773,  2780,  2788,  2795,  2803,  2811,  2819,  2827,  2836,  2845,  2854,
+      2863,  2873,  2882,  2892,  2902,  2913,  2923,  2934,  2945,  2956,  2968,  2979,  2991,
+      3003,  3015,  3028,  3041,  3054,  3067,  3080,  3094,  3107,  3121,  3136,  3150,  3165,
+      3180,  3195,  3210,  3225,  3241,  3257,  3273,  3290,  3311,  3333,  3355,  3378,  3400,
+      3423,  3446,  3469,  3493,  3516,  3540,  3564,  3589,  3613,  3638},
+    { 2650,  2655,  2660,  2665,  2671,  2677,  2683,  2690,  2697,  2704,  2712,  2719,  2728,  // 29 C
+      2736,  2737,  2737,  2738,  2740,  2742,  2744,  2746,  2749,  2752,  2755,  2759,  2763,
+      2767,  2772,  2776,  2782,  2787,  2793,  2799,  2806,  2813,  2820,  2827,  2835,  2843,
+      2852,  2861,  2870,  2879,  2889,  2899,  2909,  2920,  2931,  2942,  2954,  2966,  2978,
+      2991,  3004,  3017,  3031,  3045,  3059,  3073,  3088,  3103,  3119,  3135,  3151,  3167,
+      3184,  3201,  3219,  3236,  3254,  3273,  3291,  3310,  3330,  3349,  3369,  3390,  3410,
+      3431,  3453,  3474,  3496,  3518,  3541,  3564,  3587,  3613,  3640,  3668,  3695,  3723,
+      3751,  3780,  3809,  3838,  3867,  3897,  3927,  3958,  3989,  4020},
+    { 2724,  2728,  2733,  2738,  2744,  2750,  2756,  2763,  2770,  2778,  2786,  2795,  2804,  // 30 C
+      2813,  2813,  2814,  2815,  2817,  2819,  2821,  2824,  2827,  2831,  2835,  2839,  2844,
+      2850,  2855,  2862,  2868,  2875,  2883,  2891,  2899,  2908,  2917,  2926,  2936,  2947,
+      2958,  2969,  2981,  2993,  3005,  3018,  3032,  3045,  3060,  3074,  3089,  3105,  3121,
+      3137,  3154,  3171,  3189,  3207,  3225,  3244,  3263,  3283,  3303,  3324,  3345,  3366,
+      3388,  3410,  3433,  3456,  3480,  3504,  3528,  3553,  3578,  3604,  3630,  3656,  3683,
+      3711,  3739,  3767,  3795,  3824,  3854,  3884,  3914,  3946,  3978,  4011,  4044,  4077,
+      4111,  4146,  4181,  4216,  4251,  4288,  4324,  4361,  4398,  4436},
+    { 2797,  2801,  2806,  2811,  2817,  2823,  2830,  2838,  2846,  2854,  2863,  2873,  2883,  // 31 C
+      2893,  2894,  2895,  2896,  2898,  2901,  2904,  2908,  2912,  2917,  2922,  2928,  2934,
+      2941,  2948,  2956,  2964,  2973,  2983,  2993,  3003,  3014,  3026,  3038,  3050,  3064,
+      3077,  3091,  3106,  3121,  3137,  3153,  3170,  3187,  3205,  3223,  3242,  3262,  3282,
+      3302,  3323,  3345,  3367,  3389,  3412,  3436,  3460,  3485,  3510,  3535,  3562,  3588,
+      3616,  3643,  3672,  3701,  3730,  3760,  3790,  3821,  3853,  3885,  3917,  3950,  3984,
+      4018,  4052,  4088,  4123,  4159,  4196,  4233,  4271,  4309,  4348,  4388,  4427,  4468,
+      4509,  4550,  4592,  4635,  4678,  4721,  4765,  4810,  4855,  4900},
+    { 2869,  2873,  2878,  2884,  2890,  2897,  2905,  2913,  2922,  2932,  2942,  2953,  2964,  // 32 C
+      2976,  2978,  2979,  2982,  2985,  2989,  2993,  2998,  3003,  3010,  3016,  3024,  3032,
+      3041,  3050,  3060,  3070,  3082,  3093,  3106,  3119,  3133,  3147,  3162,  3177,  3194,
+      3210,  3228,  3246,  3264,  3284,  3304,  3324,  3345,  3367,  3390,  3413,  3436,  3461,
+      3486,  3511,  3537,  3564,  3592,  3620,  3648,  3678,  3707,  3738,  3769,  3801,  3833,
+      3866,  3900,  3934,  3969,  4005,  4041,  4078,  4115,  4153,  4192,  4231,  4271,  4312,
+      4353,  4394,  4437,  4480,  4524,  4568,  4613,  4658,  4704,  4751,  4799,  4847,  4895,
+      4945,  4994,  5045,  5096,  5148,  5200,  5253,  5307,  5361,  5416},
+    { 2938,  2944,  2950,  2956,  2964,  2972,  2981,  2990,  3000,  3012,  3023,  3036,  3049,  // 33 C
+      3063,  3065,  3068,  3072,  3076,  3081,  3087,  3094,  3101,  3109,  3118,  3128,  3138,
+      3149,  3161,  3173,  3186,  3200,  3215,  3230,  3246,  3263,  3280,  3298,  3317,  3337,
+      3357,  3378,  3400,  3423,  3446,  3470,  3495,  3520,  3546,  3573,  3601,  3629,  3658,
+      3688,  3718,  3749,  3781,  3814,  3847,  3881,  3916,  3952,  3988,  4025,  4063,  4101,
+      4140,  4180,  4221,  4262,  4304,  4347,  4390,  4435,  4480,  4525,  4572,  4619,  4667,
+      4715,  4764,  4814,  4865,  4917,  4969,  5022,  5075,  5130,  5185,  5240,  5297,  5354,
+      5412,  5471,  5530,  5590,  5651,  5713,  5775,  5838,  5902,  5966},
+    { 3007,  3013,  3020,  3028,  3037,  3046,  3057,  3068,  3080,  3093,  3106,  3121,  3136,  // 34 C
+      3152,  3156,  3161,  3166,  3172,  3180,  3187,  3196,  3206,  3216,  3227,  3239,  3252,
+      3266,  3280,  3296,  3312,  3329,  3346,  3365,  3384,  3404,  3425,  3447,  3470,  3493,
+      3518,  3543,  3569,  3596,  3623,  3652,  3681,  3711,  3742,  3773,  3806,  3839,  3873,
+      3908,  3944,  3981,  4018,  4056,  4096,  4135,  4176,  4218,  4260,  4303,  4347,  4392,
+      4438,  4484,  4531,  4579,  4628,  4678,  4729,  4780,  4832,  4885,  4939,  4994,  5049,
+      5105,  5162,  5220,  5279,  5339,  5399,  5460,  5522,  5585,  5649,  5713,  5779,  5845,
+      5912,  5979,  6048,  6117,  6188,  6259,  6331,  6403,  6477,  6551},
+    { 3073,  3081,  3089,  3099,  3110,  3121,  3133,  3146,  3161,  3176,  3192,  3209,  3226,  // 35 C
+      3245,  3251,  3257,  3265,  3274,  3283,  3293,  3305,  3317,  3330,  3344,  3359,  3374,
+      3391,  3409,  3427,  3447,  3467,  3489,  3511,  3534,  3558,  3583,  3609,  3636,  3663,
+      3692,  3722,  3752,  3783,  3816,  3849,  3883,  3918,  3954,  3991,  4029,  4068,  4107,
+      4148,  4189,  4232,  4275,  4319,  4364,  4410,  4457,  4505,  4554,  4604,  4654,  4706,
+      4758,  4811,  4866,  4921,  4977,  5034,  5092,  5151,  5211,  5271,  5333,  5395,  5459,
+      5523,  5588,  5655,  5722,  5790,  5859,  5929,  5999,  6071,  6144,  6217,  6292,  6367,
+      6443,  6520,  6598,  6677,  6757,  6838,  6920,  7003,  7086,  7171},
+    { 3157,  3165,  3174,  3184,  3195,  3207,  3221,  3235,  3250,  3266,  3283,  3302,  3321,  // 36 C
+      3341,  3349,  3358,  3368,  3379,  3392,  3405,  3419,  3434,  3450,  3468,  3486,  3505,
+      3525,  3546,  3569,  3592,  3616,  3641,  3668,  3695,  3723,  3753,  3783,  3814,  3847,
+      3880,  3914,  3950,  3986,  4024,  4062,  4101,  4142,  4183,  4226,  4269,  4314,  4359,
+      4406,  4453,  4502,  4551,  4602,  4653,  4706,  4759,  4814,  4869,  4926,  4984,  5042,
+      5102,  5162,  5224,  5287,  5350,  5415,  5481,  5547,  5615,  5684,  5754,  5824,  5896,
+      5969,  6043,  6117,  6193,  6270,  6348,  6426,  6506,  6587,  6669,  6752,  6836,  6920,
+      7006,  7093,  7181,  7270,  7360,  7451,  7543,  7636,  7730,  7825},
+    { 3238,  3247,  3257,  3268,  3281,  3294,  3308,  3324,  3340,  3358,  3377,  3397,  3418,  // 37 C
+      3440,  3451,  3463,  3476,  3490,  3506,  3522,  3539,  3558,  3578,  3599,  3621,  3644,
+      3668,  3693,  3719,  3747,  3775,  3805,  3836,  3868,  3900,  3935,  3970,  4006,  4043,
+      4082,  4121,  4162,  4204,  4247,  4291,  4336,  4382,  4429,  4478,  4527,  4578,  4629,
+      4682,  4736,  4791,  4847,  4904,  4963,  5022,  5083,  5144,  5207,  5271,  5336,  5402,
+      5469,  5537,  5606,  5677,  5748,  5821,  5895,  5970,  6046,  6123,  6201,  6280,  6361,
+      6442,  6525,  6608,  6693,  6779,  6866,  6954,  7043,  7133,  7225,  7317,  7411,  7506,
+      7601,  7698,  7796,  7895,  7996,  8097,  8199,  8303,  8408,  8513},
+    { 3318,  3328,  3340,  3352,  3366,  3381,  3397,  3414,  3432,  3452,  3473,  3495,  3518,  // 38 C
+      3542,  3556,  3572,  3588,  3606,  3625,  3645,  3666,  3689,  3712,  3737,  3763,  3790,
+      3819,  3848,  3879,  3911,  3945,  3979,  4015,  4051,  4089,  4128,  4169,  4210,  4253,
+      4297,  4342,  4389,  4436,  4485,  4535,  4586,  4638,  4692,  4747,  4802,  4860,  4918,
+      4977,  5038,  5100,  5163,  5227,  5293,  5359,  5427,  5496,  5566,  5638,  5710,  5784,
+      5859,  5935,  6013,  6091,  6171,  6252,  6334,  6418,  6502,  6588,  6675,  6763,  6852,
+      6943,  7035,  7128,  7222,  7317,  7413,  7511,  7610,  7710,  7811,  7914,  8018,  8122,
+      8228,  8336,  8444,  8554,  8665,  8777,  8890,  9004,  9120,  9237},
+    { 3397,  3408,  3421,  3435,  3451,  3468,  3486,  3505,  3526,  3547,  3571,  3595,  3621,  // 39 C
+      3648,  3665,  3684,  3705,  3726,  3749,  3773,  3799,  3826,  3854,  3883,  3913,  3945,
+      3978,  4013,  4049,  4086,  4124,  4163,  4204,  4246,  4290,  4335,  4381,  4428,  4476,
+      4526,  4577,  4630,  4683,  4738,  4795,  4852,  4911,  4971,  5033,  5095,  5159,  5224,
+      5291,  5359,  5428,  5498,  5570,  5643,  5717,  5793,  5869,  5948,  6027,  6108,  6190,
+      6273,  6357,  6443,  6530,  6618,  6708,  6799,  6891,  6985,  7080,  7176,  7273,  7372,
+      7471,  7573,  7675,  7779,  7884,  7990,  8098,  8207,  8317,  8429,  8541,  8655,  8771,
+      8887,  9005,  9124,  9245,  9366,  9490,  9614,  9739,  9866,  9994},
+    { 3474,  3487,  3502,  3519,  3536,  3555,  3575,  3597,  3620,  3645,  3671,  3698,  3726,  // 40 C
+      3756,  3778,  3801,  3826,  3852,  3879,  3908,  3938,  3969,  4002,  4036,  4072,  4108,
+      4147,  4186,  4227,  4270,  4313,  4359,  4405,  4453,  4502,  4553,  4605,  4658,  4713,
+      4769,  4827,  4885,  4946,  5007,  5070,  5134,  5200,  5267,  5336,  5406,  5477,  5549,
+      5623,  5699,  5775,  5853,  5933,  6014,  6096,  6179,  6264,  6351,  6438,  6527,  6618,
+      6710,  6803,  6897,  6993,  7090,  7189,  7289,  7391,  7493,  7597,  7703,  7810,  7918,
+      8028,  8139,  8251,  8365,  8480,  8597,  8714,  8834,  8954,  9076,  9200,  9324,  9450,
+      9578,  9707,  9837,  9969, 10102, 10236, 10372, 10509, 10647, 10787},
+    { 3550,  3566,  3583,  3602,  3622,  3643,  3666,  3691,  3717,  3744,  3773,  3803,  3835,  // 41 C
+      3868,  3894,  3922,  3951,  3982,  4014,  4048,  4083,  4119,  4157,  4196,  4237,  4280,
+      4323,  4369,  4415,  4464,  4513,  4564,  4617,  4671,  4726,  4783,  4842,  4901,  4963,
+      5026,  5090,  5155,  5223,  5291,  5361,  5433,  5506,  5580,  5656,  5733,  5812,  5893,
+      5974,  6057,  6142,  6228,  6316,  6405,  6495,  6587,  6681,  6776,  6872,  6970,  7069,
+      7170,  7272,  7375,  7481,  7587,  7695,  7805,  7916,  8028,  8142,  8257,  8374,  8492,
+      8612,  8733,  8855,  8980,  9105,  9232,  9360,  9490,  9622,  9755,  9889, 10025, 10162,
+     10300, 10441, 10582, 10725, 10870, 11016, 11163, 11312, 11462, 11614},
+    { 3626,  3645,  3664,  3685,  3708,  3733,  3758,  3786,  3815,  3845,  3877,  3911,  3946,  // 42 C
+      3983,  4014,  4047,  4081,  4117,  4154,  4193,  4234,  4276,  4319,  4364,  4411,  4459,
+      4509,  4560,  4613,  4667,  4723,  4781,  4840,  4900,  4962,  5026,  5091,  5158,  5226,
+      5296,  5367,  5440,  5514,  5590,  5668,  5747,  5828,  5910,  5993,  6079,  6166,  6254,
+      6344,  6435,  6528,  6623,  6719,  6816,  6916,  7016,  7119,  7222,  7328,  7435,  7543,
+      7653,  7765,  7878,  7992,  8108,  8226,  8345,  8466,  8588,  8712,  8838,  8965,  9093,
+      9223,  9355,  9488,  9623,  9759,  9897, 10036, 10177, 10320, 10464, 10609, 10756, 10905,
+     11055, 11207, 11360, 11515, 11671, 11829, 11988, 12149, 12312, 12476},
+    { 3704,  3725,  3747,  3771,  3797,  3824,  3853,  3884,  3916,  3950,  3985,  4022,  4061,  // 43 C
+      4101,  4138,  4176,  4215,  4257,  4300,  4344,  4391,  4439,  4488,  4539,  4592,  4647,
+      4703,  4760,  4820,  4881,  4943,  5007,  5073,  5141,  5210,  5280,  5353,  5427,  5502,
+      5580,  5658,  5739,  5821,  5905,  5990,  6077,  6166,  6256,  6348,  6442,  6537,  6634,
+      6732,  6832,  6934,  7037,  7142,  7248,  7357,  7466,  7578,  7691,  7806,  7922,  8040,
+      8160,  8281,  8404,  8528,  8654,  8782,  8911,  9042,  9175,  9309,  9445,  9583,  9722,
+      9863, 10005, 10149, 10295, 10442, 10591, 10742, 10894, 11048, 11203, 11360, 11519, 11679,
+     11841, 12005, 12170, 12337, 12505, 12675, 12847, 13020, 13195, 13372},
+    { 3790,  3813,  3837,  3864,  3892,  3922,  3953,  3987,  4022,  4058,  4097,  4137,  4179,  // 44 C
+      4222,  4265,  4308,  4354,  4402,  4451,  4501,  4554,  4608,  4664,  4722,  4781,  4842,
+      4905,  4970,  5036,  5104,  5173,  5245,  5318,  5393,  5469,  5547,  5627,  5709,  5792,
+      5877,  5964,  6052,  6143,  6235,  6328,  6423,  6520,  6619,  6720,  6822,  6926,  7031,
+      7139,  7248,  7358,  7471,  7585,  7701,  7818,  7938,  8059,  8182,  8306,  8432,  8560,
+      8690,  8821,  8954,  9088,  9225,  9363,  9503,  9644,  9788,  9933, 10079, 10228, 10378,
+     10530, 10683, 10838, 10995, 11154, 11315, 11477, 11640, 11806, 11973, 12142, 12313, 12485,
+     12659, 12835, 13013, 13192, 13373, 13555, 13740, 13926, 14114, 14303},
+    { 3880,  3906,  3932,  3961,  3992,  4024,  4058,  4094,  4131,  4171,  4212,  4255,  4300,  // 45 C
+      4347,  4395,  4445,  4497,  4551,  4607,  4664,  4723,  4784,  4847,  4912,  4978,  5046,
+      5116,  5188,  5261,  5337,  5414,  5493,  5573,  5656,  5740,  5826,  5914,  6004,  6095,
+      6188,  6284,  6380,  6479,  6579,  6682,  6786,  6891,  6999,  7108,  7220,  7333,  7447,
+      7564,  7682,  7803,  7924,  8048,  8174,  8301,  8430,  8561,  8694,  8828,  8965,  9103,
+      9243,  9384,  9528,  9673,  9820,  9969, 10120, 10272, 10426, 10582, 10740, 10900, 11061,
+     11224, 11389, 11556, 11725, 11895, 12067, 12241, 12417, 12595, 12774, 12955, 13138, 13323,
+     13509, 13698, 13888, 14080, 14273, 14469, 14666, 14865, 15066, 15269},
+    { 3930,  3960,  3993,  4027,  4063,  4102,  4142,  4184,  4227,  4273,  4320,  4370,  4421,  // 46 C
+      4474,  4529,  4586,  4645,  4706,  4768,  4832,  4899,  4967,  5037,  5109,  5182,  5258,
+      5336,  5415,  5496,  5579,  5664,  5751,  5840,  5930,  6023,  6117,  6214,  6312,  6412,
+      6513,  6617,  6723,  6830,  6940,  7051,  7164,  7279,  7396,  7514,  7635,  7757,  7882,
+      8008,  8136,  8266,  8398,  8532,  8667,  8805,  8944,  9085,  9228,  9373,  9520,  9669,
+      9819,  9971, 10126, 10282, 10440, 10600, 10762, 10925, 11091, 11258, 11428, 11599, 11772,
+     11947, 12124, 12302, 12483, 12665, 12849, 13036, 13224, 13413, 13605, 13799, 13994, 14192,
+     14391, 14592, 14795, 15000, 15207, 15415, 15626, 15838, 16053, 16269},
+    { 3976,  4013,  4051,  4092,  4135,  4179,  4225,  4274,  4324,  4376,  4431,  4487,  4545,  // 47 C
+      4605,  4667,  4731,  4797,  4865,  4935,  5006,  5080,  5156,  5234,  5313,  5395,  5478,
+      5564,  5651,  5740,  5832,  5925,  6020,  6117,  6216,  6318,  6421,  6526,  6632,  6741,
+      6852,  6965,  7080,  7196,  7315,  7436,  7558,  7683,  7809,  7937,  8068,  8200,  8334,
+      8471,  8609,  8749,  8891,  9035,  9181,  9329,  9479,  9630,  9784,  9940, 10098, 10257,
+     10419, 10582, 10748, 10915, 11085, 11256, 11429, 11604, 11782, 11961, 12142, 12325, 12510,
+     12697, 12886, 13077, 13269, 13464, 13661, 13859, 14060, 14263, 14467, 14674, 14882, 15092,
+     15305, 15519, 15735, 15953, 16174, 16396, 16620, 16846, 17074, 17303},
+    { 4020,  4064,  4109,  4156,  4205,  4256,  4309,  4365,  4422,  4481,  4543,  4606,  4671,  // 48 C
+      4739,  4808,  4880,  4953,  5029,  5107,  5186,  5268,  5352,  5437,  5525,  5615,  5706,
+      5800,  5896,  5994,  6094,  6196,  6300,  6406,  6514,  6624,  6736,  6850,  6966,  7084,
+      7205,  7327,  7451,  7577,  7706,  7836,  7968,  8103,  8239,  8378,  8518,  8661,  8805,
+      8952,  9100,  9251,  9404,  9558,  9715,  9874, 10034, 10197, 10362, 10529, 10698, 10869,
+     11042, 11217, 11394, 11573, 11754, 11937, 12122, 12309, 12498, 12689, 12883, 13078, 13275,
+     13475, 13676, 13879, 14085, 14292, 14502, 14713, 14927, 15142, 15360, 15579, 15801, 16025,
+     16250, 16478, 16708, 16940, 17173, 17409, 17647, 17887, 18129, 18373},
+    { 4062,  4112,  4164,  4218,  4275,  4333,  4394,  4456,  4521,  4588,  4657,  4728,  4801,  // 49 C
+      4876,  4953,  5033,  5114,  5198,  5284,  5372,  5462,  5554,  5648,  5744,  5842,  5943,
+      6046,  6150,  6257,  6366,  6477,  6590,  6705,  6823,  6942,  7063,  7187,  7313,  7441,
+      7571,  7703,  7837,  7973,  8111,  8252,  8395,  8539,  8686,  8835,  8986,  9139,  9294,
+      9451,  9611,  9772,  9936, 10102, 10270, 10439, 10611, 10786, 10962, 11140, 11321, 11503,
+     11688, 11875, 12064, 12254, 12448, 12643, 12840, 13039, 13241, 13445, 13650, 13858, 14068,
+     14280, 14494, 14710, 14929, 15149, 15372, 15596, 15823, 16052, 16283, 16516, 16751, 16988,
+     17228, 17469, 17713, 17958, 18206, 18456, 18708, 18962, 19219, 19477},
+    { 4101,  4159,  4218,  4280,  4344,  4410,  4478,  4548,  4621,  4696,  4772,  4852,  4933,  // 50 C
+      5016,  5102,  5190,  5280,  5372,  5466,  5563,  5661,  5762,  5865,  5971,  6078,  6187,
+      6299,  6413,  6529,  6648,  6768,  6891,  7016,  7143,  7272,  7403,  7537,  7672,  7810,
+      7950,  8093,  8237,  8384,  8533,  8684,  8837,  8992,  9150,  9309,  9471,  9635,  9801,
+      9970, 10140, 10313, 10488, 10665, 10845, 11026, 11210, 11395, 11583, 11774, 11966, 12161,
+     12357, 12556, 12757, 12961, 13166, 13374, 13583, 13795, 14010, 14226, 14444, 14665, 14888,
+     15113, 15340, 15570, 15801, 16035, 16271, 16509, 16749, 16992, 17237, 17483, 17732, 17984,
+     18237, 18493, 18750, 19010, 19272, 19537, 19803, 20072, 20342, 20615},
+};
+
+
+static int64_t div_round(int64_t numerator, int64_t denominator)
+{
+    int64_t half = denominator / 2;
+    return (numerator < 0) ? -((-numerator + half) / denominator) : (numerator + half) / denominator;
+}
+
+
+static uint32_t isqrt64(uint64_t value)
+{
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t)root;
+}
+
+
+static int16_t clamp16(int64_t value)
+{
+    return (int16_t)((value > INT16_MAX) ? INT16_MAX : (value < INT16_MIN) ? INT16_MIN : value);
+}
+
+
+// Saturation vapour pressure at a temperature in 0.1 C within the table
+static uint32_t saturation_at(int16_t temperature_x10)
+{
+    int32_t offset = temperature_x10 - TABLE_MIN_C * 10;
+    int32_t index = offset / 10;
+    int32_t tenths = offset % 10;
+
+    if (tenths == 0) {
+        return saturation_mpa[index];
+    }
+    return saturation_mpa[index] + ((saturation_mpa[index + 1] - saturation_mpa[index]) * (uint32_t)tenths + 5u) / 10u;
+}
+
+
+// Temperature in 0.1 C at which the saturation pressure equals pressure_mpa;
+// the dew point is at most the air temperature, so the search walks down
+// from the table entry at or above it, usually a few degrees
+static int16_t dew_point_of(uint32_t pressure_mpa, int16_t temperature_x10)
+{
+    if (pressure_mpa < saturation_mpa[0]) {
+        return DHT11_PSYCHRO_DEW_POINT_MIN_X10;
+    }
+
+    size_t low = (size_t)((temperature_x10 - TABLE_MIN_C * 10 + 9) / 10);
+    if (low >= TABLE_SIZE - 1) {
+        low = TABLE_SIZE - 2;
+    }
+    while (saturation_mpa[low] > pressure_mpa) {
+        low--;
+    }
+    if (pressure_mpa >= saturation_mpa[low + 1]) {
+        return TABLE_MAX_C * 10;
+    }
+
+    uint32_t span = saturation_mpa[low + 1] - saturation_mpa[low];
+    uint32_t tenths = ((pressure_mpa - saturation_mpa[low]) * 10u + span / 2u) / span;
+    return (int16_t)((TABLE_MIN_C + (int32_t)low) * 10 + (int32_t)tenths);
+}
+
+
+// The adjustments end inside two cells, at 87 F above 85 %RH and at 112 F
+// below 13 %RH; interpolating across those edges would exceed 0.1 C
+static bool in_heat_table(const dht11_reading_fixed_t *reading)
+{
+    int16_t temperature_x10 = reading->temperature_x10;
+    int16_t humidity_x10 = reading->humidity_x10;
+
+    if (temperature_x10 < HEAT_TABLE_MIN_C * 10 || temperature_x10 > HEAT_TABLE_MAX_C * 10) {
+        return false;
+    }
+    if (humidity_x10 > 850 && temperature_x10 > 300 && temperature_x10 < 310) {
+        return false;
+    }
+    return !(humidity_x10 < 130 && temperature_x10 > 440 && temperature_x10 < 450);
+}
+
+
+// Heat index in 0.1 C from the table, interpolated on tenths of both axes
+static int16_t heat_index_from_table(const dht11_reading_fixed_t *reading)
+{
+    int32_t row = reading->temperature_x10 / 10 - HEAT_TABLE_MIN_C;
+    int32_t row_tenths = reading->temperature_x10 % 10;
+    int32_t column = reading->humidity_x10 / 10;
+    int32_t column_tenths = reading->humidity_x10 % 10;
+    const int16_t *low = heat_index_x100[row];
+    const int16_t *high = (row_tenths != 0) ? heat_index_x100[row + 1] : low;
+    int32_t next = (column_tenths != 0) ? column + 1 : column;
+
+    int32_t below = low[column] * (10 - column_tenths) + low[next] * column_tenths;
+    int32_t above = high[column] * (10 - column_tenths) + high[next] * column_tenths;
+    return (int16_t)div_round(below * (10 - row_tenths) + above * row_tenths, 1000);
+}
+
+
+// NWS heat index; works in 0.0001 F, t is the temperature in 0.02 F and r
+// the humidity in 0.1 %RH so that both are exact. The polynomial itself is
+// only evaluated outside the table
+static int16_t heat_index_of(const dht11_reading_fixed_t *reading)
+{
+    int64_t t = 9 * (int64_t)reading->temperature_x10 + 1600;
+    int64_t r = reading->humidity_x10;
+    int64_t heat = 220 * t + 47 * r - 103000;
+
+    // The simple formula stands while its average with T stays below 80 F
+    if (heat + 200 * t >= 1600000) {
+        if (in_heat_table(reading)) {
+            return heat_index_from_table(reading);
+        }
+
+        int64_t sum = HI_C0 * 250000 + HI_C1 * t * 5000 + HI_C2 * r * 25000 + HI_C3 * t * r * 500 +
+                      HI_C4 * t * t * 100 + HI_C5 * r * r * 2500 + HI_C6 * t * t * r * 10 +
+                      HI_C7 * t * r * r * 50 + HI_C8 * t * t * r * r;
+        heat = div_round(sum, 2500000000LL);
+
+        if (r < 130 && t >= 4000 && t <= 5600) {
+            int64_t distance = (t > 4750) ? t - 4750 : 4750 - t;
+            uint32_t root_q16 = isqrt64(((uint64_t)(850 - distance) << 32) / 850u);
+            heat -= div_round(250 * (130 - r) * (int64_t)root_q16, 65536);
+        } else if (r > 850 && t >= 4000 && t <= 4350) {
+            heat += div_round((r - 850) * (4350 - t) * 2, 5);
+        }
+    }
+
+    return clamp16(div_round(heat - 320000, 1800));
+}
+
+
+dht11_result_t dht11_psychro_compute(const dht11_reading_fixed_t *reading, dht11_psychro_t *metrics)
+{
+    if (reading == NULL || metrics == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    if (reading->humidity_x10 < DHT11_HUMIDITY_MIN_X10 || reading->humidity_x10 > DHT11_HUMIDITY_MAX_X10 ||
+        reading->temperature_x10 < DHT11_TEMPERATURE_MIN_X10 || reading->temperature_x10 > DHT11_TEMPERATURE_MAX_X10) {
+        return DHT11_ERR_INVALID_DATA;
+    }
+
+    uint32_t pressure_mpa = (uint32_t)(((uint64_t)saturation_at(reading->temperature_x10) *
+                                        (uint32_t)reading->humidity_x10 + 500u) / 1000u);
+    int64_t kelvin_x100 = (int64_t)reading->temperature_x10 * 10 + 27315;
+
+    metrics->dew_point_x10 = dew_point_of(pressure_mpa, reading->temperature_x10);
+    metrics->heat_index_x10 = heat_index_of(reading);
+    metrics->absolute_humidity_x100 = (uint16_t)div_round((int64_t)pressure_mpa * VAPOUR_CONSTANT,
+                                                          kelvin_x100 * 10000);
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_psychro_from_raw(const dht11_raw_data_t *raw_data, dht11_psychro_t *metrics)
+{
+    dht11_reading_fixed_t reading;
+
+    if (raw_data == NULL || metrics == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    dht11_result_t result = dht11_convert_raw_to_fixed(raw_data, &reading);
+    if (result != DHT11_OK) {
+        return result;
+    }
+
+    return dht11_psychro_compute(&reading, metrics);
+}
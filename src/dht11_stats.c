@@ -0,0 +1,240 @@
+/**
+ * @file dht11_stats.c
+ * @brief Opt-in transaction statistics published through a sequence counter
+ *
+ * The owning task is the only writer. Readers copy the counters word by word
+ * and retry when the sequence changed underneath them.
+ */
+
+#include "dht11_internal.h"
+#include "nhal_common.h"
+#include <string.h>
+
+#define STATS_WORDS     (sizeof(dht11_stats_counters_t) / sizeof(uint32_t))
+
+
+static void stat_store(uint32_t *counter, uint32_t value)
+{
+    __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+}
+
+static void stat_add(uint32_t *counter, uint32_t value)
+{
+    stat_store(counter, *counter + value);
+}
+
+static void stat_max(uint32_t *counter, uint32_t value)
+{
+    if (value > *counter) {
+        stat_store(counter, value);
+    }
+}
+
+static void stat_histogram(uint32_t *buckets, uint32_t duration_us)
+{
+    uint32_t bucket = 0;
+    while ((duration_us >>= 1) != 0 && bucket < DHT11_STATS_HISTOGRAM_BUCKETS - 1u) {
+        bucket++;
+    }
+    stat_add(&buckets[bucket], 1);
+}
+
+static void stat_pulse(uint32_t *buckets, uint32_t width_us)
+{
+    uint32_t bucket = width_us / DHT11_STATS_PULSE_BUCKET_US;
+    if (bucket > DHT11_STATS_PULSE_BUCKETS - 1u) {
+        bucket = DHT11_STATS_PULSE_BUCKETS - 1u;
+    }
+    stat_add(&buckets[bucket], 1);
+}
+
+// Folds the pulse widths of a fully decoded frame into the histograms
+static void record_frame_timing(dht11_stats_counters_t *counters, const dht11_edge_decoder_t *decoder)
+{
+    const dht11_bit_timing_t *timing = decoder->timing;
+    uint32_t margin_us = UINT32_MAX;
+
+    for (int bit = 0; bit < DHT11_DATA_BITS; bit++) {
+        bool one = (decoder->data_bytes[bit >> 3] >> (7 - (bit & 7))) & 1u;
+        uint32_t high_us = timing->high_us[bit];
+        uint32_t margin = dht11_decoder_confidence(decoder, bit);
+
+        stat_pulse(one ? counters->one_high_histogram : counters->zero_high_histogram, high_us);
+        stat_pulse(counters->low_histogram, timing->low_us[bit]);
+        if (margin < margin_us) {
+            margin_us = margin;
+        }
+    }
+
+    stat_pulse(counters->margin_histogram, margin_us);
+    stat_store(&counters->last_margin_us, margin_us);
+    if (counters->frames_timed == 0 || margin_us < counters->min_margin_us) {
+        stat_store(&counters->min_margin_us, margin_us);
+    }
+    stat_add(&counters->frames_timed, 1);
+}
+
+static void write_begin(dht11_stats_t *stats)
+{
+    __atomic_store_n(&stats->sequence, stats->sequence + 1u, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    if (__atomic_load_n(&stats->reset_pending, __ATOMIC_ACQUIRE)) {
+        uint32_t *words = (uint32_t *)&stats->counters;
+        for (size_t i = 0; i < STATS_WORDS; i++) {
+            stat_store(&words[i], 0);
+        }
+        __atomic_store_n(&stats->reset_pending, 0u, __ATOMIC_RELAXED);
+    }
+}
+
+static void write_end(dht11_stats_t *stats)
+{
+    __atomic_store_n(&stats->sequence, stats->sequence + 1u, __ATOMIC_RELEASE);
+}
+
+void dht11_stats_begin(dht11_handle_t *handle)
+{
+    if (handle->stats == NULL) {
+        return;
+    }
+
+    handle->stats_start_us = (uint32_t)nhal_get_timestamp_microseconds();
+    handle->stats_mark_us = handle->stats_start_us;
+    memset(handle->stats_phase_us, 0, sizeof(handle->stats_phase_us));
+    handle->stats_phase = DHT11_PHASE_START;
+}
+
+void dht11_stats_mark_at(dht11_handle_t *handle, uint32_t timestamp_us)
+{
+    if (handle->stats == NULL || handle->stats_phase >= DHT11_PHASE_DATA) {
+        return;
+    }
+
+    handle->stats_phase_us[handle->stats_phase] = timestamp_us - handle->stats_mark_us;
+    handle->stats_mark_us = timestamp_us;
+    handle->stats_phase++;
+}
+
+void dht11_stats_mark(dht11_handle_t *handle)
+{
+    if (handle->stats == NULL || handle->stats_phase >= DHT11_PHASE_DATA) {
+        return;
+    }
+
+    dht11_stats_mark_at(handle, (uint32_t)nhal_get_timestamp_microseconds());
+}
+
+void dht11_stats_end(dht11_handle_t *handle, dht11_result_t result, bool polled)
+{
+    dht11_stats_t *stats = handle->stats;
+    dht11_phase_t phase = handle->stats_phase;
+
+    handle->stats_phase = DHT11_PHASE_COUNT;
+    if (stats == NULL) {
+        return;
+    }
+
+    uint32_t now_us = (phase < DHT11_PHASE_COUNT) ? (uint32_t)nhal_get_timestamp_microseconds() : 0;
+    dht11_stats_counters_t *counters = &stats->counters;
+
+    write_begin(stats);
+
+    if ((unsigned)result < DHT11_RESULT_COUNT) {
+        stat_add(&counters->results[result], 1);
+    }
+
+    // Rejected attempts never started a transaction
+    if (phase < DHT11_PHASE_COUNT) {
+        uint32_t latency_us = now_us - handle->stats_start_us;
+        handle->stats_phase_us[phase] += now_us - handle->stats_mark_us;
+
+        stat_add(&counters->transactions, 1);
+        if (handle->stats_last_failed) {
+            stat_add(&counters->retries, 1);
+        }
+        handle->stats_last_failed = result != DHT11_OK;
+
+        stat_add(&counters->latency_total_us, latency_us);
+        stat_max(&counters->latency_max_us, latency_us);
+        stat_histogram(counters->latency_histogram, latency_us);
+
+        for (int i = 0; i < DHT11_PHASE_COUNT; i++) {
+            stat_add(&counters->phase_total_us[i], handle->stats_phase_us[i]);
+            stat_max(&counters->phase_max_us[i], handle->stats_phase_us[i]);
+            stat_histogram(counters->phase_histogram[i], handle->stats_phase_us[i]);
+        }
+
+        // Polled receives spin on the pin from the line release to the end of the frame
+        if (polled) {
+            stat_add(&counters->busy_wait_us,
+                     handle->stats_phase_us[DHT11_PHASE_RESPONSE] + handle->stats_phase_us[DHT11_PHASE_DATA]);
+        }
+
+        if (handle->correction_attempted) {
+            stat_add(&counters->corrections_attempted, 1);
+            if (handle->frame_corrected) {
+                stat_add(&counters->corrections_succeeded, 1);
+            }
+        }
+
+        // Frames that fail the checksum are recorded too; their margins show why
+        if (handle->decoder.bit_count == DHT11_DATA_BITS && handle->decoder.timing != NULL) {
+            record_frame_timing(counters, &handle->decoder);
+        }
+    }
+
+    write_end(stats);
+}
+
+dht11_result_t dht11_set_stats(dht11_handle_t *handle, dht11_stats_t *stats)
+{
+    if (handle == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    handle->stats = stats;
+    handle->stats_phase = DHT11_PHASE_COUNT;
+    handle->stats_last_failed = false;
+    return DHT11_OK;
+}
+
+dht11_result_t dht11_stats_snapshot(const dht11_stats_t *stats, dht11_stats_counters_t *counters)
+{
+    if (stats == NULL || counters == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    const uint32_t *src = (const uint32_t *)&stats->counters;
+    uint32_t *dst = (uint32_t *)counters;
+
+    for (int attempt = 0; attempt < DHT11_STATS_MAX_RETRIES; attempt++) {
+        uint32_t before = __atomic_load_n(&stats->sequence, __ATOMIC_ACQUIRE);
+        if (before & 1u) {
+            continue;
+        }
+
+        // A reset that the writer has not applied yet reads as zero
+        bool reset_pending = __atomic_load_n(&stats->reset_pending, __ATOMIC_RELAXED) != 0;
+        for (size_t i = 0; i < STATS_WORDS; i++) {
+            dst[i] = reset_pending ? 0 : __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&stats->sequence, __ATOMIC_RELAXED) == before) {
+            return DHT11_OK;
+        }
+    }
+
+    return DHT11_ERR_IN_PROGRESS;
+}
+
+dht11_result_t dht11_stats_reset(dht11_stats_t *stats)
+{
+    if (stats == NULL) {
+        return DHT11_ERR_INVALID_ARG;
+    }
+
+    __atomic_store_n(&stats->reset_pending, 1u, __ATOMIC_RELEASE);
+    return DHT11_OK;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file dht11_variant.c
+ * @brief Descriptors of the sensor families sharing the DHT11 framing
+ */
+
+#include "dht11.h"
+
+
+// DHT11: integer and tenths bytes per value
+static void decode_bytes(const dht11_raw_data_t *raw_data, dht11_reading_fixed_t *reading)
+{
+    reading->humidity_x10 = (int16_t)(raw_data->humidity_integer * 10 + raw_data->humidity_decimal);
+    reading->temperature_x10 = (int16_t)(raw_data->temperature_integer * 10 + raw_data->temperature_decimal);
+}
+
+
+// DHT22 family: 16-bit big-endian tenths, temperature sign in the top bit
+static void decode_tenths(const dht11_raw_data_t *raw_data, dht11_reading_fixed_t *reading)
+{
+    uint16_t humidity = (uint16_t)((raw_data->humidity_integer << 8) | raw_data->humidity_decimal);
+    int16_t temperature = (int16_t)(((raw_data->temperature_integer & 0x7Fu) << 8) | raw_data->temperature_decimal);
+
+    // Out-of-range values only need to stay out of range
+    reading->humidity_x10 = (humidity > INT16_MAX) ? INT16_MAX : (int16_t)humidity;
+    reading->temperature_x10 = (raw_data->temperature_integer & 0x80u) ? (int16_t)-temperature : temperature;
+}
+
+
+const dht11_variant_t dht11_variant_dht11 = {
+    .name = "DHT11",
+    .start_signal_ms = DHT11_START_SIGNAL_MS,
+    .min_sampling_period_ms = DHT11_MIN_SAMPLING_PERIOD_MS,
+    .humidity_min_x10 = DHT11_HUMIDITY_MIN_X10,
+    .humidity_max_x10 = DHT11_HUMIDITY_MAX_X10,
+    .temperature_min_x10 = DHT11_TEMPERATURE_MIN_X10,
+    .temperature_max_x10 = DHT11_TEMPERATURE_MAX_X10,
+    .decode = decode_bytes,
+};
+
+const dht11_variant_t dht11_variant_dht22 = {
+    .name = "DHT22",
+    .start_signal_ms = 1,
+    .min_sampling_period_ms = 1000,
+    .humidity_min_x10 = 0,
+    .humidity_max_x10 = 1000,
+    .temperature_min_x10 = -400,
+    .temperature_max_x10 = 800,
+    .decode = decode_tenths,
+};
+
+const dht11_variant_t dht11_variant_am2302 = {
+    .name = "AM2302",
+    .start_signal_ms = 1,
+    .min_sampling_period_ms = 2000,
+    .humidity_min_x10 = 0,
+    .humidity_max_x10 = 1000,
+    .temperature_min_x10 = -400,
+    .temperature_max_x10 = 800,
+    .decode = decode_tenths,
+};
+
+const dht11_variant_t dht11_variant_dht21 = {
+    .name = "DHT21",
+    .start_signal_ms = 1,
+    .min_sampling_period_ms = 2000,
+    .humidity_min_x10 = 0,
+    .humidity_max_x10 = 1000,
+    .temperature_min_x10 = -400,
+    .temperature_max_x10 = 800,
+    .decode = decode_tenths,
+};
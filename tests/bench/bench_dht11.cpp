@@ -0,0 +1,297 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include "nhal_dht11_sim.hpp"
+#include "dht11_frame_builder.hpp"
+
+extern "C" {
+    #include "dht11.h"
+    #include "dht11_batch.h"
+    #include "dht11_psychro.h"
+}
+
+namespace {
+
+const uint8_t kFrame[DHT11_DATA_BYTES] = {55, 0, 23, 0, 78};
+
+dht11_raw_data_t MakeRaw(const uint8_t bytes[DHT11_DATA_BYTES])
+{
+    dht11_raw_data_t raw_data;
+    raw_data.humidity_integer = bytes[0];
+    raw_data.humidity_decimal = bytes[1];
+    raw_data.temperature_integer = bytes[2];
+    raw_data.temperature_decimal = bytes[3];
+    raw_data.checksum = bytes[4];
+    return raw_data;
+}
+
+// Reports the simulator's HAL call counts as per-transaction averages
+void ReportHalCalls(benchmark::State& state)
+{
+    const Dht11SimCounters& counters = Dht11Sim::instance().counters();
+    const auto avg = benchmark::Counter::kAvgIterations;
+
+    state.counters["hal_calls"] = benchmark::Counter((double)counters.TotalCalls(), avg);
+    state.counters["get_state"] = benchmark::Counter((double)counters.get_state, avg);
+    state.counters["timestamp_us"] = benchmark::Counter((double)counters.timestamp_us, avg);
+    state.counters["timestamp_ms"] = benchmark::Counter((double)counters.timestamp_ms, avg);
+    state.counters["delay"] = benchmark::Counter((double)(counters.delay_us + counters.delay_ms), avg);
+}
+
+// Frames with varied values; one in eight fails the checksum
+std::vector<dht11_raw_data_t> MakeFrames(size_t count)
+{
+    std::vector<dht11_raw_data_t> frames(count);
+    for (size_t i = 0; i < count; i++) {
+        uint8_t bytes[DHT11_DATA_BYTES] = {(uint8_t)(20 + i % 70), (uint8_t)(i % 10), (uint8_t)(i % 50), 0, 0};
+        bytes[4] = (uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3] + (i % 8 == 0));
+        frames[i] = MakeRaw(bytes);
+    }
+    return frames;
+}
+
+// Readings across the DHT11's range, 20 to 90 %RH and 0 to 50 C
+std::vector<dht11_reading_fixed_t> MakeReadings(size_t count)
+{
+    std::vector<dht11_reading_fixed_t> readings(count);
+    for (size_t i = 0; i < count; i++) {
+        readings[i].humidity_x10 = (int16_t)(200 + (i * 37) % 701);
+        readings[i].temperature_x10 = (int16_t)((i * 53) % 501);
+    }
+    return readings;
+}
+
+// What callers computed with libm before dht11_psychro.h
+void PsychroLibm(const dht11_reading_fixed_t& reading, dht11_psychro_t *metrics)
+{
+    float temperature = reading.temperature_x10 / 10.0f;
+    float humidity = reading.humidity_x10 / 10.0f;
+    float gamma = logf(humidity / 100.0f) + 17.62f * temperature / (243.12f + temperature);
+    float pressure = humidity / 100.0f * 6.112f * expf(17.62f * temperature / (243.12f + temperature));
+    float t = temperature * 1.8f + 32.0f;
+    float heat = 0.5f * (t + 61.0f + (t - 68.0f) * 1.2f + humidity * 0.094f);
+
+    if ((heat + t) / 2.0f >= 80.0f) {
+        heat = -42.379f + 2.04901523f * t + 10.14333127f * humidity - 0.22475541f * t * humidity -
+               0.00683783f * t * t - 0.05481717f * humidity * humidity + 0.00122874f * t * t * humidity +
+               0.00085282f * t * humidity * humidity - 0.00000199f * t * t * humidity * humidity;
+        if (humidity < 13.0f && t >= 80.0f && t <= 112.0f) {
+            heat -= (13.0f - humidity) / 4.0f * sqrtf((17.0f - fabsf(t - 95.0f)) / 17.0f);
+        }
+    }
+
+    metrics->dew_point_x10 = (int16_t)lrintf(2431.2f * gamma / (17.62f - gamma));
+    metrics->heat_index_x10 = (int16_t)lrintf((heat - 32.0f) / 0.18f);
+    metrics->absolute_humidity_x100 = (uint16_t)lrintf(21667.9f * pressure / (273.15f + temperature));
+}
+
+} // namespace
+
+static void BM_VerifyChecksum(benchmark::State& state)
+{
+    dht11_raw_data_t raw_data = MakeRaw(kFrame);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(raw_data);
+        benchmark::DoNotOptimize(dht11_verify_checksum(&raw_data));
+    }
+}
+BENCHMARK(BM_VerifyChecksum);
+
+static void BM_ConvertRawToReading(benchmark::State& state)
+{
+    dht11_raw_data_t raw_data = MakeRaw(kFrame);
+    dht11_reading_t reading;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(raw_data);
+        benchmark::DoNotOptimize(dht11_convert_raw_to_reading(&raw_data, &reading));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_ConvertRawToReading);
+
+static void BM_ConvertRawToFixed(benchmark::State& state)
+{
+    dht11_raw_data_t raw_data = MakeRaw(kFrame);
+    dht11_reading_fixed_t reading;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(raw_data);
+        benchmark::DoNotOptimize(dht11_convert_raw_to_fixed(&raw_data, &reading));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_ConvertRawToFixed);
+
+// Batch conversion against the equivalent loop of single-frame conversions
+static void BM_ConvertScalarLoop(benchmark::State& state)
+{
+    std::vector<dht11_raw_data_t> frames = MakeFrames((size_t)state.range(0));
+    std::vector<dht11_reading_fixed_t> readings(frames.size());
+    std::vector<dht11_result_t> results(frames.size());
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < frames.size(); i++) {
+            results[i] = dht11_convert_raw_to_fixed(&frames[i], &readings[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConvertScalarLoop)->Arg(64)->Arg(4096);
+
+static void BM_ConvertBatch(benchmark::State& state)
+{
+    std::vector<dht11_raw_data_t> frames = MakeFrames((size_t)state.range(0));
+    std::vector<int16_t> humidity(frames.size());
+    std::vector<int16_t> temperature(frames.size());
+    std::vector<uint32_t> valid(DHT11_BATCH_BITMAP_WORDS(frames.size()));
+    dht11_batch_out_t out = {humidity.data(), temperature.data(), valid.data()};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dht11_convert_batch(frames.data(), frames.size(), &out, nullptr));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConvertBatch)->Arg(64)->Arg(4096);
+
+static void BM_ConvertBatchSoa(benchmark::State& state)
+{
+    std::vector<dht11_raw_data_t> frames = MakeFrames((size_t)state.range(0));
+    std::vector<uint8_t> bytes[DHT11_DATA_BYTES];
+    for (const auto& frame : frames) {
+        bytes[0].push_back(frame.humidity_integer);
+        bytes[1].push_back(frame.humidity_decimal);
+        bytes[2].push_back(frame.temperature_integer);
+        bytes[3].push_back(frame.temperature_decimal);
+        bytes[4].push_back(frame.checksum);
+    }
+    dht11_raw_soa_t soa = {bytes[0].data(), bytes[1].data(), bytes[2].data(), bytes[3].data(), bytes[4].data()};
+    std::vector<int16_t> humidity(frames.size());
+    std::vector<int16_t> temperature(frames.size());
+    std::vector<uint32_t> valid(DHT11_BATCH_BITMAP_WORDS(frames.size()));
+    dht11_batch_out_t out = {humidity.data(), temperature.data(), valid.data()};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dht11_convert_batch_soa(&soa, frames.size(), &out, nullptr));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ConvertBatchSoa)->Arg(64)->Arg(4096);
+
+// Derived metrics from the lookup tables against the libm formulas
+static void BM_PsychroFixed(benchmark::State& state)
+{
+    std::vector<dht11_reading_fixed_t> readings = MakeReadings(1024);
+    std::vector<dht11_psychro_t> metrics(readings.size());
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < readings.size(); i++) {
+            dht11_psychro_compute(&readings[i], &metrics[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)readings.size());
+}
+BENCHMARK(BM_PsychroFixed);
+
+static void BM_PsychroLibm(benchmark::State& state)
+{
+    std::vector<dht11_reading_fixed_t> readings = MakeReadings(1024);
+    std::vector<dht11_psychro_t> metrics(readings.size());
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < readings.size(); i++) {
+            PsychroLibm(readings[i], &metrics[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)readings.size());
+}
+BENCHMARK(BM_PsychroLibm);
+
+static void BM_DecodeEdges(benchmark::State& state)
+{
+    std::vector<uint32_t> edges = BuildFrameEdges(kFrame, 1000);
+    dht11_raw_data_t raw_data;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dht11_decode_edges(edges.data(), edges.size(), &raw_data));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_DecodeEdges);
+
+// Full blocking read against the simulator; time is dominated by the busy-wait loops
+static void BM_ReadSimulated(benchmark::State& state)
+{
+    Dht11SimConfig config;
+    config.jitter_us = (uint32_t)state.range(0);
+    Dht11Sim::instance().Reset(config);
+
+    dht11_handle_t handle;
+    dht11_reading_t reading;
+    dht11_init(&handle, (struct nhal_pin_context*)0x1000);
+    Dht11Sim::instance().ResetCounters();
+
+    int64_t failures = 0;
+    for (auto _ : state) {
+        Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+        failures += dht11_read(&handle, &reading) != DHT11_OK;
+    }
+
+    ReportHalCalls(state);
+    state.counters["failures"] = benchmark::Counter((double)failures);
+}
+BENCHMARK(BM_ReadSimulated)->Arg(0)->Arg(8);
+
+// Lock-free readers of the latest reading; with Arg(1) a writer thread keeps
+// publishing through the simulator, so reads race the sequence counter
+static dht11_handle_t latest_handle;
+static std::atomic<bool> latest_stop(false);
+static std::thread latest_writer;
+
+static void BM_GetLatestConcurrent(benchmark::State& state)
+{
+    if (state.thread_index() == 0) {
+        dht11_reading_t reading;
+        Dht11Sim::instance().Reset();
+        dht11_init(&latest_handle, (struct nhal_pin_context*)0x1000);
+        Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+        dht11_read(&latest_handle, &reading);
+
+        latest_stop = false;
+        if (state.range(0) != 0) {
+            latest_writer = std::thread([]() {
+                dht11_reading_t published;
+                while (!latest_stop.load(std::memory_order_relaxed)) {
+                    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+                    dht11_read(&latest_handle, &published);
+                }
+            });
+        }
+    }
+
+    int64_t retries = 0;
+    for (auto _ : state) {
+        dht11_reading_fixed_t reading;
+        dht11_result_t result = dht11_get_latest_fixed(&latest_handle, &reading, nullptr);
+        retries += result != DHT11_OK;
+        benchmark::DoNotOptimize(reading);
+    }
+
+    if (state.thread_index() == 0 && latest_writer.joinable()) {
+        latest_stop = true;
+        latest_writer.join();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["in_progress"] = benchmark::Counter((double)retries, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_GetLatestConcurrent)->Arg(0)->Arg(1)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
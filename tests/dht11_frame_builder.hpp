@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+extern "C" {
+    #include "nhal_pin_types.h"
+    #include "dht11_defs.h"
+}
+
+// Builds the edge timestamps of a complete frame starting at start_us
+inline std::vector<uint32_t> BuildFrameEdges(const uint8_t bytes[DHT11_DATA_BYTES], uint32_t start_us,
+                                             uint32_t zero_high_us = DHT11_BIT_0_HIGH_US,
+                                             uint32_t one_high_us = DHT11_BIT_1_HIGH_US)
+{
+    std::vector<uint32_t> edges;
+    uint32_t t = start_us;
+
+    edges.push_back(t);                         // Response low
+    t += DHT11_RESPONSE_LOW_US;
+    edges.push_back(t);                         // Response high
+    t += DHT11_RESPONSE_HIGH_US;
+
+    for (int bit = 0; bit < DHT11_DATA_BITS; bit++) {
+        bool one = (bytes[bit / 8] >> (7 - (bit % 8))) & 1;
+        edges.push_back(t);                     // Bit low
+        t += DHT11_BIT_LOW_US;
+        edges.push_back(t);                     // Bit high
+        t += one ? one_high_us : zero_high_us;
+    }
+
+    edges.push_back(t);                         // End of frame low
+    t += DHT11_BIT_LOW_US;
+    edges.push_back(t);                         // Line released
+    return edges;
+}
+
+// Pin levels seen by the polling receiver for a frame of all '0' bits, one
+// entry per nhal_pin_get_state() call when every wait succeeds on its first poll
+inline std::vector<nhal_pin_state_t> AllZeroFramePinScript()
+{
+    std::vector<nhal_pin_state_t> levels = {NHAL_PIN_LOW, NHAL_PIN_HIGH};
+
+    for (int bit = 0; bit < DHT11_DATA_BITS; bit++) {
+        levels.push_back(NHAL_PIN_LOW);
+        levels.push_back(NHAL_PIN_HIGH);
+        levels.push_back(NHAL_PIN_LOW);
+    }
+    return levels;
+}
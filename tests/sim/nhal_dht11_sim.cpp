@@ -0,0 +1,282 @@
+#include "nhal_dht11_sim.hpp"
+
+#include <cstring>
+
+extern "C" {
+    #include "nhal_common.h"
+    #include "nhal_pin.h"
+}
+
+Dht11Sim& Dht11Sim::instance()
+{
+    static Dht11Sim sim;
+    return sim;
+}
+
+void Dht11Sim::Reset(const Dht11SimConfig& config)
+{
+    config_ = config;
+    ResetCounters();
+    now_us_ = config.start_time_us;
+    rng_state_ = config.seed ? config.seed : 1;
+    host_output_ = false;
+    host_state_ = NHAL_PIN_HIGH;
+    host_low_ = false;
+    host_low_since_us_ = 0;
+    waveform_.clear();
+    cursor_ = 0;
+    sensor_level_ = NHAL_PIN_HIGH;
+    edge_listener_ = nullptr;
+}
+
+void Dht11Sim::ResetCounters()
+{
+    memset(&counters_, 0, sizeof(counters_));
+}
+
+void Dht11Sim::AdvanceUs(uint64_t us)
+{
+    now_us_ += us;
+    SensorLevel();
+}
+
+void Dht11Sim::SetDirection(nhal_pin_dir_t direction)
+{
+    counters_.set_direction++;
+    now_us_ += config_.call_cost_us;
+    host_output_ = direction == NHAL_PIN_DIR_OUTPUT;
+    HostLevelChanged();
+}
+
+void Dht11Sim::SetState(nhal_pin_state_t state)
+{
+    counters_.set_state++;
+    now_us_ += config_.call_cost_us;
+    host_state_ = state;
+    HostLevelChanged();
+}
+
+nhal_pin_state_t Dht11Sim::GetState()
+{
+    counters_.get_state++;
+    now_us_ += config_.call_cost_us;
+    return LineLevel();
+}
+
+void Dht11Sim::SampleLine(uint32_t *samples, size_t count, uint32_t period_us)
+{
+    memset(samples, 0, ((count + 31) / 32) * sizeof(samples[0]));
+    for (size_t i = 0; i < count; i++) {
+        if (LineLevel() == NHAL_PIN_HIGH) {
+            samples[i / 32] |= 1u << (i % 32);
+        }
+        AdvanceUs(period_us);
+    }
+    counters_.bulk_samples += count;
+}
+
+nhal_pin_state_t Dht11Sim::LineLevel()
+{
+    // Open-drain line: either side pulling low wins
+    bool host_pulls_low = host_output_ && host_state_ == NHAL_PIN_LOW;
+    return (host_pulls_low || SensorLevel() == NHAL_PIN_LOW) ? NHAL_PIN_LOW : NHAL_PIN_HIGH;
+}
+
+uint64_t Dht11Sim::TimestampUs()
+{
+    counters_.timestamp_us++;
+    now_us_ += config_.call_cost_us;
+    return now_us_;
+}
+
+uint32_t Dht11Sim::TimestampMs()
+{
+    counters_.timestamp_ms++;
+    now_us_ += config_.call_cost_us;
+    return (uint32_t)(now_us_ / 1000u);
+}
+
+void Dht11Sim::DelayUs(uint32_t us)
+{
+    counters_.delay_us++;
+    AdvanceUs(us);
+}
+
+void Dht11Sim::DelayMs(uint32_t ms)
+{
+    counters_.delay_ms++;
+    AdvanceMs(ms);
+}
+
+void Dht11Sim::HostLevelChanged()
+{
+    bool low = host_output_ && host_state_ == NHAL_PIN_LOW;
+
+    if (low && !host_low_) {
+        host_low_since_us_ = now_us_;
+        // Pulling the line low aborts whatever the sensor was sending
+        waveform_.clear();
+        cursor_ = 0;
+        sensor_level_ = NHAL_PIN_HIGH;
+    } else if (!low && host_low_ && now_us_ - host_low_since_us_ >= config_.min_start_low_us) {
+        ScheduleFrame(now_us_);
+    }
+    host_low_ = low;
+}
+
+void Dht11Sim::ScheduleFrame(uint64_t release_us)
+{
+    counters_.start_signals++;
+    if (Chance(config_.dropout_probability)) {
+        return;
+    }
+    counters_.responses++;
+
+    uint8_t bytes[DHT11_DATA_BYTES];
+    memcpy(bytes, config_.data, sizeof(config_.data));
+    bytes[DHT11_DATA_BYTES - 1] = (uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3]);
+    if (Chance(config_.corrupt_probability)) {
+        uint32_t bit = (uint32_t)(NextRandom() % DHT11_DATA_BITS);
+        bytes[bit / 8] ^= (uint8_t)(0x80u >> (bit % 8));
+    }
+
+    int marginal_bit = -1;
+    if (Chance(config_.marginal_probability)) {
+        marginal_bit = (int)(NextRandom() % DHT11_DATA_BITS);
+    }
+
+    uint64_t t = release_us + Jitter(config_.response_delay_us);
+    AddPhase(t, NHAL_PIN_LOW, DHT11_RESPONSE_LOW_US);
+    AddPhase(t, NHAL_PIN_HIGH, DHT11_RESPONSE_HIGH_US);
+
+    for (int bit = 0; bit < DHT11_DATA_BITS; bit++) {
+        bool one = (bytes[bit / 8] >> (7 - (bit % 8))) & 1;
+        uint32_t high_us = Jitter(one ? config_.one_high_us : config_.zero_high_us);
+        if (bit == marginal_bit) {
+            high_us = one ? DHT11_PULSE_THRESHOLD_US - config_.marginal_offset_us
+                          : DHT11_PULSE_THRESHOLD_US + config_.marginal_offset_us;
+        }
+
+        AddPhase(t, NHAL_PIN_LOW, config_.bit_low_us);
+        if (Chance(config_.glitch_probability) && high_us > 2 * config_.glitch_width_us) {
+            uint32_t before_us = (high_us - config_.glitch_width_us) / 2;
+            waveform_.push_back({t, NHAL_PIN_HIGH});
+            waveform_.push_back({t + before_us, NHAL_PIN_LOW});
+            waveform_.push_back({t + before_us + config_.glitch_width_us, NHAL_PIN_HIGH});
+            t += high_us;
+        } else {
+            waveform_.push_back({t, NHAL_PIN_HIGH});
+            t += high_us;
+        }
+    }
+
+    AddPhase(t, NHAL_PIN_LOW, config_.bit_low_us);
+    waveform_.push_back({t, NHAL_PIN_HIGH});
+
+    if (Chance(config_.truncate_probability)) {
+        // Cut after a random falling edge and leave the line released
+        size_t cut = 1 + (size_t)(NextRandom() % (waveform_.size() - 2));
+        if (waveform_[cut].level == NHAL_PIN_HIGH) {
+            cut++;
+        }
+        waveform_[cut].level = NHAL_PIN_HIGH;
+        waveform_.resize(cut + 1);
+    }
+}
+
+void Dht11Sim::AddPhase(uint64_t& t, nhal_pin_state_t level, uint32_t duration_us)
+{
+    waveform_.push_back({t, level});
+    t += Jitter(duration_us);
+}
+
+nhal_pin_state_t Dht11Sim::SensorLevel()
+{
+    while (cursor_ < waveform_.size() && waveform_[cursor_].time_us <= now_us_) {
+        const Transition& edge = waveform_[cursor_++];
+        if (edge.level != sensor_level_) {
+            sensor_level_ = edge.level;
+            if (edge_listener_) {
+                edge_listener_(edge.level, (uint32_t)edge.time_us);
+            }
+        }
+    }
+    return sensor_level_;
+}
+
+uint32_t Dht11Sim::Jitter(uint32_t duration_us)
+{
+    if (config_.jitter_us == 0) {
+        return duration_us;
+    }
+
+    uint32_t span = 2 * config_.jitter_us + 1;
+    int64_t jittered = (int64_t)duration_us + (int64_t)(NextRandom() % span) - (int64_t)config_.jitter_us;
+    return jittered > 1 ? (uint32_t)jittered : 1;
+}
+
+uint64_t Dht11Sim::NextRandom()
+{
+    // xorshift64*
+    rng_state_ ^= rng_state_ >> 12;
+    rng_state_ ^= rng_state_ << 25;
+    rng_state_ ^= rng_state_ >> 27;
+    return rng_state_ * 2685821657736338717ull;
+}
+
+bool Dht11Sim::Chance(double probability)
+{
+    if (probability <= 0.0) {
+        return false;
+    }
+    return (double)(NextRandom() >> 11) * (1.0 / 9007199254740992.0) < probability;
+}
+
+extern "C" {
+
+nhal_result_t nhal_pin_set_direction(struct nhal_pin_context *ctx, nhal_pin_dir_t direction, nhal_pin_pull_mode_t pull_mode)
+{
+    (void)ctx;
+    (void)pull_mode;
+    Dht11Sim::instance().SetDirection(direction);
+    return NHAL_OK;
+}
+
+nhal_result_t nhal_pin_set_state(struct nhal_pin_context *ctx, nhal_pin_state_t value)
+{
+    (void)ctx;
+    Dht11Sim::instance().SetState(value);
+    return NHAL_OK;
+}
+
+nhal_result_t nhal_pin_get_state(struct nhal_pin_context *ctx, nhal_pin_state_t *value)
+{
+    (void)ctx;
+    if (value == nullptr) {
+        return NHAL_ERR_INVALID_ARG;
+    }
+    *value = Dht11Sim::instance().GetState();
+    return NHAL_OK;
+}
+
+void nhal_delay_microseconds(uint32_t microseconds)
+{
+    Dht11Sim::instance().DelayUs(microseconds);
+}
+
+void nhal_delay_milliseconds(uint32_t milliseconds)
+{
+    Dht11Sim::instance().DelayMs(milliseconds);
+}
+
+uint32_t nhal_get_timestamp_milliseconds(void)
+{
+    return Dht11Sim::instance().TimestampMs();
+}
+
+uint64_t nhal_get_timestamp_microseconds(void)
+{
+    return Dht11Sim::instance().TimestampUs();
+}
+
+}
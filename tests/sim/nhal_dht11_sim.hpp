@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+extern "C" {
+    #include "nhal_pin_types.h"
+    #include "dht11_defs.h"
+}
+
+// Waveform and timing parameters of the simulated sensor
+struct Dht11SimConfig {
+    uint8_t data[DHT11_DATA_BYTES - 1] = {55, 0, 23, 0};  // Humidity and temperature bytes; the checksum is computed
+    uint32_t response_delay_us = 30;    // Time from the host releasing the line to the response low
+    uint32_t min_start_low_us = 18000;  // Shortest start signal the sensor answers
+    uint32_t bit_low_us = DHT11_BIT_LOW_US;        // Low phase preceding each bit
+    uint32_t zero_high_us = DHT11_BIT_0_HIGH_US;   // High phase of a '0' bit
+    uint32_t one_high_us = DHT11_BIT_1_HIGH_US;    // High phase of a '1' bit
+    uint32_t jitter_us = 0;             // Each phase is lengthened or shortened by up to this much
+    double glitch_probability = 0.0;    // Chance per bit of a short low spike inside its high phase
+    uint32_t glitch_width_us = 2;       // Width of a glitch
+    double dropout_probability = 0.0;   // Chance per transaction that the sensor does not answer
+    double truncate_probability = 0.0;  // Chance per transaction that the frame stops part way through
+    double corrupt_probability = 0.0;   // Chance per transaction that one data bit is flipped
+    double marginal_probability = 0.0;  // Chance per transaction that one bit's high phase lands just across the threshold
+    uint32_t marginal_offset_us = 3;    // How far across the threshold a marginal bit lands
+    uint32_t call_cost_us = 1;          // Virtual time consumed by every pin or timestamp call
+    uint64_t start_time_us = 10000000;  // Virtual clock at reset
+    uint64_t seed = 1;                  // Seed of the deterministic random generator
+};
+
+// HAL calls made against the simulator
+struct Dht11SimCounters {
+    uint64_t set_direction;
+    uint64_t set_state;
+    uint64_t get_state;
+    uint64_t timestamp_us;
+    uint64_t timestamp_ms;
+    uint64_t delay_us;
+    uint64_t delay_ms;
+    uint64_t start_signals;             // Start signals the sensor answered or dropped
+    uint64_t responses;                 // Start signals the sensor answered
+    uint64_t bulk_samples;              // Line samples taken by SampleLine(), not HAL calls
+
+    uint64_t TotalCalls() const {
+        return set_direction + set_state + get_state + timestamp_us + timestamp_ms + delay_us + delay_ms;
+    }
+};
+
+// Simulated nhal_pin / nhal_common backend with a virtual clock.
+// Time only moves when the driver calls into the HAL, so results are
+// deterministic for a given config and seed. Single threaded.
+class Dht11Sim {
+public:
+    using EdgeListener = std::function<void(nhal_pin_state_t level, uint32_t timestamp_us)>;
+
+    static Dht11Sim& instance();
+
+    void Reset(const Dht11SimConfig& config = Dht11SimConfig());
+    Dht11SimConfig& config() { return config_; }
+    const Dht11SimCounters& counters() const { return counters_; }
+    void ResetCounters();
+
+    uint64_t now_us() const { return now_us_; }
+    void AdvanceUs(uint64_t us);
+    void AdvanceMs(uint32_t ms) { AdvanceUs((uint64_t)ms * 1000u); }
+
+    // Called for every sensor-driven edge as virtual time passes it, like a pin interrupt
+    void SetEdgeListener(EdgeListener listener) { edge_listener_ = listener; }
+
+    // Samples the line at a fixed rate like a timer-triggered DMA transfer,
+    // packing sample i into bit (i % 32) of samples[i / 32]
+    void SampleLine(uint32_t *samples, size_t count, uint32_t period_us);
+
+    // HAL entry points
+    void SetDirection(nhal_pin_dir_t direction);
+    void SetState(nhal_pin_state_t state);
+    nhal_pin_state_t GetState();
+    uint64_t TimestampUs();
+    uint32_t TimestampMs();
+    void DelayUs(uint32_t us);
+    void DelayMs(uint32_t ms);
+
+private:
+    struct Transition {
+        uint64_t time_us;
+        nhal_pin_state_t level;
+    };
+
+    Dht11Sim() { Reset(); }
+
+    void HostLevelChanged();
+    void ScheduleFrame(uint64_t release_us);
+    void AddPhase(uint64_t& t, nhal_pin_state_t level, uint32_t duration_us);
+    nhal_pin_state_t SensorLevel();
+    nhal_pin_state_t LineLevel();
+    uint32_t Jitter(uint32_t duration_us);
+    uint64_t NextRandom();
+    bool Chance(double probability);
+
+    Dht11SimConfig config_;
+    Dht11SimCounters counters_;
+    uint64_t now_us_;
+    uint64_t rng_state_;
+    bool host_output_;
+    nhal_pin_state_t host_state_;
+    bool host_low_;
+    uint64_t host_low_since_us_;
+    std::vector<Transition> waveform_;
+    size_t cursor_;
+    nhal_pin_state_t sensor_level_;
+    EdgeListener edge_listener_;
+};
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+extern "C" {
+    #include "dht11_aggregate.h"
+}
+
+namespace {
+
+struct Sample {
+    uint64_t elapsed_ms;
+    dht11_reading_fixed_t reading;
+};
+
+int16_t RoundedMean(int64_t sum, int64_t count)
+{
+    return (int16_t)((sum < 0) ? -((-sum + count / 2) / count) : (sum + count / 2) / count);
+}
+
+}  // namespace
+
+class DHT11AggregateTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(dht11_aggregate_config_default(&config), DHT11_OK);
+    }
+
+    void Init() {
+        ASSERT_EQ(dht11_aggregate_init(&aggregate, &config), DHT11_OK);
+        samples.clear();
+    }
+
+    void Push(int16_t humidity_x10, int16_t temperature_x10, uint32_t time_ms) {
+        const dht11_reading_fixed_t reading = {humidity_x10, temperature_x10};
+        if (samples.empty()) {
+            first_ms = time_ms;
+        }
+        samples.push_back({(uint64_t)(uint32_t)(time_ms - first_ms), reading});
+        ASSERT_EQ(dht11_aggregate_push(&aggregate, &reading, time_ms), DHT11_OK);
+    }
+
+    // Scans every sample in the window of a level, as defined by the header
+    void ExpectMatchesReference(size_t level) {
+        uint64_t width = config.bucket_ms[level];
+        uint64_t current = samples.back().elapsed_ms / width;
+        int64_t humidity_sum = 0;
+        int64_t temperature_sum = 0;
+        uint32_t count = 0;
+        dht11_aggregate_window_t expected = {};
+
+        for (const Sample& sample : samples) {
+            if (sample.elapsed_ms / width + config.bucket_count[level] <= current) {
+                continue;
+            }
+            if (count == 0) {
+                expected.min = sample.reading;
+                expected.max = sample.reading;
+            }
+            expected.min.humidity_x10 = std::min(expected.min.humidity_x10, sample.reading.humidity_x10);
+            expected.min.temperature_x10 = std::min(expected.min.temperature_x10, sample.reading.temperature_x10);
+            expected.max.humidity_x10 = std::max(expected.max.humidity_x10, sample.reading.humidity_x10);
+            expected.max.temperature_x10 = std::max(expected.max.temperature_x10, sample.reading.temperature_x10);
+            humidity_sum += sample.reading.humidity_x10;
+            temperature_sum += sample.reading.temperature_x10;
+            count++;
+        }
+
+        dht11_aggregate_window_t window;
+        ASSERT_EQ(dht11_aggregate_query(&aggregate, level, &window), DHT11_OK);
+        ASSERT_EQ(window.count, count) << "level " << level;
+        EXPECT_EQ(window.min.humidity_x10, expected.min.humidity_x10) << "level " << level;
+        EXPECT_EQ(window.min.temperature_x10, expected.min.temperature_x10) << "level " << level;
+        EXPECT_EQ(window.max.humidity_x10, expected.max.humidity_x10) << "level " << level;
+        EXPECT_EQ(window.max.temperature_x10, expected.max.temperature_x10) << "level " << level;
+        EXPECT_EQ(window.mean.humidity_x10, RoundedMean(humidity_sum, count)) << "level " << level;
+        EXPECT_EQ(window.mean.temperature_x10, RoundedMean(temperature_sum, count)) << "level " << level;
+    }
+
+    // Random walk with mostly regular readings and the occasional long gap
+    void RunRandom(uint32_t seed, int readings, uint32_t max_gap_ms, int check_every) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> step(-15, 15);
+        std::uniform_int_distribution<uint32_t> interval(500, 20000);
+        std::uniform_int_distribution<uint32_t> gap(0, max_gap_ms);
+        std::uniform_int_distribution<int> percent(0, 99);
+        int humidity = 500;
+        int temperature = 0;
+        uint32_t time_ms = 0xFFFF0000u;  // Wraps early on
+
+        for (int i = 0; i < readings; i++) {
+            humidity = std::max(0, std::min(1000, humidity + step(rng)));
+            temperature = std::max(-400, std::min(800, temperature + step(rng)));
+            time_ms += (percent(rng) == 0) ? gap(rng) : interval(rng);
+            ASSERT_NO_FATAL_FAILURE(Push((int16_t)humidity, (int16_t)temperature, time_ms));
+
+            if (i % check_every == 0 || i == readings - 1) {
+                for (size_t level = 0; level < DHT11_AGGREGATE_LEVELS; level++) {
+                    ASSERT_NO_FATAL_FAILURE(ExpectMatchesReference(level)) << "reading " << i;
+                }
+            }
+        }
+    }
+
+    dht11_aggregate_config_t config;
+    dht11_aggregate_t aggregate;
+    std::vector<Sample> samples;
+    uint32_t first_ms = 0;
+};
+
+TEST_F(DHT11AggregateTest, ConfigDefaultMatchesDefs) {
+    EXPECT_EQ(config.bucket_ms[0], (uint32_t)DHT11_AGGREGATE_MINUTE_BUCKET_MS);
+    EXPECT_EQ(config.bucket_count[0], DHT11_AGGREGATE_MINUTE_BUCKETS);
+    EXPECT_EQ(config.bucket_ms[1], (uint32_t)DHT11_AGGREGATE_HOUR_BUCKET_MS);
+    EXPECT_EQ(config.bucket_count[1], DHT11_AGGREGATE_HOUR_BUCKETS);
+    EXPECT_EQ(config.bucket_ms[2], (uint32_t)DHT11_AGGREGATE_DAY_BUCKET_MS);
+    EXPECT_EQ(config.bucket_count[2], DHT11_AGGREGATE_DAY_BUCKETS);
+}
+
+TEST_F(DHT11AggregateTest, InvalidArguments) {
+    dht11_aggregate_window_t window;
+    const dht11_reading_fixed_t reading = {550, 230};
+    dht11_aggregate_config_t bad = config;
+
+    EXPECT_EQ(dht11_aggregate_config_default(nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_aggregate_init(nullptr, &config), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_aggregate_init(&aggregate, nullptr), DHT11_ERR_INVALID_ARG);
+
+    bad.bucket_count[1] = 1;
+    EXPECT_EQ(dht11_aggregate_init(&aggregate, &bad), DHT11_ERR_INVALID_ARG);
+    bad.bucket_count[1] = DHT11_AGGREGATE_MAX_BUCKETS + 1;
+    EXPECT_EQ(dht11_aggregate_init(&aggregate, &bad), DHT11_ERR_INVALID_ARG);
+
+    // Coarser buckets must be whole multiples of finer ones
+    bad = config;
+    bad.bucket_ms[1] = 7000;
+    EXPECT_EQ(dht11_aggregate_init(&aggregate, &bad), DHT11_ERR_INVALID_ARG);
+    bad.bucket_ms[1] = bad.bucket_ms[0];
+    EXPECT_EQ(dht11_aggregate_init(&aggregate, &bad), DHT11_ERR_INVALID_ARG);
+    bad.bucket_ms[0] = 0;
+    EXPECT_EQ(dht11_aggregate_init(&aggregate, &bad), DHT11_ERR_INVALID_ARG);
+
+    Init();
+    EXPECT_EQ(dht11_aggregate_push(nullptr, &reading, 0), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_aggregate_push(&aggregate, nullptr, 0), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_aggregate_query(nullptr, 0, &window), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_aggregate_query(&aggregate, DHT11_AGGREGATE_LEVELS, &window), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_aggregate_query(&aggregate, 0, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_aggregate_reset(nullptr), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11AggregateTest, NoDataUntilFirstReading) {
+    dht11_aggregate_window_t window;
+    Init();
+
+    EXPECT_EQ(dht11_aggregate_query(&aggregate, 0, &window), DHT11_ERR_NO_DATA);
+
+    Push(550, -35, 1000);
+    for (size_t level = 0; level < DHT11_AGGREGATE_LEVELS; level++) {
+        ASSERT_EQ(dht11_aggregate_query(&aggregate, level, &window), DHT11_OK);
+        EXPECT_EQ(window.count, 1u);
+        EXPECT_EQ(window.min.temperature_x10, -35);
+        EXPECT_EQ(window.max.temperature_x10, -35);
+        EXPECT_EQ(window.mean.humidity_x10, 550);
+    }
+
+    ASSERT_EQ(dht11_aggregate_reset(&aggregate), DHT11_OK);
+    EXPECT_EQ(dht11_aggregate_query(&aggregate, 2, &window), DHT11_ERR_NO_DATA);
+    EXPECT_EQ(aggregate.config.bucket_ms[2], config.bucket_ms[2]);
+}
+
+TEST_F(DHT11AggregateTest, OldReadingsLeaveFinerWindowsFirst) {
+    dht11_aggregate_window_t window;
+    Init();
+
+    Push(400, 100, 0);
+    Push(600, 300, 2 * 3600 * 1000);
+
+    ASSERT_EQ(dht11_aggregate_query(&aggregate, 0, &window), DHT11_OK);
+    EXPECT_EQ(window.count, 1u);
+    EXPECT_EQ(window.min.humidity_x10, 600);
+    ASSERT_EQ(dht11_aggregate_query(&aggregate, 1, &window), DHT11_OK);
+    EXPECT_EQ(window.count, 1u);
+    ASSERT_EQ(dht11_aggregate_query(&aggregate, 2, &window), DHT11_OK);
+    EXPECT_EQ(window.count, 2u);
+    EXPECT_EQ(window.min.humidity_x10, 400);
+    EXPECT_EQ(window.max.temperature_x10, 300);
+    EXPECT_EQ(window.mean.temperature_x10, 200);
+
+    // A day later only the newest reading remains anywhere
+    Push(500, 250, 26 * 3600 * 1000);
+    ASSERT_EQ(dht11_aggregate_query(&aggregate, 2, &window), DHT11_OK);
+    EXPECT_EQ(window.count, 1u);
+    EXPECT_EQ(window.min.humidity_x10, 500);
+}
+
+TEST_F(DHT11AggregateTest, SmallWindowsMatchReference) {
+    config.bucket_ms[0] = 1000;
+    config.bucket_count[0] = 4;
+    config.bucket_ms[1] = 5000;
+    config.bucket_count[1] = 3;
+    config.bucket_ms[2] = 20000;
+    config.bucket_count[2] = 5;
+    Init();
+
+    RunRandom(7, 3000, 60000, 1);
+}
+
+TEST_F(DHT11AggregateTest, DefaultWindowsMatchReferenceOverTwoDays) {
+    Init();
+
+    RunRandom(8, 17000, 3 * 3600 * 1000, 61);
+}
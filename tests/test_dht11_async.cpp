@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <vector>
+#include "nhal_common.h"
+#include "nhal_pin_mock.hpp"
+#include "nhal_common_mock.hpp"
+#include "dht11_frame_builder.hpp"
+
+extern "C" {
+    #include "dht11.h"
+}
+
+using ::testing::_;
+using ::testing::Return;
+
+class DHT11AsyncTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        memset(&handle, 0, sizeof(handle));
+        memset(&raw_data, 0, sizeof(raw_data));
+
+        mock_time_ms = 10000;
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_milliseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){
+                return mock_time_ms;
+            });
+        mock_time_us = 0;
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_microseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){
+                mock_time_us += 20;
+                return mock_time_us;
+            });
+
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_microseconds(testing::_))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](uint32_t microseconds){
+                mock_time_us += microseconds;
+            });
+
+        // The non-blocking path must never sleep for the start signal
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_milliseconds(testing::_))
+            .Times(0);
+
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_direction(testing::_, testing::_, testing::_))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly(Return(NHAL_OK));
+
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_state(testing::_, testing::_))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly(Return(NHAL_OK));
+
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_get_state(testing::_, testing::_))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([](struct nhal_pin_context * ctx, nhal_pin_state_t* state){
+                *state = NHAL_PIN_HIGH;
+                return NHAL_OK;
+            });
+
+        pin_ctx = (struct nhal_pin_context*)0x1000;
+        dht11_init(&handle, pin_ctx);
+        handle.last_reading_time_ms = 0;
+    }
+
+    void TearDown() override {
+        testing::Mock::VerifyAndClearExpectations(&NhalPinMock::instance());
+        testing::Mock::VerifyAndClearExpectations(&NhalCommonMock::instance());
+    }
+
+    void SetupAllZeroFrame() {
+        pin_script = AllZeroFramePinScript();
+        script_pos = 0;
+
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_get_state(pin_ctx, _))
+            .WillRepeatedly([this](struct nhal_pin_context* ctx, nhal_pin_state_t* state) {
+                *state = script_pos < pin_script.size() ? pin_script[script_pos++] : NHAL_PIN_HIGH;
+                return NHAL_OK;
+            });
+    }
+
+    dht11_handle_t handle;
+    struct nhal_pin_context *pin_ctx;
+    dht11_raw_data_t raw_data;
+    uint32_t mock_time_ms;
+    uint64_t mock_time_us;
+    std::vector<nhal_pin_state_t> pin_script;
+    size_t script_pos;
+};
+
+TEST_F(DHT11AsyncTest, InitLeavesStateIdle) {
+    EXPECT_EQ(handle.state, DHT11_STATE_IDLE);
+}
+
+TEST_F(DHT11AsyncTest, NullArguments) {
+    EXPECT_EQ(dht11_read_start(nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_read_poll(nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_read_result(nullptr, &raw_data), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_read_result(&handle, nullptr), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11AsyncTest, PollWithoutStartIsRejected) {
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_read_result(&handle, &raw_data), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11AsyncTest, StartTooSoon) {
+    handle.last_reading_time_ms = mock_time_ms - 500;
+
+    EXPECT_EQ(dht11_read_start(&handle), DHT11_ERR_TOO_SOON);
+    EXPECT_EQ(handle.state, DHT11_STATE_IDLE);
+}
+
+TEST_F(DHT11AsyncTest, StartWithPinError) {
+    EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_state(pin_ctx, NHAL_PIN_LOW))
+        .WillOnce(Return(NHAL_ERR_HW_FAILURE));
+
+    EXPECT_EQ(dht11_read_start(&handle), DHT11_ERR_PIN_ERROR);
+    EXPECT_EQ(handle.state, DHT11_STATE_IDLE);
+}
+
+TEST_F(DHT11AsyncTest, StartPullsLineLowAndReturnsImmediately) {
+    EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_state(pin_ctx, NHAL_PIN_LOW))
+        .WillOnce(Return(NHAL_OK));
+    EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_state(pin_ctx, NHAL_PIN_HIGH))
+        .Times(0);
+
+    EXPECT_EQ(dht11_read_start(&handle), DHT11_OK);
+    EXPECT_EQ(handle.state, DHT11_STATE_START_SIGNAL);
+    EXPECT_EQ(handle.start_signal_time_ms, mock_time_ms);
+}
+
+TEST_F(DHT11AsyncTest, PollBeforeDeadlineReturnsInProgress) {
+    ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+
+    // The line must not be released during the low phase
+    EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_state(pin_ctx, NHAL_PIN_HIGH))
+        .Times(0);
+
+    for (uint32_t step = 0; step <= DHT11_START_SIGNAL_MS; step++) {
+        EXPECT_EQ(dht11_read_poll(&handle), DHT11_ERR_IN_PROGRESS);
+        EXPECT_EQ(dht11_read_result(&handle, &raw_data), DHT11_ERR_IN_PROGRESS);
+        mock_time_ms++;
+    }
+}
+
+TEST_F(DHT11AsyncTest, StartWhileInProgressIsRejected) {
+    ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+
+    EXPECT_EQ(dht11_read_start(&handle), DHT11_ERR_IN_PROGRESS);
+    EXPECT_EQ(dht11_read_raw(&handle, &raw_data), DHT11_ERR_IN_PROGRESS);
+}
+
+TEST_F(DHT11AsyncTest, PollAfterDeadlineReportsNoResponse) {
+    ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+    mock_time_ms += DHT11_START_SIGNAL_MS + 1;
+
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_ERR_NO_RESPONSE);
+    EXPECT_EQ(handle.state, DHT11_STATE_COMPLETE);
+    EXPECT_EQ(dht11_read_result(&handle, &raw_data), DHT11_ERR_NO_RESPONSE);
+
+    // Further polls keep reporting the completed result
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_ERR_NO_RESPONSE);
+}
+
+TEST_F(DHT11AsyncTest, CompleteTransactionDeliversRawData) {
+    ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+    SetupAllZeroFrame();
+
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_ERR_IN_PROGRESS);
+    mock_time_ms += DHT11_START_SIGNAL_MS + 1;
+
+    memset(&raw_data, 0xAA, sizeof(raw_data));
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_OK);
+    EXPECT_EQ(dht11_read_result(&handle, &raw_data), DHT11_OK);
+    EXPECT_EQ(raw_data.humidity_integer, 0);
+    EXPECT_EQ(raw_data.temperature_integer, 0);
+    EXPECT_EQ(raw_data.checksum, 0);
+    EXPECT_EQ(handle.last_reading_time_ms, mock_time_ms);
+
+    // A new transaction is rate limited by the completed one
+    EXPECT_EQ(dht11_read_start(&handle), DHT11_ERR_TOO_SOON);
+}
+
+TEST_F(DHT11AsyncTest, FilterRejectionIsReported) {
+    dht11_filter_config_t config;
+    dht11_filter_t filter;
+    dht11_reading_fixed_t primed = {550, 230};
+    dht11_reading_fixed_t latest;
+    ASSERT_EQ(dht11_filter_config_default(&config), DHT11_OK);
+    config.max_humidity_step_x10 = 100;
+    ASSERT_EQ(dht11_filter_init(&filter, &config), DHT11_OK);
+    ASSERT_EQ(dht11_filter_push(&filter, &primed, &primed), DHT11_OK);
+    ASSERT_EQ(dht11_set_filter(&handle, &filter), DHT11_OK);
+
+    // The all-zero frame is a 55 %RH jump from the primed level
+    ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+    SetupAllZeroFrame();
+    mock_time_ms += DHT11_START_SIGNAL_MS + 1;
+
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_ERR_OUTLIER);
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_ERR_OUTLIER);
+    EXPECT_EQ(dht11_read_result(&handle, &raw_data), DHT11_ERR_OUTLIER);
+    EXPECT_EQ(dht11_get_latest_fixed(&handle, &latest, nullptr), DHT11_ERR_NO_DATA);
+    EXPECT_EQ(filter.rejected, 1u);
+}
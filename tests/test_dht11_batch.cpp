@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+extern "C" {
+    #include "dht11_batch.h"
+}
+
+class DHT11BatchTest : public ::testing::Test {
+protected:
+    // Random frames around the valid ranges; about a quarter fail the checksum
+    void Generate(size_t count, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> byte(0, 255);
+        std::uniform_int_distribution<int> small(0, 120);
+
+        frames.resize(count);
+        for (auto& frame : frames) {
+            frame.humidity_integer = (uint8_t)small(rng);
+            frame.humidity_decimal = (uint8_t)(byte(rng) % 10);
+            frame.temperature_integer = (uint8_t)small(rng);
+            frame.temperature_decimal = (uint8_t)(byte(rng) % 12);
+            frame.checksum = (uint8_t)(frame.humidity_integer + frame.humidity_decimal +
+                                       frame.temperature_integer + frame.temperature_decimal);
+            if (byte(rng) < 64) {
+                frame.checksum ^= (uint8_t)(1 + byte(rng) % 255);
+            }
+        }
+        Resize(count);
+    }
+
+    void Resize(size_t count) {
+        humidity.assign(count, 0);
+        temperature.assign(count, 0);
+        valid.assign(DHT11_BATCH_BITMAP_WORDS(count), 0xFFFFFFFFu);
+        out.humidity_x10 = humidity.data();
+        out.temperature_x10 = temperature.data();
+        out.valid = valid.data();
+    }
+
+    bool Valid(size_t i) const { return (valid[i / 32] >> (i % 32)) & 1u; }
+
+    // Compares every item with the single-frame conversion
+    void ExpectMatchesScalar(size_t valid_count) {
+        size_t expected_valid = 0;
+        for (size_t i = 0; i < frames.size(); i++) {
+            dht11_reading_fixed_t fixed;
+            dht11_result_t result = dht11_convert_raw_to_fixed(&frames[i], &fixed);
+
+            EXPECT_EQ(Valid(i), result == DHT11_OK) << "item " << i;
+            if (result != DHT11_ERR_CHECKSUM) {
+                EXPECT_EQ(humidity[i], fixed.humidity_x10) << "item " << i;
+                EXPECT_EQ(temperature[i], fixed.temperature_x10) << "item " << i;
+            }
+            expected_valid += result == DHT11_OK;
+        }
+        EXPECT_EQ(valid_count, expected_valid);
+    }
+
+    std::vector<dht11_raw_data_t> frames;
+    std::vector<int16_t> humidity;
+    std::vector<int16_t> temperature;
+    std::vector<uint32_t> valid;
+    dht11_batch_out_t out;
+};
+
+TEST_F(DHT11BatchTest, InvalidArguments) {
+    Resize(1);
+    dht11_raw_data_t frame = {55, 0, 23, 0, 78};
+    dht11_raw_soa_t soa = {nullptr, nullptr, nullptr, nullptr, nullptr};
+    dht11_batch_out_t no_bitmap = out;
+    no_bitmap.valid = nullptr;
+
+    EXPECT_EQ(dht11_convert_batch(nullptr, 1, &out, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_convert_batch(&frame, 1, nullptr, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_convert_batch(&frame, 1, &no_bitmap, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_convert_batch_soa(nullptr, 1, &out, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_convert_batch_soa(&soa, 1, &out, nullptr), DHT11_ERR_INVALID_ARG);
+
+    size_t valid_count = 99;
+    EXPECT_EQ(dht11_convert_batch(nullptr, 0, &out, &valid_count), DHT11_OK);
+    EXPECT_EQ(valid_count, 0u);
+    EXPECT_EQ(dht11_convert_batch_soa(&soa, 0, &out, nullptr), DHT11_OK);
+}
+
+TEST_F(DHT11BatchTest, SingleFrame) {
+    Resize(1);
+    dht11_raw_data_t frame = {55, 3, 25, 7, 90};
+    size_t valid_count = 0;
+
+    ASSERT_EQ(dht11_convert_batch(&frame, 1, &out, &valid_count), DHT11_OK);
+    EXPECT_EQ(valid_count, 1u);
+    EXPECT_EQ(valid[0], 1u);
+    EXPECT_EQ(humidity[0], 553);
+    EXPECT_EQ(temperature[0], 257);
+}
+
+TEST_F(DHT11BatchTest, MatchesScalarConversion) {
+    size_t valid_count = 0;
+    Generate(1000, 20);
+
+    ASSERT_EQ(dht11_convert_batch(frames.data(), frames.size(), &out, &valid_count), DHT11_OK);
+    ExpectMatchesScalar(valid_count);
+    // Both checksum and range failures are present
+    EXPECT_GT(valid_count, 0u);
+    EXPECT_LT(valid_count, frames.size() * 3 / 4);
+}
+
+TEST_F(DHT11BatchTest, SoaMatchesScalarConversion) {
+    size_t valid_count = 0;
+    Generate(777, 21);
+
+    std::vector<uint8_t> bytes[DHT11_DATA_BYTES];
+    for (const auto& frame : frames) {
+        bytes[0].push_back(frame.humidity_integer);
+        bytes[1].push_back(frame.humidity_decimal);
+        bytes[2].push_back(frame.temperature_integer);
+        bytes[3].push_back(frame.temperature_decimal);
+        bytes[4].push_back(frame.checksum);
+    }
+    dht11_raw_soa_t soa = {bytes[0].data(), bytes[1].data(), bytes[2].data(), bytes[3].data(), bytes[4].data()};
+
+    ASSERT_EQ(dht11_convert_batch_soa(&soa, frames.size(), &out, &valid_count), DHT11_OK);
+    ExpectMatchesScalar(valid_count);
+}
+
+TEST_F(DHT11BatchTest, BitmapTailIsCleared) {
+    size_t valid_count = 0;
+    Generate(40, 22);
+    for (auto& frame : frames) {
+        frame = {50, 0, 20, 0, 70};
+    }
+
+    ASSERT_EQ(dht11_convert_batch(frames.data(), frames.size(), &out, &valid_count), DHT11_OK);
+    EXPECT_EQ(valid_count, 40u);
+    EXPECT_EQ(valid[0], 0xFFFFFFFFu);
+    EXPECT_EQ(valid[1], 0xFFu);
+}
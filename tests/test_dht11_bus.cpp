@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <vector>
+#include "nhal_common.h"
+#include "nhal_pin_mock.hpp"
+#include "nhal_common_mock.hpp"
+
+extern "C" {
+    #include "dht11_bus.h"
+}
+
+using ::testing::_;
+using ::testing::Return;
+
+#define BUS_SENSORS 3
+
+struct BusEvent {
+    size_t index;
+    dht11_result_t result;
+    uint32_t time_ms;
+};
+
+static void RecordEvent(dht11_handle_t *handle, size_t index, dht11_result_t result,
+                        const dht11_raw_data_t *raw_data, void *user_data)
+{
+    static_cast<std::vector<BusEvent>*>(user_data)->push_back({index, result, nhal_get_timestamp_milliseconds()});
+}
+
+class DHT11BusTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_time_ms = 10000;
+        mock_time_us = 0;
+
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_milliseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){ return mock_time_ms; });
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_microseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){
+                mock_time_us += 20;
+                return mock_time_us;
+            });
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_microseconds(_))
+            .Times(testing::AnyNumber());
+
+        // The scheduler never sleeps through a start signal
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_milliseconds(_))
+            .Times(0);
+
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_direction(_, _, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly(Return(NHAL_OK));
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_state(_, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly(Return(NHAL_OK));
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_get_state(_, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([](struct nhal_pin_context* ctx, nhal_pin_state_t* state) {
+                *state = NHAL_PIN_HIGH;  // No sensor answers
+                return NHAL_OK;
+            });
+
+        for (int i = 0; i < BUS_SENSORS; i++) {
+            memset(&handles[i], 0, sizeof(handles[i]));
+            pins[i] = (struct nhal_pin_context*)(uintptr_t)(0x1000 + i);
+            dht11_init(&handles[i], pins[i]);
+            handle_ptrs[i] = &handles[i];
+        }
+        ASSERT_EQ(dht11_bus_init(&bus, handle_ptrs, BUS_SENSORS, RecordEvent, &events), DHT11_OK);
+    }
+
+    void TearDown() override {
+        testing::Mock::VerifyAndClearExpectations(&NhalPinMock::instance());
+        testing::Mock::VerifyAndClearExpectations(&NhalCommonMock::instance());
+    }
+
+    // Steps the bus every millisecond, as often as next_service_ms can ask for
+    void RunFor(uint32_t duration_ms) {
+        for (uint32_t elapsed = 0; elapsed < duration_ms; elapsed++) {
+            ASSERT_EQ(dht11_bus_process(&bus, nullptr), DHT11_OK);
+            mock_time_ms++;
+        }
+    }
+
+    dht11_bus_t bus;
+    dht11_handle_t handles[BUS_SENSORS];
+    dht11_handle_t *handle_ptrs[BUS_SENSORS];
+    struct nhal_pin_context *pins[BUS_SENSORS];
+    std::vector<BusEvent> events;
+    uint32_t mock_time_ms;
+    uint64_t mock_time_us;
+};
+
+TEST_F(DHT11BusTest, InitValidation) {
+    dht11_bus_t other;
+    dht11_handle_t *with_null[2] = {&handles[0], nullptr};
+
+    EXPECT_EQ(dht11_bus_init(nullptr, handle_ptrs, BUS_SENSORS, nullptr, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_bus_init(&other, nullptr, BUS_SENSORS, nullptr, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_bus_init(&other, handle_ptrs, 0, nullptr, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_bus_init(&other, with_null, 2, nullptr, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_bus_process(nullptr, nullptr), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11BusTest, StartsAreStaggeredIntoDataSlots) {
+    for (int i = 0; i < BUS_SENSORS; i++) {
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_state(pins[i], NHAL_PIN_LOW))
+            .WillOnce(Return(NHAL_OK));
+    }
+
+    uint32_t next_ms = 0;
+    ASSERT_EQ(dht11_bus_process(&bus, &next_ms), DHT11_OK);
+    EXPECT_EQ(handles[0].state, DHT11_STATE_START_SIGNAL);
+    EXPECT_EQ(handles[1].state, DHT11_STATE_IDLE);
+    EXPECT_EQ(next_ms, (uint32_t)DHT11_BUS_DATA_SLOT_MS);
+
+    // One more start per data slot, while the earlier start signals still run
+    uint32_t first_ms = mock_time_ms;
+    mock_time_ms++;
+    RunFor(2 * DHT11_BUS_DATA_SLOT_MS);
+    for (int i = 0; i < BUS_SENSORS; i++) {
+        EXPECT_EQ(handles[i].state, DHT11_STATE_START_SIGNAL);
+        EXPECT_EQ(handles[i].start_signal_time_ms, first_ms + (uint32_t)i * DHT11_BUS_DATA_SLOT_MS);
+    }
+    EXPECT_TRUE(events.empty());
+}
+
+TEST_F(DHT11BusTest, DataPhasesAreSerialized) {
+    RunFor(3 * DHT11_BUS_DATA_SLOT_MS + DHT11_START_SIGNAL_MS + 1);
+
+    ASSERT_EQ(events.size(), (size_t)BUS_SENSORS);
+    for (int i = 0; i < BUS_SENSORS; i++) {
+        EXPECT_EQ(events[i].index, (size_t)i);
+        EXPECT_EQ(events[i].result, DHT11_ERR_NO_RESPONSE);
+
+        // Every start signal kept its nominal length
+        EXPECT_EQ(events[i].time_ms - handles[i].start_signal_time_ms, (uint32_t)DHT11_START_SIGNAL_MS + 1);
+    }
+}
+
+TEST_F(DHT11BusTest, ShortStartSignalsKeepTheirLength) {
+    for (int i = 0; i < BUS_SENSORS; i++) {
+        handles[i].config.start_signal_ms = 1;
+    }
+
+    RunFor(3 * DHT11_BUS_DATA_SLOT_MS + 2);
+
+    ASSERT_EQ(events.size(), (size_t)BUS_SENSORS);
+    for (int i = 0; i < BUS_SENSORS; i++) {
+        EXPECT_EQ(events[i].time_ms - handles[i].start_signal_time_ms, 2u) << "sensor " << i;
+    }
+}
+
+TEST_F(DHT11BusTest, FailedSensorsBackOff) {
+    RunFor(3 * DHT11_BUS_DATA_SLOT_MS + DHT11_START_SIGNAL_MS + 1);
+    ASSERT_EQ(events.size(), (size_t)BUS_SENSORS);
+
+    // A dead sensor waits out its sampling period before the next attempt
+    uint32_t next_ms = 0;
+    ASSERT_EQ(dht11_bus_process(&bus, &next_ms), DHT11_OK);
+    EXPECT_GE(next_ms, (uint32_t)DHT11_MIN_SAMPLING_PERIOD_MS - 3 * DHT11_BUS_DATA_SLOT_MS);
+    for (int i = 0; i < BUS_SENSORS; i++) {
+        EXPECT_FALSE(dht11_is_ready_for_reading(&handles[i]));
+    }
+
+    RunFor(DHT11_MIN_SAMPLING_PERIOD_MS - 3 * DHT11_BUS_DATA_SLOT_MS - 1);
+    EXPECT_EQ(events.size(), (size_t)BUS_SENSORS);
+
+    RunFor(3 * DHT11_BUS_DATA_SLOT_MS + DHT11_START_SIGNAL_MS + 1);
+    EXPECT_EQ(events.size(), (size_t)2 * BUS_SENSORS);
+}
+
+TEST_F(DHT11BusTest, HonorsLastReadingTime) {
+    handles[1].last_reading_time_ms = mock_time_ms - 500;
+
+    // Started only once, at the end
+    EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_state(pins[1], NHAL_PIN_LOW))
+        .Times(1);
+
+    ASSERT_EQ(dht11_bus_process(&bus, nullptr), DHT11_OK);
+    EXPECT_EQ(handles[0].state, DHT11_STATE_START_SIGNAL);
+    EXPECT_EQ(handles[1].state, DHT11_STATE_IDLE);
+
+    // Sensor 1 becomes due once its sampling period has elapsed, and then
+    // waits for the data slot sensor 2 took in the meantime
+    mock_time_ms += 1499;
+    uint32_t next_ms = 0;
+    for (int step = 0; step < BUS_SENSORS; step++) {
+        dht11_bus_process(&bus, &next_ms);
+    }
+    EXPECT_EQ(handles[1].state, DHT11_STATE_IDLE);
+    EXPECT_EQ(handles[2].state, DHT11_STATE_START_SIGNAL);
+    EXPECT_EQ(next_ms, (uint32_t)DHT11_BUS_DATA_SLOT_MS);
+
+    mock_time_ms += DHT11_BUS_DATA_SLOT_MS;
+    dht11_bus_process(&bus, nullptr);
+    EXPECT_EQ(handles[1].state, DHT11_STATE_START_SIGNAL);
+}
+
+TEST_F(DHT11BusTest, StartFailureIsReported) {
+    EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_state(pins[2], NHAL_PIN_LOW))
+        .WillOnce(Return(NHAL_ERR_HW_FAILURE));
+
+    RunFor(2 * DHT11_BUS_DATA_SLOT_MS + 1);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].index, 2u);
+    EXPECT_EQ(events[0].result, DHT11_ERR_PIN_ERROR);
+
+    // The failed sensor is not retried within its sampling period
+    RunFor(100);
+    for (const BusEvent& event : events) {
+        EXPECT_TRUE(event.index != 2u || event.result == DHT11_ERR_PIN_ERROR);
+    }
+    EXPECT_EQ(handles[2].state, DHT11_STATE_IDLE);
+}
+
+TEST_F(DHT11BusTest, StatsCountTransactionsNotBusPolls) {
+    dht11_stats_t stats = {};
+    dht11_stats_counters_t counters;
+    ASSERT_EQ(dht11_set_stats(&handles[0], &stats), DHT11_OK);
+
+    RunFor(500);
+
+    ASSERT_EQ(dht11_stats_snapshot(&stats, &counters), DHT11_OK);
+    EXPECT_EQ(counters.results[DHT11_ERR_NO_RESPONSE], 1u);
+    EXPECT_EQ(counters.results[DHT11_ERR_TOO_SOON], 0u);
+    EXPECT_EQ(counters.results[DHT11_ERR_IN_PROGRESS], 0u);
+}
+
+TEST_F(DHT11BusTest, InterruptHandlesDoNotBlockPollingHandles) {
+    dht11_set_acquisition_mode(&handles[0], DHT11_ACQ_INTERRUPT);
+    dht11_set_acquisition_mode(&handles[1], DHT11_ACQ_INTERRUPT);
+
+    ASSERT_EQ(dht11_bus_process(&bus, nullptr), DHT11_OK);
+    mock_time_ms += DHT11_START_SIGNAL_MS + 1;
+    ASSERT_EQ(dht11_bus_process(&bus, nullptr), DHT11_OK);
+
+    // Both interrupt handles released their line and the polling one ran its data phase
+    EXPECT_EQ(handles[0].state, DHT11_STATE_RECEIVING);
+    EXPECT_EQ(handles[1].state, DHT11_STATE_RECEIVING);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].index, 2u);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <vector>
+#include "nhal_common.h"
+#include "nhal_pin_mock.hpp"
+#include "nhal_common_mock.hpp"
+#include "dht11_frame_builder.hpp"
+
+extern "C" {
+    #include "dht11.h"
+}
+
+using ::testing::_;
+using ::testing::Return;
+
+class DHT11CacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        memset(&handle, 0, sizeof(handle));
+        memset(&reading, 0, sizeof(reading));
+        mock_time_ms = 10000;
+        mock_time_us = 0;
+        bus_transactions = 0;
+        script_pos = 0;
+
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_milliseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){ return mock_time_ms; });
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_microseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){
+                mock_time_us += 20;
+                return mock_time_us;
+            });
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_microseconds(_))
+            .Times(testing::AnyNumber());
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_milliseconds(_))
+            .Times(testing::AnyNumber());
+
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_direction(_, _, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly(Return(NHAL_OK));
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_state(_, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](struct nhal_pin_context* ctx, nhal_pin_state_t state) {
+                if (state == NHAL_PIN_LOW) {
+                    bus_transactions++;
+                    script_pos = 0;
+                }
+                return NHAL_OK;
+            });
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_get_state(_, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](struct nhal_pin_context* ctx, nhal_pin_state_t* state) {
+                *state = script_pos < pin_script.size() ? pin_script[script_pos++] : NHAL_PIN_HIGH;
+                return NHAL_OK;
+            });
+
+        pin_script = AllZeroFramePinScript();
+        pin_ctx = (struct nhal_pin_context*)0x1000;
+        dht11_init(&handle, pin_ctx);
+    }
+
+    void TearDown() override {
+        testing::Mock::VerifyAndClearExpectations(&NhalPinMock::instance());
+        testing::Mock::VerifyAndClearExpectations(&NhalCommonMock::instance());
+    }
+
+    dht11_handle_t handle;
+    struct nhal_pin_context *pin_ctx;
+    dht11_reading_t reading;
+    dht11_cache_info_t info;
+    uint32_t mock_time_ms;
+    uint64_t mock_time_us;
+    int bus_transactions;
+    std::vector<nhal_pin_state_t> pin_script;
+    size_t script_pos;
+};
+
+TEST_F(DHT11CacheTest, DisabledByDefault) {
+    EXPECT_EQ(handle.cache_max_age_ms, 0u);
+
+    ASSERT_EQ(dht11_read(&handle, &reading), DHT11_OK);
+    mock_time_ms += 100;
+    EXPECT_EQ(dht11_read(&handle, &reading), DHT11_ERR_TOO_SOON);
+    EXPECT_EQ(bus_transactions, 1);
+}
+
+TEST_F(DHT11CacheTest, InvalidArguments) {
+    EXPECT_EQ(dht11_set_cache_max_age(nullptr, 1000), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_read_cached(nullptr, &reading, &info), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_read_cached(&handle, nullptr, &info), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11CacheTest, ServesCachedValueWithinMaxAge) {
+    ASSERT_EQ(dht11_set_cache_max_age(&handle, 5000), DHT11_OK);
+
+    ASSERT_EQ(dht11_read_cached(&handle, &reading, &info), DHT11_OK);
+    EXPECT_EQ(info.age_ms, 0u);
+    EXPECT_TRUE(info.fresh);
+
+    for (int i = 0; i < 100; i++) {
+        mock_time_ms += 10;
+        ASSERT_EQ(dht11_read(&handle, &reading), DHT11_OK);
+    }
+
+    ASSERT_EQ(dht11_read_cached(&handle, &reading, &info), DHT11_OK);
+    EXPECT_EQ(info.age_ms, 1000u);
+    EXPECT_TRUE(info.fresh);
+    EXPECT_EQ(bus_transactions, 1);
+}
+
+TEST_F(DHT11CacheTest, RefreshesOnceMaxAgeExpires) {
+    ASSERT_EQ(dht11_set_cache_max_age(&handle, 3000), DHT11_OK);
+    ASSERT_EQ(dht11_read(&handle, &reading), DHT11_OK);
+
+    mock_time_ms += 3001;
+    ASSERT_EQ(dht11_read_cached(&handle, &reading, &info), DHT11_OK);
+    EXPECT_EQ(info.age_ms, 0u);
+    EXPECT_TRUE(info.fresh);
+    EXPECT_EQ(bus_transactions, 2);
+    EXPECT_EQ(handle.cached_time_ms, mock_time_ms);
+}
+
+TEST_F(DHT11CacheTest, StaleValueWhileSamplingPeriodRuns) {
+    ASSERT_EQ(dht11_set_cache_max_age(&handle, 500), DHT11_OK);
+    ASSERT_EQ(dht11_read(&handle, &reading), DHT11_OK);
+
+    mock_time_ms += 1500;
+    ASSERT_EQ(dht11_read_cached(&handle, &reading, &info), DHT11_OK);
+    EXPECT_EQ(info.age_ms, 1500u);
+    EXPECT_FALSE(info.fresh);
+    EXPECT_EQ(bus_transactions, 1);
+}
+
+TEST_F(DHT11CacheTest, FailedRefreshReturnsErrorAndStaleValue) {
+    ASSERT_EQ(dht11_set_cache_max_age(&handle, 1000), DHT11_OK);
+    ASSERT_EQ(dht11_read(&handle, &reading), DHT11_OK);
+
+    pin_script.clear();  // Sensor stops answering
+    mock_time_ms += 2500;
+    reading.humidity = -1.0f;
+
+    EXPECT_EQ(dht11_read_cached(&handle, &reading, &info), DHT11_ERR_NO_RESPONSE);
+    EXPECT_FLOAT_EQ(reading.humidity, 0.0f);
+    EXPECT_EQ(info.age_ms, 2500u);
+    EXPECT_FALSE(info.fresh);
+}
+
+TEST_F(DHT11CacheTest, NoCachedValueReportsError) {
+    ASSERT_EQ(dht11_set_cache_max_age(&handle, 1000), DHT11_OK);
+    handle.last_reading_time_ms = mock_time_ms;
+
+    EXPECT_EQ(dht11_read_cached(&handle, &reading, &info), DHT11_ERR_TOO_SOON);
+}
+
+TEST_F(DHT11CacheTest, NonBlockingTransactionsRefreshCache) {
+    ASSERT_EQ(dht11_set_cache_max_age(&handle, 5000), DHT11_OK);
+
+    ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+    mock_time_ms += DHT11_START_SIGNAL_MS + 1;
+    ASSERT_EQ(dht11_read_poll(&handle), DHT11_OK);
+    EXPECT_TRUE(handle.cache_valid);
+
+    ASSERT_EQ(dht11_read_cached(&handle, &reading, &info), DHT11_OK);
+    EXPECT_EQ(bus_transactions, 1);
+}
+
+TEST_F(DHT11CacheTest, DisablingClearsCache) {
+    ASSERT_EQ(dht11_set_cache_max_age(&handle, 5000), DHT11_OK);
+    ASSERT_EQ(dht11_read(&handle, &reading), DHT11_OK);
+
+    ASSERT_EQ(dht11_set_cache_max_age(&handle, 0), DHT11_OK);
+    EXPECT_FALSE(handle.cache_valid);
+    EXPECT_EQ(dht11_read(&handle, &reading), DHT11_ERR_TOO_SOON);
+}
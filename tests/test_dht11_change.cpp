@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <random>
+
+extern "C" {
+    #include "dht11_change.h"
+}
+
+class DHT11ChangeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(dht11_change_config_default(&config), DHT11_OK);
+    }
+
+    void Init() {
+        ASSERT_EQ(dht11_change_init(&change, &config), DHT11_OK);
+    }
+
+    uint8_t Push(int16_t humidity_x10, int16_t temperature_x10, uint32_t time_ms) {
+        const dht11_reading_fixed_t reading = {humidity_x10, temperature_x10};
+        uint8_t events = 0xFF;
+        EXPECT_EQ(dht11_change_push(&change, &reading, time_ms, &events), DHT11_OK);
+        return events;
+    }
+
+    dht11_change_config_t config;
+    dht11_change_t change;
+};
+
+TEST_F(DHT11ChangeTest, ConfigDefaultMatchesDefs) {
+    EXPECT_EQ(config.humidity_band_x10, DHT11_CHANGE_HUMIDITY_BAND_X10);
+    EXPECT_EQ(config.temperature_band_x10, DHT11_CHANGE_TEMPERATURE_BAND_X10);
+    EXPECT_EQ(config.heartbeat_ms, (uint32_t)DHT11_CHANGE_HEARTBEAT_MS);
+}
+
+TEST_F(DHT11ChangeTest, InvalidArguments) {
+    const dht11_reading_fixed_t reading = {550, 230};
+    dht11_change_config_t bad = config;
+    uint8_t events;
+
+    EXPECT_EQ(dht11_change_config_default(nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_change_init(nullptr, &config), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_change_init(&change, nullptr), DHT11_ERR_INVALID_ARG);
+    bad.humidity_band_x10 = -1;
+    EXPECT_EQ(dht11_change_init(&change, &bad), DHT11_ERR_INVALID_ARG);
+    bad = config;
+    bad.temperature_band_x10 = -1;
+    EXPECT_EQ(dht11_change_init(&change, &bad), DHT11_ERR_INVALID_ARG);
+
+    Init();
+    EXPECT_EQ(dht11_change_push(nullptr, &reading, 0, &events), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_change_push(&change, nullptr, 0, &events), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_change_push(&change, &reading, 0, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_change_reset(nullptr), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11ChangeTest, FirstReadingIsEmitted) {
+    Init();
+
+    EXPECT_EQ(Push(550, 230, 1000), DHT11_CHANGE_FIRST);
+    EXPECT_EQ(Push(550, 230, 3000), 0u);
+    EXPECT_EQ(change.emitted_count, 1u);
+    EXPECT_EQ(change.suppressed_count, 1u);
+
+    // After a reset the next reading is emitted again, whatever it is
+    ASSERT_EQ(dht11_change_reset(&change), DHT11_OK);
+    EXPECT_EQ(change.emitted_count, 0u);
+    EXPECT_EQ(change.config.heartbeat_ms, config.heartbeat_ms);
+    EXPECT_EQ(Push(550, 230, 5000), DHT11_CHANGE_FIRST);
+}
+
+TEST_F(DHT11ChangeTest, EmitsOnlyPastTheBand) {
+    config.humidity_band_x10 = 20;
+    config.temperature_band_x10 = 5;
+    config.heartbeat_ms = 0;
+    Init();
+
+    Push(500, 200, 0);
+    EXPECT_EQ(Push(520, 205, 2000), 0u);
+    EXPECT_EQ(Push(480, 195, 4000), 0u);
+    EXPECT_EQ(Push(521, 200, 6000), DHT11_CHANGE_HUMIDITY);
+    EXPECT_EQ(Push(521, 194, 8000), DHT11_CHANGE_TEMPERATURE);
+    EXPECT_EQ(Push(400, 300, 10000), DHT11_CHANGE_HUMIDITY | DHT11_CHANGE_TEMPERATURE);
+    EXPECT_EQ(change.emitted.humidity_x10, 400);
+    EXPECT_EQ(change.emitted.temperature_x10, 300);
+}
+
+TEST_F(DHT11ChangeTest, WobbleInsideBandIsSuppressedButDriftIsNot) {
+    config.heartbeat_ms = 0;
+    Init();
+
+    Push(500, 200, 0);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(Push((int16_t)(500 + ((i & 1) ? 10 : -10)), 200, (uint32_t)(i + 1) * 2000), 0u) << "reading " << i;
+    }
+
+    // Steps smaller than the band add up against the last emitted reading
+    EXPECT_EQ(Push(505, 200, 300000), 0u);
+    EXPECT_EQ(Push(510, 200, 302000), 0u);
+    EXPECT_EQ(Push(515, 200, 304000), DHT11_CHANGE_HUMIDITY);
+    EXPECT_EQ(change.suppressed_count, 102u);
+    EXPECT_EQ(change.emitted_count, 2u);
+}
+
+TEST_F(DHT11ChangeTest, ZeroBandEmitsOnAnyChange) {
+    config.humidity_band_x10 = 0;
+    config.temperature_band_x10 = 0;
+    Init();
+
+    Push(500, 200, 0);
+    EXPECT_EQ(Push(500, 200, 2000), 0u);
+    EXPECT_EQ(Push(500, 201, 4000), DHT11_CHANGE_TEMPERATURE);
+    EXPECT_EQ(Push(499, 201, 6000), DHT11_CHANGE_HUMIDITY);
+}
+
+TEST_F(DHT11ChangeTest, HeartbeatEmitsAfterSilence) {
+    config.heartbeat_ms = 10000;
+    Init();
+
+    Push(500, 200, 0xFFFFF000u);   // Heartbeat spans the timestamp wrap
+    uint32_t time_ms = 0xFFFFF000u;
+    for (int i = 0; i < 4; i++) {
+        time_ms += 2000;
+        EXPECT_EQ(Push(500, 200, time_ms), 0u) << "reading " << i;
+    }
+    time_ms += 2000;
+    EXPECT_EQ(Push(500, 200, time_ms), DHT11_CHANGE_HEARTBEAT);
+
+    // A change restarts the silence interval and is not counted as a heartbeat
+    time_ms += 6000;
+    EXPECT_EQ(Push(600, 200, time_ms), DHT11_CHANGE_HUMIDITY);
+    time_ms += 6000;
+    EXPECT_EQ(Push(600, 200, time_ms), 0u);
+    time_ms += 6000;
+    EXPECT_EQ(Push(700, 200, time_ms), DHT11_CHANGE_HUMIDITY | DHT11_CHANGE_HEARTBEAT);
+
+    EXPECT_EQ(change.emitted_count, 4u);
+    EXPECT_EQ(change.heartbeat_count, 1u);
+    EXPECT_EQ(change.suppressed_count, 5u);
+}
+
+TEST_F(DHT11ChangeTest, EmittedReadingsStayWithinBandOfEveryReading) {
+    config.humidity_band_x10 = 15;
+    config.temperature_band_x10 = 5;
+    config.heartbeat_ms = 60000;
+    Init();
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> step(-3, 3);
+    int humidity = 500;
+    int temperature = 200;
+    uint32_t time_ms = 0;
+    uint32_t emitted_time_ms = 0;
+    dht11_reading_fixed_t emitted = {0, 0};
+
+    for (int i = 0; i < 10000; i++) {
+        humidity += step(rng);
+        temperature += step(rng);
+        time_ms += 2000;
+        uint8_t events = Push((int16_t)humidity, (int16_t)temperature, time_ms);
+
+        if (events != 0) {
+            emitted = {(int16_t)humidity, (int16_t)temperature};
+            emitted_time_ms = time_ms;
+        }
+        // What the receiver last saw is never further off than the bands
+        ASSERT_LE(std::abs(humidity - emitted.humidity_x10), config.humidity_band_x10) << "reading " << i;
+        ASSERT_LE(std::abs(temperature - emitted.temperature_x10), config.temperature_band_x10) << "reading " << i;
+        ASSERT_LT(time_ms - emitted_time_ms, config.heartbeat_ms) << "reading " << i;
+    }
+
+    EXPECT_EQ(change.emitted_count + change.suppressed_count, 10000u);
+    EXPECT_GT(change.suppressed_count, change.emitted_count);
+}
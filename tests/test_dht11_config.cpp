@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include "nhal_dht11_sim.hpp"
+
+extern "C" {
+    #include "dht11.h"
+}
+
+class DHT11ConfigTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Dht11Sim::instance().Reset();
+        memset(&handle, 0, sizeof(handle));
+        ASSERT_EQ(dht11_config_default(&config), DHT11_OK);
+    }
+
+    void Init() {
+        ASSERT_EQ(dht11_init_ex(&handle, (struct nhal_pin_context*)0x1000, &config), DHT11_OK);
+    }
+
+    Dht11SimConfig& sim() { return Dht11Sim::instance().config(); }
+
+    dht11_handle_t handle;
+    dht11_config_t config;
+};
+
+TEST_F(DHT11ConfigTest, ShorterSamplingPeriod) {
+    dht11_reading_t reading;
+    config.min_sampling_period_ms = 500;
+    Init();
+
+    Dht11Sim::instance().AdvanceMs(500);
+    ASSERT_EQ(dht11_read(&handle, &reading), DHT11_OK);
+    Dht11Sim::instance().AdvanceMs(400);
+    EXPECT_EQ(dht11_read(&handle, &reading), DHT11_ERR_TOO_SOON);
+    Dht11Sim::instance().AdvanceMs(100);
+    EXPECT_EQ(dht11_read(&handle, &reading), DHT11_OK);
+}
+
+TEST_F(DHT11ConfigTest, LongerStartSignalForSlowSensor) {
+    dht11_reading_t reading;
+    sim().min_start_low_us = 25000;
+
+    Init();
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    EXPECT_EQ(dht11_read(&handle, &reading), DHT11_ERR_NO_RESPONSE);
+
+    config.start_signal_ms = 25;
+    Init();
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    EXPECT_EQ(dht11_read(&handle, &reading), DHT11_OK);
+}
+
+TEST_F(DHT11ConfigTest, StartSignalAppliesToNonBlockingReads) {
+    dht11_result_t result = DHT11_ERR_IN_PROGRESS;
+    sim().min_start_low_us = 25000;
+    config.start_signal_ms = 25;
+    Init();
+
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+    Dht11Sim::instance().AdvanceMs(20);
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_ERR_IN_PROGRESS);
+    for (int i = 0; i < 20 && result == DHT11_ERR_IN_PROGRESS; i++) {
+        Dht11Sim::instance().AdvanceMs(1);
+        result = dht11_read_poll(&handle);
+    }
+    EXPECT_EQ(result, DHT11_OK);
+}
+
+TEST_F(DHT11ConfigTest, FastFailResponseTimeout) {
+    dht11_reading_t reading;
+    sim().dropout_probability = 1.0;
+    config.response_timeout_us = 50;
+    Init();
+
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    uint64_t before_us = Dht11Sim::instance().now_us();
+    EXPECT_EQ(dht11_read(&handle, &reading), DHT11_ERR_NO_RESPONSE);
+    uint64_t elapsed_us = Dht11Sim::instance().now_us() - before_us;
+
+    // Start signal, host high time and the response timeout, plus call overhead
+    EXPECT_LT(elapsed_us, DHT11_START_SIGNAL_MS * 1000u + DHT11_START_SIGNAL_HIGH_US + 50u + 30u);
+}
+
+TEST_F(DHT11ConfigTest, ThresholdForSlowSensor) {
+    dht11_reading_t reading;
+    sim().zero_high_us = 44;
+    sim().one_high_us = 90;
+    config.bit_threshold_us = 66;
+    config.bit_high_timeout_us = 150;
+    Init();
+
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    ASSERT_EQ(dht11_read(&handle, &reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 55.0f);
+
+    // Disabling adaptation returns to the configured threshold
+    uint8_t threshold_us = 0;
+    ASSERT_EQ(dht11_set_adaptive_threshold(&handle, false), DHT11_OK);
+    ASSERT_EQ(dht11_get_bit_threshold(&handle, &threshold_us), DHT11_OK);
+    EXPECT_EQ(threshold_us, 66);
+}
+
+TEST_F(DHT11ConfigTest, NarrowerValidationRange) {
+    dht11_reading_t reading;
+    config.temperature_max_x10 = 200;
+    Init();
+
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    EXPECT_EQ(dht11_read(&handle, &reading), DHT11_ERR_INVALID_DATA);
+
+    // The free conversion function keeps the default range
+    dht11_raw_data_t raw_data = {55, 0, 23, 0, 78};
+    EXPECT_EQ(dht11_convert_raw_to_reading(&raw_data, &reading), DHT11_OK);
+}
+
+TEST_F(DHT11ConfigTest, ConfigForVariant) {
+    ASSERT_EQ(dht11_config_for_variant(&config, &dht11_variant_dht22), DHT11_OK);
+    EXPECT_EQ(config.variant, &dht11_variant_dht22);
+    EXPECT_EQ(config.start_signal_ms, 1u);
+    EXPECT_EQ(config.min_sampling_period_ms, 1000u);
+    EXPECT_EQ(config.response_timeout_us, (uint32_t)DHT11_RESPONSE_TIMEOUT_US);
+
+    EXPECT_EQ(dht11_config_for_variant(nullptr, &dht11_variant_dht22), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_config_for_variant(&config, nullptr), DHT11_ERR_INVALID_ARG);
+
+    config.variant = nullptr;
+    EXPECT_EQ(dht11_init_ex(&handle, (struct nhal_pin_context*)0x1000, &config), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11ConfigTest, Dht22ReadsAtTwiceTheRate) {
+    dht11_reading_t reading;
+    // -10.1 C and 65.2 %RH
+    const uint8_t frame[4] = {0x02, 0x8C, 0x80, 0x65};
+    memcpy(sim().data, frame, sizeof(frame));
+    sim().min_start_low_us = 800;
+    ASSERT_EQ(dht11_config_for_variant(&config, &dht11_variant_dht22), DHT11_OK);
+    Init();
+
+    uint64_t before_us = Dht11Sim::instance().now_us();
+    for (int i = 0; i < 10; i++) {
+        Dht11Sim::instance().AdvanceMs(1000);
+        ASSERT_EQ(dht11_read(&handle, &reading), DHT11_OK) << "read " << i;
+        EXPECT_FLOAT_EQ(reading.humidity, 65.2f);
+        EXPECT_FLOAT_EQ(reading.temperature, -10.1f);
+    }
+
+    // The short start signal keeps each transaction well below 18 ms
+    uint64_t busy_us = Dht11Sim::instance().now_us() - before_us - 10 * 1000000ull;
+    EXPECT_LT(busy_us, 10 * 8000ull);
+}
+
+TEST_F(DHT11ConfigTest, Dht22FixedPointRead) {
+    dht11_reading_fixed_t reading;
+    dht11_cache_info_t info;
+    const uint8_t frame[4] = {0x02, 0x8C, 0x80, 0x65};
+    memcpy(sim().data, frame, sizeof(frame));
+    sim().min_start_low_us = 800;
+    ASSERT_EQ(dht11_config_for_variant(&config, &dht11_variant_dht22), DHT11_OK);
+    Init();
+    ASSERT_EQ(dht11_set_cache_max_age(&handle, 100), DHT11_OK);
+
+    Dht11Sim::instance().AdvanceMs(1000);
+    ASSERT_EQ(dht11_read_fixed(&handle, &reading), DHT11_OK);
+    EXPECT_EQ(reading.humidity_x10, 652);
+    EXPECT_EQ(reading.temperature_x10, -101);
+
+    // Too soon for the bus, so the cache hands back the same reading
+    Dht11Sim::instance().AdvanceMs(200);
+    reading.humidity_x10 = 0;
+    ASSERT_EQ(dht11_read_cached_fixed(&handle, &reading, &info), DHT11_OK);
+    EXPECT_FALSE(info.fresh);
+    EXPECT_EQ(reading.humidity_x10, 652);
+
+    EXPECT_EQ(dht11_read_fixed(nullptr, &reading), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_read_fixed(&handle, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_read_cached_fixed(&handle, nullptr, &info), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11ConfigTest, Dht11DecodingMisreadsDht22Frames) {
+    dht11_reading_t reading;
+    const uint8_t frame[4] = {0x02, 0x8C, 0x80, 0x65};
+    memcpy(sim().data, frame, sizeof(frame));
+    Init();
+
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    EXPECT_EQ(dht11_read(&handle, &reading), DHT11_ERR_INVALID_DATA);
+}
+
+TEST_F(DHT11ConfigTest, Dht22NonBlockingRead) {
+    dht11_raw_data_t raw_data;
+    dht11_reading_t reading;
+    dht11_result_t result = DHT11_ERR_IN_PROGRESS;
+    const uint8_t frame[4] = {0x01, 0xF4, 0x00, 0xFA};
+    memcpy(sim().data, frame, sizeof(frame));
+    sim().min_start_low_us = 800;
+    ASSERT_EQ(dht11_config_for_variant(&config, &dht11_variant_dht22), DHT11_OK);
+    Init();
+
+    Dht11Sim::instance().AdvanceMs(1000);
+    ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+    for (int i = 0; i < 10 && result == DHT11_ERR_IN_PROGRESS; i++) {
+        Dht11Sim::instance().AdvanceMs(1);
+        result = dht11_read_poll(&handle);
+    }
+
+    ASSERT_EQ(result, DHT11_OK);
+    ASSERT_EQ(dht11_read_result(&handle, &raw_data), DHT11_OK);
+    ASSERT_EQ(dht11_convert_raw_variant(handle.config.variant, &raw_data, &reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 50.0f);
+    EXPECT_FLOAT_EQ(reading.temperature, 25.0f);
+}
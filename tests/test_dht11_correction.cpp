@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "nhal_dht11_sim.hpp"
+
+extern "C" {
+    #include "dht11.h"
+}
+
+class DHT11CorrectionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Dht11Sim::instance().Reset();
+        memset(&handle, 0, sizeof(handle));
+        memset(&stats, 0, sizeof(stats));
+        ASSERT_EQ(dht11_init(&handle, (struct nhal_pin_context*)0x1000), DHT11_OK);
+    }
+
+    Dht11SimConfig& config() { return Dht11Sim::instance().config(); }
+
+    dht11_result_t ReadNext(dht11_reading_t *reading) {
+        Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+        return dht11_read(&handle, reading);
+    }
+
+    bool Corrected() {
+        bool corrected = false;
+        EXPECT_EQ(dht11_get_frame_corrected(&handle, &corrected), DHT11_OK);
+        return corrected;
+    }
+
+    dht11_handle_t handle;
+    dht11_stats_t stats;
+};
+
+TEST_F(DHT11CorrectionTest, InvalidArguments) {
+    bool corrected;
+
+    EXPECT_EQ(dht11_set_error_correction(NULL, true), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_get_frame_corrected(NULL, &corrected), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_get_frame_corrected(&handle, NULL), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11CorrectionTest, DisabledByDefault) {
+    dht11_reading_t reading;
+    config().marginal_probability = 1.0;
+
+    EXPECT_EQ(ReadNext(&reading), DHT11_ERR_CHECKSUM);
+    EXPECT_FALSE(Corrected());
+}
+
+TEST_F(DHT11CorrectionTest, CleanFrameIsNotFlagged) {
+    dht11_reading_t reading;
+    ASSERT_EQ(dht11_set_error_correction(&handle, true), DHT11_OK);
+
+    ASSERT_EQ(ReadNext(&reading), DHT11_OK);
+    EXPECT_FALSE(Corrected());
+}
+
+TEST_F(DHT11CorrectionTest, RepairsMarginalBit) {
+    dht11_reading_t reading;
+    config().marginal_probability = 1.0;
+    config().seed = 99;
+    ASSERT_EQ(dht11_set_error_correction(&handle, true), DHT11_OK);
+
+    for (int i = 0; i < 200; i++) {
+        ASSERT_EQ(ReadNext(&reading), DHT11_OK) << "read " << i;
+        EXPECT_TRUE(Corrected());
+        EXPECT_FLOAT_EQ(reading.humidity, 55.0f);
+        EXPECT_FLOAT_EQ(reading.temperature, 23.0f);
+    }
+}
+
+TEST_F(DHT11CorrectionTest, RepairsMarginalBitFromEdges) {
+    dht11_raw_data_t raw_data;
+    dht11_result_t result = DHT11_ERR_IN_PROGRESS;
+    config().marginal_probability = 1.0;
+    config().response_delay_us = 60;
+    Dht11Sim::instance().SetEdgeListener([this](nhal_pin_state_t level, uint32_t timestamp_us) {
+        dht11_on_edge(&handle, level, timestamp_us);
+    });
+    ASSERT_EQ(dht11_set_acquisition_mode(&handle, DHT11_ACQ_INTERRUPT), DHT11_OK);
+    ASSERT_EQ(dht11_set_error_correction(&handle, true), DHT11_OK);
+
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+    for (int i = 0; i < 10000 && result == DHT11_ERR_IN_PROGRESS; i++) {
+        Dht11Sim::instance().AdvanceUs(10);
+        result = dht11_read_poll(&handle);
+    }
+
+    ASSERT_EQ(result, DHT11_OK);
+    ASSERT_EQ(dht11_read_result(&handle, &raw_data), DHT11_OK);
+    EXPECT_TRUE(Corrected());
+    EXPECT_EQ(raw_data.humidity_integer, 55);
+    EXPECT_EQ(raw_data.temperature_integer, 23);
+}
+
+TEST_F(DHT11CorrectionTest, ConfidentBitsAreNeverFlipped) {
+    dht11_reading_t reading;
+    // A bit flipped at the source still has a clean pulse width
+    config().corrupt_probability = 1.0;
+    ASSERT_EQ(dht11_set_error_correction(&handle, true), DHT11_OK);
+
+    EXPECT_EQ(ReadNext(&reading), DHT11_ERR_CHECKSUM);
+    EXPECT_FALSE(Corrected());
+}
+
+TEST_F(DHT11CorrectionTest, StatsReportRecoveryRate) {
+    dht11_reading_t reading;
+    dht11_stats_counters_t counters;
+    ASSERT_EQ(dht11_set_stats(&handle, &stats), DHT11_OK);
+    ASSERT_EQ(dht11_set_error_correction(&handle, true), DHT11_OK);
+
+    config().marginal_probability = 1.0;
+    ASSERT_EQ(ReadNext(&reading), DHT11_OK);
+    ASSERT_EQ(ReadNext(&reading), DHT11_OK);
+    config().marginal_probability = 0.0;
+    config().corrupt_probability = 1.0;
+    ASSERT_EQ(ReadNext(&reading), DHT11_ERR_CHECKSUM);
+    config().corrupt_probability = 0.0;
+    ASSERT_EQ(ReadNext(&reading), DHT11_OK);
+
+    ASSERT_EQ(dht11_stats_snapshot(&stats, &counters), DHT11_OK);
+    EXPECT_EQ(counters.corrections_attempted, 3u);
+    EXPECT_EQ(counters.corrections_succeeded, 2u);
+    EXPECT_EQ(counters.results[DHT11_OK], 3u);
+    EXPECT_EQ(counters.results[DHT11_ERR_CHECKSUM], 1u);
+}
+
+TEST_F(DHT11CorrectionTest, LoadTestRecoversMostMarginalFrames) {
+    dht11_reading_t reading;
+    int ok = 0;
+    config().jitter_us = 3;
+    config().marginal_probability = 0.2;
+    config().seed = 4242;
+    ASSERT_EQ(dht11_set_error_correction(&handle, true), DHT11_OK);
+
+    for (int i = 0; i < 2000; i++) {
+        if (ReadNext(&reading) == DHT11_OK) {
+            ok++;
+        }
+    }
+    EXPECT_GT(ok, 2000 * 99 / 100);
+}
@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "nhal_common.h"
+#include "nhal_pin_mock.hpp"
+#include "nhal_common_mock.hpp"
+#include "dht11_frame_builder.hpp"
+
+extern "C" {
+    #include "dht11.h"
+}
+
+using ::testing::_;
+using ::testing::Return;
+
+class DHT11EdgeDecodeTest : public ::testing::Test {
+protected:
+    dht11_raw_data_t raw_data;
+};
+
+TEST_F(DHT11EdgeDecodeTest, FrameHasExpectedEdgeCount) {
+    const uint8_t bytes[DHT11_DATA_BYTES] = {55, 0, 25, 0, 80};
+    EXPECT_EQ(BuildFrameEdges(bytes, 0).size(), (size_t)DHT11_FRAME_EDGES);
+}
+
+TEST_F(DHT11EdgeDecodeTest, DecodesValidFrame) {
+    const uint8_t bytes[DHT11_DATA_BYTES] = {55, 3, 25, 7, 90};
+    std::vector<uint32_t> edges = BuildFrameEdges(bytes, 1000);
+
+    ASSERT_EQ(dht11_decode_edges(edges.data(), edges.size(), &raw_data), DHT11_OK);
+    EXPECT_EQ(raw_data.humidity_integer, 55);
+    EXPECT_EQ(raw_data.humidity_decimal, 3);
+    EXPECT_EQ(raw_data.temperature_integer, 25);
+    EXPECT_EQ(raw_data.temperature_decimal, 7);
+    EXPECT_EQ(raw_data.checksum, 90);
+}
+
+TEST_F(DHT11EdgeDecodeTest, DecodesAcrossTimestampWraparound) {
+    const uint8_t bytes[DHT11_DATA_BYTES] = {0xFF, 0x00, 0xAA, 0x55, 0xFE};
+    std::vector<uint32_t> edges = BuildFrameEdges(bytes, 0xFFFFFF00u);
+
+    ASSERT_EQ(dht11_decode_edges(edges.data(), edges.size(), &raw_data), DHT11_OK);
+    EXPECT_EQ(raw_data.humidity_integer, 0xFF);
+    EXPECT_EQ(raw_data.temperature_integer, 0xAA);
+    EXPECT_EQ(raw_data.temperature_decimal, 0x55);
+}
+
+TEST_F(DHT11EdgeDecodeTest, DecodesWithoutFinalReleaseEdge) {
+    const uint8_t bytes[DHT11_DATA_BYTES] = {40, 0, 20, 0, 60};
+    std::vector<uint32_t> edges = BuildFrameEdges(bytes, 0);
+
+    EXPECT_EQ(dht11_decode_edges(edges.data(), edges.size() - 1, &raw_data), DHT11_OK);
+    EXPECT_EQ(dht11_decode_edges(edges.data(), edges.size() - 2, &raw_data), DHT11_ERR_TIMEOUT);
+}
+
+TEST_F(DHT11EdgeDecodeTest, ChecksumMismatch) {
+    const uint8_t bytes[DHT11_DATA_BYTES] = {55, 0, 25, 0, 81};
+    std::vector<uint32_t> edges = BuildFrameEdges(bytes, 0);
+
+    EXPECT_EQ(dht11_decode_edges(edges.data(), edges.size(), &raw_data), DHT11_ERR_CHECKSUM);
+    EXPECT_EQ(raw_data.checksum, 81);
+}
+
+TEST_F(DHT11EdgeDecodeTest, TruncatedFrames) {
+    const uint8_t bytes[DHT11_DATA_BYTES] = {55, 0, 25, 0, 80};
+    std::vector<uint32_t> edges = BuildFrameEdges(bytes, 0);
+
+    EXPECT_EQ(dht11_decode_edges(edges.data(), 0, &raw_data), DHT11_ERR_NO_RESPONSE);
+    EXPECT_EQ(dht11_decode_edges(edges.data(), 1, &raw_data), DHT11_ERR_NO_RESPONSE);
+    EXPECT_EQ(dht11_decode_edges(edges.data(), 40, &raw_data), DHT11_ERR_TIMEOUT);
+}
+
+TEST_F(DHT11EdgeDecodeTest, NullArguments) {
+    uint32_t edges[DHT11_FRAME_EDGES] = {0};
+
+    EXPECT_EQ(dht11_decode_edges(nullptr, DHT11_FRAME_EDGES, &raw_data), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_decode_edges(edges, DHT11_FRAME_EDGES, nullptr), DHT11_ERR_INVALID_ARG);
+}
+
+class DHT11EdgeCaptureTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        memset(&handle, 0, sizeof(handle));
+        mock_time_us = 0;
+        frame_active = false;
+
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_milliseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly(Return(5000));
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_microseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){
+                mock_time_us += 3;  // Cost of one timestamp read
+                return mock_time_us;
+            });
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_microseconds(_))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](uint32_t microseconds){ mock_time_us += microseconds; });
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_milliseconds(_))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](uint32_t milliseconds){ mock_time_us += milliseconds * 1000; });
+
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_state(_, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly(Return(NHAL_OK));
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_direction(_, _, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly(Return(NHAL_OK));
+
+        // The sensor starts answering shortly after the line is released
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_direction(_, NHAL_PIN_DIR_INPUT, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](struct nhal_pin_context* ctx, nhal_pin_dir_t dir, nhal_pin_pull_mode_t pull) {
+                if (frame_active) {
+                    waveform = BuildFrameEdges(frame_bytes, (uint32_t)mock_time_us + 30);
+                }
+                return NHAL_OK;
+            });
+
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_get_state(_, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](struct nhal_pin_context* ctx, nhal_pin_state_t* state) {
+                mock_time_us += 2;  // Cost of one pin read
+                size_t passed = 0;
+                while (passed < waveform.size() && waveform[passed] <= mock_time_us) {
+                    passed++;
+                }
+                *state = (passed % 2) ? NHAL_PIN_LOW : NHAL_PIN_HIGH;
+                return NHAL_OK;
+            });
+
+        pin_ctx = (struct nhal_pin_context*)0x1000;
+        dht11_init(&handle, pin_ctx);
+    }
+
+    void TearDown() override {
+        testing::Mock::VerifyAndClearExpectations(&NhalPinMock::instance());
+        testing::Mock::VerifyAndClearExpectations(&NhalCommonMock::instance());
+    }
+
+    void SetFrame(uint8_t hi, uint8_t hd, uint8_t ti, uint8_t td) {
+        frame_bytes[0] = hi;
+        frame_bytes[1] = hd;
+        frame_bytes[2] = ti;
+        frame_bytes[3] = td;
+        frame_bytes[4] = (uint8_t)(hi + hd + ti + td);
+        frame_active = true;
+    }
+
+    dht11_handle_t handle;
+    struct nhal_pin_context *pin_ctx;
+    uint64_t mock_time_us;
+    bool frame_active;
+    uint8_t frame_bytes[DHT11_DATA_BYTES];
+    std::vector<uint32_t> waveform;
+};
+
+TEST_F(DHT11EdgeCaptureTest, CapturesAndDecodesFrame) {
+    uint32_t edges[DHT11_FRAME_EDGES];
+    size_t edge_count = 0;
+    dht11_raw_data_t raw_data;
+    SetFrame(48, 0, 23, 0);
+
+    ASSERT_EQ(dht11_read_edges(&handle, edges, DHT11_FRAME_EDGES, &edge_count), DHT11_OK);
+    EXPECT_EQ(edge_count, (size_t)DHT11_FRAME_EDGES);
+    EXPECT_EQ(handle.last_reading_time_ms, 5000u);
+
+    ASSERT_EQ(dht11_decode_edges(edges, edge_count, &raw_data), DHT11_OK);
+    EXPECT_EQ(raw_data.humidity_integer, 48);
+    EXPECT_EQ(raw_data.temperature_integer, 23);
+}
+
+TEST_F(DHT11EdgeCaptureTest, NoResponseWhenLineStaysHigh) {
+    uint32_t edges[DHT11_FRAME_EDGES];
+    size_t edge_count = 1;
+
+    EXPECT_EQ(dht11_read_edges(&handle, edges, DHT11_FRAME_EDGES, &edge_count), DHT11_ERR_NO_RESPONSE);
+    EXPECT_EQ(edge_count, 0u);
+    EXPECT_EQ(handle.last_reading_time_ms, 0u);
+}
+
+TEST_F(DHT11EdgeCaptureTest, StalledTimestampSourceIsBoundedByPollLimit) {
+    uint32_t edges[DHT11_FRAME_EDGES];
+    size_t edge_count = 1;
+    int polls = 0;
+
+    EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_microseconds())
+        .WillRepeatedly(Return(500));
+    EXPECT_CALL(NhalPinMock::instance(), nhal_pin_get_state(_, _))
+        .WillRepeatedly([&polls](struct nhal_pin_context* ctx, nhal_pin_state_t* state) {
+            polls++;
+            *state = NHAL_PIN_HIGH;
+            return NHAL_OK;
+        });
+
+    EXPECT_EQ(dht11_read_edges(&handle, edges, DHT11_FRAME_EDGES, &edge_count), DHT11_ERR_TIMEOUT);
+    EXPECT_EQ(edge_count, 0u);
+    EXPECT_EQ(polls, DHT11_WAIT_MAX_POLLS);
+}
+
+TEST_F(DHT11EdgeCaptureTest, PinErrorDuringCapture) {
+    uint32_t edges[DHT11_FRAME_EDGES];
+    size_t edge_count = 0;
+
+    EXPECT_CALL(NhalPinMock::instance(), nhal_pin_get_state(_, _))
+        .WillOnce(Return(NHAL_ERR_HW_FAILURE));
+
+    EXPECT_EQ(dht11_read_edges(&handle, edges, DHT11_FRAME_EDGES, &edge_count), DHT11_ERR_PIN_ERROR);
+}
+
+TEST_F(DHT11EdgeCaptureTest, InvalidArguments) {
+    uint32_t edges[DHT11_FRAME_EDGES];
+    size_t edge_count = 0;
+
+    EXPECT_EQ(dht11_read_edges(nullptr, edges, DHT11_FRAME_EDGES, &edge_count), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_read_edges(&handle, nullptr, DHT11_FRAME_EDGES, &edge_count), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_read_edges(&handle, edges, DHT11_FRAME_EDGES, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_read_edges(&handle, edges, DHT11_FRAME_EDGES - 1, &edge_count), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11EdgeCaptureTest, TooSoonAfterLastReading) {
+    uint32_t edges[DHT11_FRAME_EDGES];
+    size_t edge_count = 0;
+    handle.last_reading_time_ms = 4000;
+
+    EXPECT_EQ(dht11_read_edges(&handle, edges, DHT11_FRAME_EDGES, &edge_count), DHT11_ERR_TOO_SOON);
+}
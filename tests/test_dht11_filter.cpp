@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <vector>
+#include "nhal_dht11_sim.hpp"
+
+extern "C" {
+    #include "dht11.h"
+}
+
+class DHT11FilterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(dht11_filter_config_default(&config), DHT11_OK);
+        // Stages are enabled one at a time by the tests
+        config.max_humidity_step_x10 = 0;
+        config.max_temperature_step_x10 = 0;
+        config.median_window = 1;
+        config.ema_shift = 0;
+    }
+
+    void Init() {
+        ASSERT_EQ(dht11_filter_init(&filter, &config), DHT11_OK);
+    }
+
+    dht11_result_t Push(int16_t humidity_x10, int16_t temperature_x10) {
+        const dht11_reading_fixed_t reading = {humidity_x10, temperature_x10};
+        return dht11_filter_push(&filter, &reading, &filtered);
+    }
+
+    dht11_filter_config_t config;
+    dht11_filter_t filter;
+    dht11_reading_fixed_t filtered;
+};
+
+TEST_F(DHT11FilterTest, ConfigDefaultMatchesDefs) {
+    ASSERT_EQ(dht11_filter_config_default(&config), DHT11_OK);
+    EXPECT_EQ(config.max_humidity_step_x10, DHT11_FILTER_HUMIDITY_STEP_X10);
+    EXPECT_EQ(config.max_temperature_step_x10, DHT11_FILTER_TEMPERATURE_STEP_X10);
+    EXPECT_EQ(config.max_rejections, DHT11_FILTER_MAX_REJECTIONS);
+    EXPECT_EQ(config.median_window, DHT11_FILTER_MEDIAN_WINDOW);
+    EXPECT_EQ(config.ema_shift, DHT11_FILTER_EMA_SHIFT);
+    EXPECT_EQ(dht11_filter_init(&filter, &config), DHT11_OK);
+}
+
+TEST_F(DHT11FilterTest, InvalidArguments) {
+    dht11_filter_config_t bad = config;
+    const dht11_reading_fixed_t reading = {550, 230};
+
+    EXPECT_EQ(dht11_filter_config_default(nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_filter_init(nullptr, &config), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_filter_init(&filter, nullptr), DHT11_ERR_INVALID_ARG);
+
+    bad.median_window = 4;
+    EXPECT_EQ(dht11_filter_init(&filter, &bad), DHT11_ERR_INVALID_ARG);
+    bad.median_window = DHT11_FILTER_MEDIAN_MAX + 2;
+    EXPECT_EQ(dht11_filter_init(&filter, &bad), DHT11_ERR_INVALID_ARG);
+    bad.median_window = 0;
+    EXPECT_EQ(dht11_filter_init(&filter, &bad), DHT11_ERR_INVALID_ARG);
+
+    bad = config;
+    bad.max_temperature_step_x10 = 10;
+    bad.max_rejections = 0;
+    EXPECT_EQ(dht11_filter_init(&filter, &bad), DHT11_ERR_INVALID_ARG);
+
+    bad = config;
+    bad.max_humidity_step_x10 = -1;
+    EXPECT_EQ(dht11_filter_init(&filter, &bad), DHT11_ERR_INVALID_ARG);
+
+    bad = config;
+    bad.ema_shift = 16;
+    EXPECT_EQ(dht11_filter_init(&filter, &bad), DHT11_ERR_INVALID_ARG);
+
+    Init();
+    EXPECT_EQ(dht11_filter_push(nullptr, &reading, &filtered), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_filter_push(&filter, nullptr, &filtered), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_filter_push(&filter, &reading, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_filter_reset(nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_set_filter(nullptr, &filter), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11FilterTest, DisabledStagesPassThrough) {
+    Init();
+
+    for (int16_t value = -400; value <= 800; value += 37) {
+        ASSERT_EQ(Push((int16_t)(value + 400), value), DHT11_OK);
+        EXPECT_EQ(filtered.humidity_x10, value + 400);
+        EXPECT_EQ(filtered.temperature_x10, value);
+    }
+    EXPECT_EQ(filter.rejected, 0u);
+}
+
+TEST_F(DHT11FilterTest, MedianRemovesOneCountFlicker) {
+    config.median_window = 3;
+    Init();
+
+    const int16_t input[] = {230, 240, 230, 230, 240, 230, 240, 240, 230, 240};
+    const int16_t expected[] = {230, 230, 230, 230, 230, 230, 240, 240, 240, 240};
+    for (size_t i = 0; i < sizeof(input) / sizeof(input[0]); i++) {
+        ASSERT_EQ(Push(550, input[i]), DHT11_OK);
+        EXPECT_EQ(filtered.temperature_x10, expected[i]) << "reading " << i;
+    }
+}
+
+TEST_F(DHT11FilterTest, MedianMatchesReference) {
+    std::mt19937 rng(21);
+    std::uniform_int_distribution<int> value(-400, 800);
+
+    for (uint8_t window = 3; window <= DHT11_FILTER_MEDIAN_MAX; window += 2) {
+        config.median_window = window;
+        Init();
+        std::deque<int16_t> history;
+
+        for (int i = 0; i < 500; i++) {
+            int16_t temperature = (int16_t)value(rng);
+            history.push_back(temperature);
+            if (history.size() > window) {
+                history.pop_front();
+            }
+            std::vector<int16_t> sorted(history.begin(), history.end());
+            std::sort(sorted.begin(), sorted.end());
+
+            ASSERT_EQ(Push(500, temperature), DHT11_OK);
+            ASSERT_EQ(filtered.temperature_x10, sorted[(sorted.size() - 1) / 2]) << "window " << (int)window << " reading " << i;
+        }
+    }
+}
+
+TEST_F(DHT11FilterTest, AverageConvergesOnNegativeSteps) {
+    config.ema_shift = 2;
+    Init();
+
+    ASSERT_EQ(Push(500, 0), DHT11_OK);
+    EXPECT_EQ(filtered.temperature_x10, 0);
+
+    // A quarter of the remaining distance per reading
+    ASSERT_EQ(Push(500, -100), DHT11_OK);
+    EXPECT_EQ(filtered.temperature_x10, -25);
+    ASSERT_EQ(Push(500, -100), DHT11_OK);
+    EXPECT_EQ(filtered.temperature_x10, -44);
+
+    for (int i = 0; i < 40; i++) {
+        ASSERT_EQ(Push(500, -100), DHT11_OK);
+    }
+    EXPECT_EQ(filtered.temperature_x10, -100);
+    EXPECT_EQ(filtered.humidity_x10, 500);
+}
+
+TEST_F(DHT11FilterTest, RejectsSpikeInEitherChannel) {
+    config.max_humidity_step_x10 = 100;
+    config.max_temperature_step_x10 = 50;
+    Init();
+
+    ASSERT_EQ(Push(550, 230), DHT11_OK);
+
+    filtered = {-1, -1};
+    EXPECT_EQ(Push(900, 230), DHT11_ERR_OUTLIER);
+    EXPECT_EQ(filtered.humidity_x10, -1);
+    EXPECT_EQ(Push(550, 150), DHT11_ERR_OUTLIER);
+
+    // Steps within the limits pass
+    ASSERT_EQ(Push(640, 270), DHT11_OK);
+    EXPECT_EQ(filtered.humidity_x10, 640);
+    EXPECT_EQ(filter.accepted, 2u);
+    EXPECT_EQ(filter.rejected, 2u);
+}
+
+TEST_F(DHT11FilterTest, PersistentStepIsAccepted) {
+    config.max_temperature_step_x10 = 50;
+    config.max_rejections = 3;
+    Init();
+
+    ASSERT_EQ(Push(550, 230), DHT11_OK);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(Push(550, 300), DHT11_ERR_OUTLIER) << "reading " << i;
+    }
+    ASSERT_EQ(Push(550, 300), DHT11_OK);
+    EXPECT_EQ(filtered.temperature_x10, 300);
+
+    // The new level is the reference from now on
+    ASSERT_EQ(Push(550, 310), DHT11_OK);
+    EXPECT_EQ(Push(550, 230), DHT11_ERR_OUTLIER);
+}
+
+TEST_F(DHT11FilterTest, ResetKeepsConfig) {
+    config.max_temperature_step_x10 = 50;
+    config.median_window = 3;
+    Init();
+
+    ASSERT_EQ(Push(550, 230), DHT11_OK);
+    ASSERT_EQ(dht11_filter_reset(&filter), DHT11_OK);
+    EXPECT_EQ(filter.config.median_window, 3);
+    EXPECT_EQ(filter.accepted, 0u);
+
+    // The first reading after a reset is never an outlier
+    ASSERT_EQ(Push(550, 400), DHT11_OK);
+    EXPECT_EQ(filtered.temperature_x10, 400);
+}
+
+TEST_F(DHT11FilterTest, HandlePublishesFilteredReadings) {
+    dht11_handle_t handle;
+    dht11_reading_t reading;
+    config.max_humidity_step_x10 = 100;
+    config.median_window = 3;
+    Init();
+
+    Dht11Sim::instance().Reset();
+    memset(&handle, 0, sizeof(handle));
+    ASSERT_EQ(dht11_init(&handle, (struct nhal_pin_context*)0x1000), DHT11_OK);
+    ASSERT_EQ(dht11_set_filter(&handle, &filter), DHT11_OK);
+
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    ASSERT_EQ(dht11_read(&handle, &reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 55.0f);
+
+    // A valid frame with a wrong humidity byte is neither returned nor published
+    Dht11Sim::instance().config().data[0] = 95;
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    EXPECT_EQ(dht11_read(&handle, &reading), DHT11_ERR_OUTLIER);
+    EXPECT_FLOAT_EQ(reading.humidity, 55.0f);
+    ASSERT_EQ(dht11_get_latest(&handle, &reading, nullptr), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 55.0f);
+
+    // A one-count flicker is smoothed by the median
+    Dht11Sim::instance().config().data[0] = 56;
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    ASSERT_EQ(dht11_read(&handle, &reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 55.0f);
+    EXPECT_EQ(filter.rejected, 1u);
+
+    ASSERT_EQ(dht11_set_filter(&handle, nullptr), DHT11_OK);
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    ASSERT_EQ(dht11_read(&handle, &reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 56.0f);
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+extern "C" {
+    #include "dht11_history.h"
+}
+
+namespace {
+
+struct Sample {
+    uint32_t time_s;
+    dht11_reading_fixed_t reading;
+};
+
+}  // namespace
+
+class DHT11HistoryTest : public ::testing::Test {
+protected:
+    void Init(size_t blocks, uint8_t step_x10) {
+        buffer.assign(blocks * DHT11_HISTORY_BLOCK_BYTES, 0xA5);
+        ASSERT_EQ(dht11_history_init(&history, buffer.data(), buffer.size(), step_x10), DHT11_OK);
+        samples.clear();
+    }
+
+    void Append(int16_t humidity_x10, int16_t temperature_x10, uint32_t time_s) {
+        const dht11_reading_fixed_t reading = {humidity_x10, temperature_x10};
+        samples.push_back({time_s, reading});
+        ASSERT_EQ(dht11_history_append(&history, &reading, time_s), DHT11_OK);
+    }
+
+    std::vector<Sample> Decode() {
+        std::vector<Sample> decoded;
+        dht11_history_iter_t iter;
+        Sample sample;
+        dht11_result_t result;
+
+        EXPECT_EQ(dht11_history_iter_init(&history, &iter), DHT11_OK);
+        while ((result = dht11_history_next(&iter, &sample.reading, &sample.time_s)) == DHT11_OK) {
+            decoded.push_back(sample);
+        }
+        EXPECT_EQ(result, DHT11_ERR_NO_DATA);
+        return decoded;
+    }
+
+    // The decoded readings must be the newest appended ones, in order
+    void ExpectSuffixOfAppended() {
+        std::vector<Sample> decoded = Decode();
+        ASSERT_FALSE(decoded.empty());
+        ASSERT_LE(decoded.size(), samples.size());
+
+        size_t first = samples.size() - decoded.size();
+        for (size_t i = 0; i < decoded.size(); i++) {
+            ASSERT_EQ(decoded[i].time_s, samples[first + i].time_s) << "reading " << i;
+            ASSERT_EQ(decoded[i].reading.humidity_x10, samples[first + i].reading.humidity_x10) << "reading " << i;
+            ASSERT_EQ(decoded[i].reading.temperature_x10, samples[first + i].reading.temperature_x10) << "reading " << i;
+        }
+    }
+
+    // Slow random walk at the sensor's resolution, read every two seconds,
+    // continuing after the last appended reading
+    void AppendRandomWalk(uint32_t seed, int readings, int step_x10) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> percent(0, 99);
+        int humidity = 500;
+        int temperature = 200;
+        uint32_t time_s = samples.empty() ? 1700000000u : samples.back().time_s;
+
+        for (int i = 0; i < readings; i++) {
+            int roll = percent(rng);
+            if (roll < 10) {
+                humidity += (roll < 5) ? step_x10 : -step_x10;
+            } else if (roll < 20) {
+                temperature += (roll < 15) ? step_x10 : -step_x10;
+            }
+            humidity = std::max(0, std::min(1000, humidity));
+            time_s += (roll == 99) ? 7 : 2;
+            ASSERT_NO_FATAL_FAILURE(Append((int16_t)humidity, (int16_t)temperature, time_s));
+        }
+    }
+
+    std::vector<uint8_t> buffer;
+    dht11_history_t history;
+    std::vector<Sample> samples;
+};
+
+TEST_F(DHT11HistoryTest, InvalidArguments) {
+    dht11_history_iter_t iter;
+    dht11_reading_fixed_t reading = {550, 230};
+    uint8_t small[DHT11_HISTORY_BLOCK_BYTES * 2 - 1];
+
+    EXPECT_EQ(dht11_history_init(nullptr, small, sizeof(small), 10), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_history_init(&history, nullptr, sizeof(small), 10), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_history_init(&history, small, sizeof(small), 10), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_history_init(&history, small, sizeof(small) + 1, 0), DHT11_ERR_INVALID_ARG);
+
+    Init(2, 10);
+    EXPECT_EQ(dht11_history_append(nullptr, &reading, 0), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_history_append(&history, nullptr, 0), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_history_iter_init(nullptr, &iter), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_history_iter_init(&history, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_history_next(nullptr, &reading, nullptr), DHT11_ERR_INVALID_ARG);
+    ASSERT_EQ(dht11_history_iter_init(&history, &iter), DHT11_OK);
+    EXPECT_EQ(dht11_history_next(&iter, nullptr, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_history_bytes_used(nullptr), 0u);
+}
+
+TEST_F(DHT11HistoryTest, EmptyHistoryHasNoReadings) {
+    dht11_history_iter_t iter;
+    dht11_reading_fixed_t reading;
+    Init(2, 10);
+
+    EXPECT_EQ(dht11_history_bytes_used(&history), 0u);
+    ASSERT_EQ(dht11_history_iter_init(&history, &iter), DHT11_OK);
+    EXPECT_EQ(dht11_history_next(&iter, &reading, nullptr), DHT11_ERR_NO_DATA);
+}
+
+TEST_F(DHT11HistoryTest, TimeMustNotGoBackwards) {
+    const dht11_reading_fixed_t reading = {550, 230};
+    Init(2, 10);
+
+    Append(550, 230, 100);
+    Append(550, 230, 100);
+    EXPECT_EQ(dht11_history_append(&history, &reading, 99), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(history.appended, 2u);
+    ExpectSuffixOfAppended();
+}
+
+TEST_F(DHT11HistoryTest, UnchangedReadingTakesOneByte) {
+    Init(2, 10);
+
+    Append(550, 230, 1000);
+    Append(560, 220, 1002);
+    size_t used = dht11_history_bytes_used(&history);
+
+    Append(560, 220, 1004);
+    EXPECT_EQ(dht11_history_bytes_used(&history), used + 1);
+    Append(590, 190, 1006);
+    EXPECT_EQ(dht11_history_bytes_used(&history), used + 2);
+    ExpectSuffixOfAppended();
+}
+
+TEST_F(DHT11HistoryTest, EscapesLargeAndOffStepDeltas) {
+    Init(4, 10);
+
+    Append(550, 230, 0);
+    Append(950, -400, 2);       // Beyond three steps
+    Append(953, -401, 4);       // Finer than the step
+    Append(0, 800, 4);          // Largest swing, no time passed
+    Append(0, 800, 70000);      // Multi-byte interval
+    Append(10, 790, 70001);
+    ExpectSuffixOfAppended();
+    EXPECT_EQ(Decode().size(), samples.size());
+}
+
+TEST_F(DHT11HistoryTest, RoundTripsDht11Resolution) {
+    Init(64, 10);
+
+    AppendRandomWalk(1, 2000, 10);
+    EXPECT_EQ(Decode().size(), samples.size());
+    ExpectSuffixOfAppended();
+}
+
+TEST_F(DHT11HistoryTest, RoundTripsDht22Resolution) {
+    Init(64, 1);
+
+    AppendRandomWalk(2, 2000, 1);
+    EXPECT_EQ(Decode().size(), samples.size());
+    ExpectSuffixOfAppended();
+}
+
+TEST_F(DHT11HistoryTest, DropsOldestBlockWhenFull) {
+    Init(4, 10);
+
+    AppendRandomWalk(3, 5000, 10);
+    EXPECT_EQ(history.used_blocks, 4u);
+    EXPECT_EQ(history.appended, 5000u);
+
+    // A whole block at a time goes, so between three and four blocks remain
+    std::vector<Sample> decoded = Decode();
+    EXPECT_LT(decoded.size(), samples.size());
+    EXPECT_GT(dht11_history_bytes_used(&history), 3u * DHT11_HISTORY_BLOCK_BYTES);
+    ExpectSuffixOfAppended();
+
+    // The ring keeps working after wrapping many times
+    AppendRandomWalk(4, 5000, 10);
+    ExpectSuffixOfAppended();
+}
+
+TEST_F(DHT11HistoryTest, CompressesSlowlyChangingReadings) {
+    Init(64, 10);
+
+    AppendRandomWalk(5, 4000, 10);
+    std::vector<Sample> decoded = Decode();
+    size_t raw_bytes = decoded.size() * (sizeof(dht11_reading_t) + sizeof(uint32_t));
+
+    EXPECT_GE(raw_bytes, 4u * dht11_history_bytes_used(&history))
+        << decoded.size() << " readings in " << dht11_history_bytes_used(&history) << " bytes";
+}
@@ -88,3 +88,80 @@ TEST_F(DHT11InitTest, MultipleInitializationsOverwritePreviousValues) {
     EXPECT_EQ(handle.pin_ctx, pin_ctx_2);
     EXPECT_EQ(handle.last_reading_time_ms, 0);  // Should be reset
 }
+
+TEST_F(DHT11InitTest, ConfigDefaultMatchesDefs) {
+    dht11_config_t config;
+
+    ASSERT_EQ(dht11_config_default(&config), DHT11_OK);
+    EXPECT_EQ(config.start_signal_ms, (uint32_t)DHT11_START_SIGNAL_MS);
+    EXPECT_EQ(config.start_signal_high_us, (uint32_t)DHT11_START_SIGNAL_HIGH_US);
+    EXPECT_EQ(config.response_timeout_us, (uint32_t)DHT11_RESPONSE_TIMEOUT_US);
+    EXPECT_EQ(config.bit_timeout_us, (uint32_t)DHT11_BIT_TIMEOUT_US);
+    EXPECT_EQ(config.bit_low_timeout_us, (uint32_t)DHT11_BIT_LOW_TIMEOUT_US);
+    EXPECT_EQ(config.bit_high_timeout_us, (uint32_t)DHT11_BIT_HIGH_TIMEOUT_US);
+    EXPECT_EQ(config.bit_threshold_us, DHT11_PULSE_THRESHOLD_US);
+    EXPECT_EQ(config.min_sampling_period_ms, (uint32_t)DHT11_MIN_SAMPLING_PERIOD_MS);
+    EXPECT_EQ(config.humidity_min_x10, DHT11_HUMIDITY_MIN_X10);
+    EXPECT_EQ(config.humidity_max_x10, DHT11_HUMIDITY_MAX_X10);
+    EXPECT_EQ(config.temperature_min_x10, DHT11_TEMPERATURE_MIN_X10);
+    EXPECT_EQ(config.temperature_max_x10, DHT11_TEMPERATURE_MAX_X10);
+
+    EXPECT_EQ(dht11_config_default(nullptr), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11InitTest, InitUsesDefaultConfig) {
+    dht11_config_t config;
+    ASSERT_EQ(dht11_config_default(&config), DHT11_OK);
+
+    ASSERT_EQ(dht11_init(&handle, pin_ctx), DHT11_OK);
+    EXPECT_EQ(memcmp(&handle.config, &config, sizeof(config)), 0);
+}
+
+TEST_F(DHT11InitTest, InitExStoresConfig) {
+    dht11_config_t config;
+    ASSERT_EQ(dht11_config_default(&config), DHT11_OK);
+    config.start_signal_ms = 20;
+    config.min_sampling_period_ms = 1000;
+    config.bit_threshold_us = 48;
+    config.temperature_min_x10 = 0;
+
+    ASSERT_EQ(dht11_init_ex(&handle, pin_ctx, &config), DHT11_OK);
+    EXPECT_EQ(handle.config.start_signal_ms, 20u);
+    EXPECT_EQ(handle.config.min_sampling_period_ms, 1000u);
+    EXPECT_EQ(handle.threshold_us, 48);
+    EXPECT_EQ(handle.config.temperature_min_x10, 0);
+}
+
+TEST_F(DHT11InitTest, InitExRejectsInvalidConfig) {
+    dht11_config_t defaults;
+    ASSERT_EQ(dht11_config_default(&defaults), DHT11_OK);
+    EXPECT_EQ(dht11_init_ex(&handle, pin_ctx, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_init_ex(nullptr, pin_ctx, &defaults), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_init_ex(&handle, nullptr, &defaults), DHT11_ERR_INVALID_ARG);
+
+    dht11_config_t config = defaults;
+    config.start_signal_ms = 0;
+    EXPECT_EQ(dht11_init_ex(&handle, pin_ctx, &config), DHT11_ERR_INVALID_ARG);
+
+    config = defaults;
+    config.response_timeout_us = 0;
+    EXPECT_EQ(dht11_init_ex(&handle, pin_ctx, &config), DHT11_ERR_INVALID_ARG);
+
+    config = defaults;
+    config.bit_threshold_us = 0;
+    EXPECT_EQ(dht11_init_ex(&handle, pin_ctx, &config), DHT11_ERR_INVALID_ARG);
+
+    config = defaults;
+    config.min_sampling_period_ms = 0;
+    EXPECT_EQ(dht11_init_ex(&handle, pin_ctx, &config), DHT11_ERR_INVALID_ARG);
+
+    config = defaults;
+    config.humidity_min_x10 = 900;
+    config.humidity_max_x10 = 100;
+    EXPECT_EQ(dht11_init_ex(&handle, pin_ctx, &config), DHT11_ERR_INVALID_ARG);
+
+    config = defaults;
+    config.temperature_min_x10 = 500;
+    config.temperature_max_x10 = -100;
+    EXPECT_EQ(dht11_init_ex(&handle, pin_ctx, &config), DHT11_ERR_INVALID_ARG);
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "nhal_common.h"
+#include "nhal_pin_mock.hpp"
+#include "nhal_common_mock.hpp"
+#include "dht11_frame_builder.hpp"
+
+extern "C" {
+    #include "dht11.h"
+}
+
+using ::testing::_;
+using ::testing::Return;
+
+class DHT11IsrTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        memset(&handle, 0, sizeof(handle));
+        mock_time_ms = 10000;
+        mock_time_us = 0;
+
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_milliseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){ return mock_time_ms.load(); });
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_microseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){ return (uint64_t)mock_time_us.load(); });
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_microseconds(_))
+            .Times(testing::AnyNumber());
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_milliseconds(_))
+            .Times(0);
+
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_direction(_, _, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly(Return(NHAL_OK));
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_state(_, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly(Return(NHAL_OK));
+
+        // Interrupt acquisition never samples the pin
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_get_state(_, _))
+            .Times(0);
+
+        pin_ctx = (struct nhal_pin_context*)0x1000;
+        dht11_init(&handle, pin_ctx);
+        dht11_set_acquisition_mode(&handle, DHT11_ACQ_INTERRUPT);
+    }
+
+    void TearDown() override {
+        testing::Mock::VerifyAndClearExpectations(&NhalPinMock::instance());
+        testing::Mock::VerifyAndClearExpectations(&NhalCommonMock::instance());
+    }
+
+    // Runs the start signal phase so the handle waits for edges
+    void BeginReceive() {
+        ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+        mock_time_ms += DHT11_START_SIGNAL_MS + 1;
+        ASSERT_EQ(dht11_read_poll(&handle), DHT11_ERR_IN_PROGRESS);
+        ASSERT_EQ(handle.state, DHT11_STATE_RECEIVING);
+    }
+
+    void PushEdges(const std::vector<uint32_t>& edges) {
+        for (size_t i = 0; i < edges.size(); i++) {
+            dht11_on_edge(&handle, (i % 2) ? NHAL_PIN_HIGH : NHAL_PIN_LOW, edges[i]);
+        }
+    }
+
+    dht11_handle_t handle;
+    struct nhal_pin_context *pin_ctx;
+    std::atomic<uint32_t> mock_time_ms;
+    std::atomic<uint32_t> mock_time_us;
+};
+
+TEST_F(DHT11IsrTest, SetAcquisitionModeValidation) {
+    EXPECT_EQ(dht11_set_acquisition_mode(nullptr, DHT11_ACQ_POLLING), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_set_acquisition_mode(&handle, (dht11_acquisition_t)7), DHT11_ERR_INVALID_ARG);
+
+    ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+    EXPECT_EQ(dht11_set_acquisition_mode(&handle, DHT11_ACQ_POLLING), DHT11_ERR_IN_PROGRESS);
+}
+
+TEST_F(DHT11IsrTest, OnEdgeWithNullHandleIsIgnored) {
+    dht11_on_edge(nullptr, NHAL_PIN_LOW, 0);
+}
+
+TEST_F(DHT11IsrTest, DecodesFrameFromQueuedEdges) {
+    const uint8_t bytes[DHT11_DATA_BYTES] = {61, 0, 24, 0, 85};
+    dht11_raw_data_t raw_data;
+    BeginReceive();
+
+    PushEdges(BuildFrameEdges(bytes, mock_time_us + 20));
+
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_OK);
+    ASSERT_EQ(dht11_read_result(&handle, &raw_data), DHT11_OK);
+    EXPECT_EQ(raw_data.humidity_integer, 61);
+    EXPECT_EQ(raw_data.temperature_integer, 24);
+    EXPECT_EQ(handle.last_reading_time_ms, mock_time_ms.load());
+}
+
+TEST_F(DHT11IsrTest, EdgesFromStartSignalAreDiscarded) {
+    const uint8_t bytes[DHT11_DATA_BYTES] = {50, 0, 20, 0, 70};
+    dht11_raw_data_t raw_data;
+
+    ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+    dht11_on_edge(&handle, NHAL_PIN_LOW, 1);
+    mock_time_ms += DHT11_START_SIGNAL_MS + 1;
+    ASSERT_EQ(dht11_read_poll(&handle), DHT11_ERR_IN_PROGRESS);
+
+    // Release of the line is seen as a rising edge before the response
+    dht11_on_edge(&handle, NHAL_PIN_HIGH, mock_time_us + 5);
+    PushEdges(BuildFrameEdges(bytes, mock_time_us + 20));
+
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_OK);
+    ASSERT_EQ(dht11_read_result(&handle, &raw_data), DHT11_OK);
+    EXPECT_EQ(raw_data.humidity_integer, 50);
+}
+
+TEST_F(DHT11IsrTest, NoEdgesTimesOutAsNoResponse) {
+    BeginReceive();
+
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_ERR_IN_PROGRESS);
+    mock_time_us += DHT11_TIMEOUT_US;
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_ERR_NO_RESPONSE);
+    EXPECT_EQ(handle.state, DHT11_STATE_COMPLETE);
+}
+
+TEST_F(DHT11IsrTest, PartialFrameTimesOut) {
+    const uint8_t bytes[DHT11_DATA_BYTES] = {50, 0, 20, 0, 70};
+    BeginReceive();
+
+    std::vector<uint32_t> edges = BuildFrameEdges(bytes, mock_time_us + 20);
+    edges.resize(30);
+    PushEdges(edges);
+
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_ERR_IN_PROGRESS);
+    mock_time_us = edges.back() + DHT11_TIMEOUT_US;
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_ERR_TIMEOUT);
+}
+
+TEST_F(DHT11IsrTest, LostEdgeIsReportedAsInvalidData) {
+    const uint8_t bytes[DHT11_DATA_BYTES] = {50, 0, 20, 0, 70};
+    BeginReceive();
+
+    std::vector<uint32_t> edges = BuildFrameEdges(bytes, mock_time_us + 20);
+    for (size_t i = 0; i < 10; i++) {
+        dht11_on_edge(&handle, (i % 2) ? NHAL_PIN_HIGH : NHAL_PIN_LOW, edges[i]);
+    }
+    dht11_on_edge(&handle, NHAL_PIN_HIGH, edges[11]);  // Falling edge 10 was lost
+
+    EXPECT_EQ(dht11_read_poll(&handle), DHT11_ERR_INVALID_DATA);
+}
+
+TEST_F(DHT11IsrTest, FullRingDropsEdges) {
+    for (uint32_t i = 0; i < DHT11_EDGE_RING_SIZE + 3; i++) {
+        dht11_on_edge(&handle, (i % 2) ? NHAL_PIN_HIGH : NHAL_PIN_LOW, i);
+    }
+
+    EXPECT_EQ(handle.edge_ring.dropped, 3);
+}
+
+TEST_F(DHT11IsrTest, ProducerThreadDeliversFrameWhileTaskPolls) {
+    const uint8_t bytes[DHT11_DATA_BYTES] = {0xA5, 0x5A, 0x0F, 0xF0, 0xFE};
+    dht11_raw_data_t raw_data;
+
+    for (int round = 0; round < 50; round++) {
+        handle.last_reading_time_ms = mock_time_ms - DHT11_MIN_SAMPLING_PERIOD_MS;
+        BeginReceive();
+
+        std::vector<uint32_t> edges = BuildFrameEdges(bytes, mock_time_us + 20);
+        std::thread producer([&]() {
+            for (size_t i = 0; i < edges.size(); i++) {
+                mock_time_us = edges[i];
+                dht11_on_edge(&handle, (i % 2) ? NHAL_PIN_HIGH : NHAL_PIN_LOW, edges[i]);
+                if (i % 8 == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        dht11_result_t result;
+        do {
+            result = dht11_read_poll(&handle);
+        } while (result == DHT11_ERR_IN_PROGRESS);
+        producer.join();
+
+        ASSERT_EQ(result, DHT11_OK) << "round " << round;
+        ASSERT_EQ(dht11_read_result(&handle, &raw_data), DHT11_OK);
+        EXPECT_EQ(raw_data.humidity_integer, 0xA5);
+        EXPECT_EQ(raw_data.humidity_decimal, 0x5A);
+        EXPECT_EQ(raw_data.temperature_integer, 0x0F);
+        EXPECT_EQ(raw_data.temperature_decimal, 0xF0);
+
+        // Drop the release edge so the next round starts clean
+        mock_time_us += 1000;
+        mock_time_ms += DHT11_MIN_SAMPLING_PERIOD_MS;
+    }
+}
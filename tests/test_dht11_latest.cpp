@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "nhal_common.h"
+#include "nhal_pin_mock.hpp"
+#include "nhal_common_mock.hpp"
+#include "dht11_frame_builder.hpp"
+
+extern "C" {
+    #include "dht11.h"
+}
+
+using ::testing::_;
+using ::testing::Return;
+
+class DHT11LatestTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        memset(&handle, 0, sizeof(handle));
+        mock_time_ms = 10000;
+        mock_time_us = 0;
+
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_milliseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){ return mock_time_ms.load(); });
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_microseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){ return (uint64_t)mock_time_us.load(); });
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_microseconds(_))
+            .Times(testing::AnyNumber());
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_milliseconds(_))
+            .Times(testing::AnyNumber());
+
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_direction(_, _, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly(Return(NHAL_OK));
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_state(_, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly(Return(NHAL_OK));
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_get_state(_, _))
+            .Times(0);
+
+        pin_ctx = (struct nhal_pin_context*)0x1000;
+        dht11_init(&handle, pin_ctx);
+        dht11_set_acquisition_mode(&handle, DHT11_ACQ_INTERRUPT);
+    }
+
+    void TearDown() override {
+        testing::Mock::VerifyAndClearExpectations(&NhalPinMock::instance());
+        testing::Mock::VerifyAndClearExpectations(&NhalCommonMock::instance());
+    }
+
+    // Runs one interrupt-driven transaction that delivers the given frame
+    dht11_result_t Acquire(uint8_t humidity, uint8_t temperature) {
+        const uint8_t bytes[DHT11_DATA_BYTES] = {
+            humidity, 0, temperature, 0, (uint8_t)(humidity + temperature)
+        };
+
+        mock_time_ms += DHT11_MIN_SAMPLING_PERIOD_MS;
+        dht11_result_t result = dht11_read_start(&handle);
+        if (result != DHT11_OK) {
+            return result;
+        }
+        mock_time_ms += DHT11_START_SIGNAL_MS + 1;
+        dht11_read_poll(&handle);
+
+        std::vector<uint32_t> edges = BuildFrameEdges(bytes, mock_time_us + 20);
+        for (size_t i = 0; i < edges.size(); i++) {
+            dht11_on_edge(&handle, (i % 2) ? NHAL_PIN_HIGH : NHAL_PIN_LOW, edges[i]);
+        }
+        mock_time_us = edges.back();
+        return dht11_read_poll(&handle);
+    }
+
+    dht11_handle_t handle;
+    struct nhal_pin_context *pin_ctx;
+    std::atomic<uint32_t> mock_time_ms;
+    std::atomic<uint32_t> mock_time_us;
+};
+
+TEST_F(DHT11LatestTest, InvalidArguments) {
+    dht11_reading_t reading;
+
+    EXPECT_EQ(dht11_get_latest(nullptr, &reading, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_get_latest(&handle, nullptr, nullptr), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11LatestTest, NoDataBeforeFirstReading) {
+    dht11_reading_t reading;
+
+    EXPECT_EQ(dht11_get_latest(&handle, &reading, nullptr), DHT11_ERR_NO_DATA);
+}
+
+TEST_F(DHT11LatestTest, PublishesEachValidatedReading) {
+    dht11_reading_t reading;
+    uint32_t time_ms = 0;
+
+    ASSERT_EQ(Acquire(55, 21), DHT11_OK);
+    ASSERT_EQ(dht11_get_latest(&handle, &reading, &time_ms), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 55.0f);
+    EXPECT_FLOAT_EQ(reading.temperature, 21.0f);
+    EXPECT_EQ(time_ms, handle.last_reading_time_ms);
+
+    ASSERT_EQ(Acquire(60, 23), DHT11_OK);
+    ASSERT_EQ(dht11_get_latest(&handle, &reading, nullptr), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 60.0f);
+    EXPECT_FLOAT_EQ(reading.temperature, 23.0f);
+}
+
+TEST_F(DHT11LatestTest, FailedReadingKeepsPreviousValue) {
+    dht11_reading_t reading;
+
+    ASSERT_EQ(Acquire(55, 21), DHT11_OK);
+    // Out of range humidity is a valid frame but not a valid reading
+    ASSERT_EQ(Acquire(120, 21), DHT11_OK);
+
+    ASSERT_EQ(dht11_get_latest(&handle, &reading, nullptr), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 55.0f);
+}
+
+TEST_F(DHT11LatestTest, FixedPointReading) {
+    dht11_reading_fixed_t fixed;
+    uint32_t time_ms = 0;
+
+    EXPECT_EQ(dht11_get_latest_fixed(&handle, &fixed, nullptr), DHT11_ERR_NO_DATA);
+    EXPECT_EQ(dht11_get_latest_fixed(nullptr, &fixed, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_get_latest_fixed(&handle, nullptr, nullptr), DHT11_ERR_INVALID_ARG);
+
+    ASSERT_EQ(Acquire(55, 21), DHT11_OK);
+    ASSERT_EQ(dht11_get_latest_fixed(&handle, &fixed, &time_ms), DHT11_OK);
+    EXPECT_EQ(fixed.humidity_x10, 550);
+    EXPECT_EQ(fixed.temperature_x10, 210);
+    EXPECT_EQ(time_ms, handle.last_reading_time_ms);
+}
+
+TEST_F(DHT11LatestTest, ConcurrentReadersNeverSeeTornReadings) {
+    const int kReaders = 4;
+    const int kPublishes = 2000;
+    std::atomic<bool> done(false);
+    std::atomic<long> torn(0);
+    std::atomic<long> reads(0);
+    std::vector<std::thread> readers;
+
+    // Humidity is always temperature + 30, so a copy mixing two publishes breaks the relation
+    ASSERT_EQ(Acquire(30, 0), DHT11_OK);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int r = 0; r < kReaders; r++) {
+        readers.emplace_back([this, &done, &torn, &reads]() {
+            long local_reads = 0;
+            uint32_t last_time_ms = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                dht11_reading_t reading;
+                uint32_t time_ms;
+                if (dht11_get_latest(&handle, &reading, &time_ms) != DHT11_OK) {
+                    continue;
+                }
+                if (reading.humidity - reading.temperature != 30.0f || time_ms < last_time_ms) {
+                    torn++;
+                }
+                last_time_ms = time_ms;
+                local_reads++;
+            }
+            reads += local_reads;
+        });
+    }
+
+    int published = 0;
+    for (int i = 1; i <= kPublishes; i++) {
+        published += Acquire((uint8_t)(30 + i % 50), (uint8_t)(i % 50)) == DHT11_OK;
+    }
+    done = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    EXPECT_EQ(published, kPublishes);
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_GT(reads.load(), 0);
+    RecordProperty("publishes", std::to_string(published));
+    RecordProperty("reads_per_second", std::to_string((long)(reads.load() / seconds)));
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include "nhal_dht11_sim.hpp"
+
+extern "C" {
+    #include "dht11.h"
+}
+
+namespace {
+
+constexpr uint32_t kPeriodUs = 2;
+constexpr size_t kSampleCount = DHT11_OVERSAMPLE_WINDOW_US / kPeriodUs;
+
+nhal_result_t SimSample(void *ctx, uint32_t *samples, size_t sample_count, uint32_t period_us)
+{
+    (void)ctx;
+    Dht11Sim::instance().SampleLine(samples, sample_count, period_us);
+    return NHAL_OK;
+}
+
+nhal_result_t FailingSample(void *ctx, uint32_t *samples, size_t sample_count, uint32_t period_us)
+{
+    (void)ctx;
+    (void)samples;
+    (void)sample_count;
+    (void)period_us;
+    return NHAL_ERR_HW_FAILURE;
+}
+
+}  // namespace
+
+class DHT11OversampleTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Dht11Sim::instance().Reset();
+        memset(&handle, 0, sizeof(handle));
+        ASSERT_EQ(dht11_init(&handle, (struct nhal_pin_context*)0x1000), DHT11_OK);
+        sampler.sample = SimSample;
+        sampler.ctx = nullptr;
+    }
+
+    Dht11SimConfig& config() { return Dht11Sim::instance().config(); }
+
+    void EnableOversampling(uint32_t period_us = kPeriodUs) {
+        ASSERT_EQ(dht11_set_sampler(&handle, &sampler, buffer, DHT11_OVERSAMPLE_WINDOW_US / period_us, period_us), DHT11_OK);
+        ASSERT_EQ(dht11_set_acquisition_mode(&handle, DHT11_ACQ_OVERSAMPLED), DHT11_OK);
+    }
+
+    dht11_result_t ReadNext(dht11_reading_t *reading) {
+        Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+        return dht11_read(&handle, reading);
+    }
+
+    int CountSuccesses(int reads) {
+        dht11_reading_t reading;
+        int ok = 0;
+        for (int i = 0; i < reads; i++) {
+            if (ReadNext(&reading) == DHT11_OK && reading.humidity == 55.0f && reading.temperature == 23.0f) {
+                ok++;
+            }
+        }
+        return ok;
+    }
+
+    dht11_handle_t handle;
+    dht11_sampler_t sampler;
+    uint32_t buffer[(DHT11_OVERSAMPLE_WINDOW_US + 31) / 32];
+};
+
+TEST_F(DHT11OversampleTest, SetSamplerValidation) {
+    dht11_sampler_t no_hook = {nullptr, nullptr};
+
+    EXPECT_EQ(dht11_set_sampler(nullptr, &sampler, buffer, kSampleCount, kPeriodUs), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_set_sampler(&handle, &no_hook, buffer, kSampleCount, kPeriodUs), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_set_sampler(&handle, &sampler, nullptr, kSampleCount, kPeriodUs), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_set_sampler(&handle, &sampler, buffer, 0, kPeriodUs), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_set_sampler(&handle, &sampler, buffer, kSampleCount, 0), DHT11_ERR_INVALID_ARG);
+
+    // The mode needs a sampler
+    EXPECT_EQ(dht11_set_acquisition_mode(&handle, DHT11_ACQ_OVERSAMPLED), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11OversampleTest, DetachingSamplerFallsBackToPolling) {
+    EnableOversampling();
+
+    ASSERT_EQ(dht11_set_sampler(&handle, nullptr, nullptr, 0, 0), DHT11_OK);
+    EXPECT_EQ(handle.acquisition, DHT11_ACQ_POLLING);
+}
+
+TEST_F(DHT11OversampleTest, DecodesCleanFrameWithoutPolling) {
+    dht11_reading_t reading;
+    EnableOversampling();
+    uint64_t polls_before = Dht11Sim::instance().counters().get_state;
+
+    ASSERT_EQ(ReadNext(&reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 55.0f);
+    EXPECT_FLOAT_EQ(reading.temperature, 23.0f);
+    EXPECT_EQ(Dht11Sim::instance().counters().get_state, polls_before);
+    EXPECT_EQ(Dht11Sim::instance().counters().bulk_samples, kSampleCount);
+}
+
+TEST_F(DHT11OversampleTest, NonBlockingReadUsesSampler) {
+    dht11_raw_data_t raw_data;
+    dht11_result_t result = DHT11_ERR_IN_PROGRESS;
+    EnableOversampling();
+
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+    for (int i = 0; i < 100 && result == DHT11_ERR_IN_PROGRESS; i++) {
+        Dht11Sim::instance().AdvanceMs(1);
+        result = dht11_read_poll(&handle);
+    }
+
+    ASSERT_EQ(result, DHT11_OK);
+    ASSERT_EQ(dht11_read_result(&handle, &raw_data), DHT11_OK);
+    EXPECT_EQ(raw_data.humidity_integer, 55);
+    EXPECT_EQ(raw_data.temperature_integer, 23);
+    EXPECT_EQ(Dht11Sim::instance().counters().bulk_samples, kSampleCount);
+}
+
+TEST_F(DHT11OversampleTest, DropoutReportsNoResponse) {
+    dht11_reading_t reading;
+    config().dropout_probability = 1.0;
+    EnableOversampling();
+
+    EXPECT_EQ(ReadNext(&reading), DHT11_ERR_NO_RESPONSE);
+}
+
+TEST_F(DHT11OversampleTest, TruncatedFrameTimesOut) {
+    dht11_reading_t reading;
+    config().truncate_probability = 1.0;
+    EnableOversampling();
+
+    for (int i = 0; i < 20; i++) {
+        dht11_result_t result = ReadNext(&reading);
+        EXPECT_TRUE(result == DHT11_ERR_TIMEOUT || result == DHT11_ERR_NO_RESPONSE) << "result " << result;
+    }
+}
+
+TEST_F(DHT11OversampleTest, SamplerFailureIsPinError) {
+    dht11_reading_t reading;
+    sampler.sample = FailingSample;
+    EnableOversampling();
+
+    EXPECT_EQ(ReadNext(&reading), DHT11_ERR_PIN_ERROR);
+}
+
+TEST_F(DHT11OversampleTest, ToleratesJitter) {
+    config().jitter_us = 6;
+    EnableOversampling();
+
+    EXPECT_EQ(CountSuccesses(200), 200);
+}
+
+TEST_F(DHT11OversampleTest, RejectsGlitchesThatBreakPolling) {
+    const int kReads = 500;
+    config().glitch_probability = 0.05;
+    config().glitch_width_us = 2;
+    config().seed = 777;
+
+    int polled_ok = CountSuccesses(kReads);
+
+    Dht11Sim::instance().Reset(config());
+    EnableOversampling();
+    int oversampled_ok = CountSuccesses(kReads);
+
+    EXPECT_LT(polled_ok, kReads * 90 / 100);
+    EXPECT_EQ(oversampled_ok, kReads);
+    RecordProperty("polled_ok", polled_ok);
+    RecordProperty("oversampled_ok", oversampled_ok);
+}
+
+TEST_F(DHT11OversampleTest, DebounceRejectsGlitchesAtFinerPeriod) {
+    // Two samples per glitch survive the vote, the debounce drops them
+    config().glitch_probability = 0.05;
+    config().glitch_width_us = 2;
+    config().seed = 31337;
+    EnableOversampling(1);
+
+    EXPECT_EQ(CountSuccesses(300), 300);
+}
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <vector>
+#include "nhal_common.h"
+#include "nhal_common_mock.hpp"
+#include "dht11_frame_builder.hpp"
+
+extern "C" {
+    #include "dht11_port.h"
+}
+
+using ::testing::_;
+
+#define PORT_SENSORS 8
+
+// Simulated GPIO port: each sensor drives its own bit from a frame waveform
+struct SimulatedPort {
+    uint64_t time_us = 0;
+    uint32_t driven_low = 0;
+    std::vector<uint32_t> waveforms[32];
+    uint32_t read_count = 0;
+    bool fail_drive = false;
+
+    uint32_t Levels() const {
+        uint32_t levels = 0xFFFFFFFFu & ~driven_low;
+        for (int bit = 0; bit < 32; bit++) {
+            size_t passed = 0;
+            while (passed < waveforms[bit].size() && waveforms[bit][passed] <= time_us) {
+                passed++;
+            }
+            if (passed % 2) {
+                levels &= ~(1u << bit);
+            }
+        }
+        return levels;
+    }
+};
+
+static nhal_result_t SimDriveLow(void *ctx, uint32_t mask)
+{
+    SimulatedPort *port = static_cast<SimulatedPort*>(ctx);
+    if (port->fail_drive) {
+        return NHAL_ERR_HW_FAILURE;
+    }
+    port->driven_low |= mask;
+    return NHAL_OK;
+}
+
+static nhal_result_t SimRelease(void *ctx, uint32_t mask)
+{
+    static_cast<SimulatedPort*>(ctx)->driven_low &= ~mask;
+    return NHAL_OK;
+}
+
+static uint32_t SimRead(void *ctx)
+{
+    SimulatedPort *port = static_cast<SimulatedPort*>(ctx);
+    port->time_us += 1;  // Cost of one port register read
+    port->read_count++;
+    return port->Levels();
+}
+
+static const dht11_port_ops_t sim_ops = {SimDriveLow, SimRelease, SimRead};
+
+class DHT11PortTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_time_ms = 10000;
+
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_milliseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){ return mock_time_ms; });
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_microseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){ return port.time_us; });
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_milliseconds(_))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](uint32_t ms){ port.time_us += ms * 1000; });
+
+        for (int i = 0; i < PORT_SENSORS; i++) {
+            pin_masks[i] = 1u << (i * 3 % 32);
+        }
+        ASSERT_EQ(dht11_port_init(&group, &sim_ops, &port, pin_masks, PORT_SENSORS), DHT11_OK);
+    }
+
+    void TearDown() override {
+        testing::Mock::VerifyAndClearExpectations(&NhalCommonMock::instance());
+    }
+
+    // Sensor i answers with humidity 40+i and temperature 20+i, each slightly offset
+    void ScheduleFrames(uint32_t release_us) {
+        for (int i = 0; i < PORT_SENSORS; i++) {
+            const uint8_t hi = (uint8_t)(40 + i), ti = (uint8_t)(20 + i);
+            const uint8_t bytes[DHT11_DATA_BYTES] = {hi, 0, ti, 0, (uint8_t)(hi + ti)};
+            int bit = i * 3 % 32;
+            port.waveforms[bit] = BuildFrameEdges(bytes, release_us + 20 + 3 * i,
+                                                  DHT11_BIT_0_HIGH_US + i % 3, DHT11_BIT_1_HIGH_US - i % 4);
+        }
+    }
+
+    SimulatedPort port;
+    dht11_port_group_t group;
+    uint32_t pin_masks[PORT_SENSORS];
+    uint32_t mock_time_ms;
+};
+
+TEST_F(DHT11PortTest, InitValidation) {
+    dht11_port_group_t other;
+    const uint32_t overlapping[2] = {0x1, 0x1};
+    const uint32_t multi_bit[1] = {0x3};
+    const dht11_port_ops_t missing_read = {SimDriveLow, SimRelease, nullptr};
+
+    EXPECT_EQ(dht11_port_init(nullptr, &sim_ops, &port, pin_masks, 1), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_port_init(&other, nullptr, &port, pin_masks, 1), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_port_init(&other, &missing_read, &port, pin_masks, 1), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_port_init(&other, &sim_ops, &port, pin_masks, 0), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_port_init(&other, &sim_ops, &port, pin_masks, DHT11_PORT_MAX_SENSORS + 1), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_port_init(&other, &sim_ops, &port, overlapping, 2), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_port_init(&other, &sim_ops, &port, multi_bit, 1), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11PortTest, SamplesAndDecodesAllSensorsInOneWindow) {
+    std::vector<dht11_port_sample_t> samples(PORT_SENSORS * DHT11_FRAME_EDGES);
+    size_t sample_count = 0;
+    dht11_raw_data_t raw[PORT_SENSORS];
+    dht11_result_t results[PORT_SENSORS];
+
+    ScheduleFrames((uint32_t)port.time_us + DHT11_START_SIGNAL_MS * 1000);
+
+    ASSERT_EQ(dht11_port_read_samples(&group, samples.data(), samples.size(), &sample_count), DHT11_OK);
+    EXPECT_GT(sample_count, (size_t)DHT11_FRAME_EDGES);
+    EXPECT_LE(sample_count, samples.size());
+
+    // One sampling loop served every sensor in about one frame time
+    EXPECT_LT(port.read_count, 6000u);
+
+    ASSERT_EQ(dht11_port_decode(&group, samples.data(), sample_count, raw, results), DHT11_OK);
+    for (int i = 0; i < PORT_SENSORS; i++) {
+        EXPECT_EQ(results[i], DHT11_OK) << "sensor " << i;
+        EXPECT_EQ(raw[i].humidity_integer, 40 + i);
+        EXPECT_EQ(raw[i].temperature_integer, 20 + i);
+    }
+}
+
+TEST_F(DHT11PortTest, SilentSensorReportsNoResponse) {
+    std::vector<dht11_port_sample_t> samples(PORT_SENSORS * DHT11_FRAME_EDGES);
+    size_t sample_count = 0;
+    dht11_raw_data_t raw[PORT_SENSORS];
+    dht11_result_t results[PORT_SENSORS];
+
+    ScheduleFrames((uint32_t)port.time_us + DHT11_START_SIGNAL_MS * 1000);
+    port.waveforms[0].clear();             // Sensor 0 never answers
+    port.waveforms[3].resize(40);  // Sensor 1 stops mid-frame
+
+    ASSERT_EQ(dht11_port_read_samples(&group, samples.data(), samples.size(), &sample_count), DHT11_OK);
+    ASSERT_EQ(dht11_port_decode(&group, samples.data(), sample_count, raw, results), DHT11_OK);
+
+    EXPECT_EQ(results[0], DHT11_ERR_NO_RESPONSE);
+    EXPECT_EQ(results[1], DHT11_ERR_TIMEOUT);
+    for (int i = 2; i < PORT_SENSORS; i++) {
+        EXPECT_EQ(results[i], DHT11_OK) << "sensor " << i;
+    }
+}
+
+TEST_F(DHT11PortTest, FrozenClockIsBoundedByPollLimit) {
+    std::vector<dht11_port_sample_t> samples(PORT_SENSORS * DHT11_FRAME_EDGES);
+    size_t sample_count = 1;
+
+    EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_microseconds())
+        .WillRepeatedly(testing::Return(500));
+
+    EXPECT_EQ(dht11_port_read_samples(&group, samples.data(), samples.size(), &sample_count), DHT11_ERR_TIMEOUT);
+    EXPECT_EQ(sample_count, 0u);
+    EXPECT_EQ(port.read_count, (uint32_t)DHT11_WAIT_MAX_POLLS);
+}
+
+TEST_F(DHT11PortTest, RateLimitedAfterWindow) {
+    dht11_port_sample_t samples[16];
+    size_t sample_count = 0;
+
+    ASSERT_EQ(dht11_port_read_samples(&group, samples, 16, &sample_count), DHT11_OK);
+    EXPECT_EQ(sample_count, 0u);
+    EXPECT_EQ(dht11_port_read_samples(&group, samples, 16, &sample_count), DHT11_ERR_TOO_SOON);
+}
+
+TEST_F(DHT11PortTest, DriveFailureIsPinError) {
+    dht11_port_sample_t samples[16];
+    size_t sample_count = 0;
+    port.fail_drive = true;
+
+    EXPECT_EQ(dht11_port_read_samples(&group, samples, 16, &sample_count), DHT11_ERR_PIN_ERROR);
+}
+
+TEST_F(DHT11PortTest, DecodeArgumentValidation) {
+    dht11_raw_data_t raw[PORT_SENSORS];
+    dht11_result_t results[PORT_SENSORS];
+
+    EXPECT_EQ(dht11_port_decode(nullptr, nullptr, 0, raw, results), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_port_decode(&group, nullptr, 5, raw, results), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_port_decode(&group, nullptr, 0, nullptr, results), DHT11_ERR_INVALID_ARG);
+    ASSERT_EQ(dht11_port_decode(&group, nullptr, 0, raw, results), DHT11_OK);
+    EXPECT_EQ(results[0], DHT11_ERR_NO_RESPONSE);
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+extern "C" {
+    #include "dht11_psychro.h"
+}
+
+namespace {
+
+// Floating-point formulas the module approximates
+double SaturationHpa(double temperature)
+{
+    return 6.112 * std::exp(17.62 * temperature / (243.12 + temperature));
+}
+
+double DewPoint(double temperature, double humidity)
+{
+    double gamma = std::log(humidity / 100.0) + 17.62 * temperature / (243.12 + temperature);
+    return 243.12 * gamma / (17.62 - gamma);
+}
+
+double AbsoluteHumidity(double temperature, double humidity)
+{
+    return 216.679 * humidity / 100.0 * SaturationHpa(temperature) / (273.15 + temperature);
+}
+
+double HeatIndex(double temperature, double humidity)
+{
+    double t = temperature * 1.8 + 32.0;
+    double r = humidity;
+    double heat = 0.5 * (t + 61.0 + (t - 68.0) * 1.2 + r * 0.094);
+
+    if ((heat + t) / 2.0 >= 80.0) {
+        heat = -42.379 + 2.04901523 * t + 10.14333127 * r - 0.22475541 * t * r - 0.00683783 * t * t -
+               0.05481717 * r * r + 0.00122874 * t * t * r + 0.00085282 * t * r * r - 0.00000199 * t * t * r * r;
+        if (r < 13.0 && t >= 80.0 && t <= 112.0) {
+            heat -= (13.0 - r) / 4.0 * std::sqrt((17.0 - std::fabs(t - 95.0)) / 17.0);
+        } else if (r > 85.0 && t >= 80.0 && t <= 87.0) {
+            heat += (r - 85.0) / 10.0 * (87.0 - t) / 5.0;
+        }
+    }
+
+    return (heat - 32.0) / 1.8;
+}
+
+dht11_psychro_t Compute(int16_t humidity_x10, int16_t temperature_x10)
+{
+    const dht11_reading_fixed_t reading = {humidity_x10, temperature_x10};
+    dht11_psychro_t metrics = {};
+    EXPECT_EQ(dht11_psychro_compute(&reading, &metrics), DHT11_OK);
+    return metrics;
+}
+
+}  // namespace
+
+TEST(DHT11PsychroTest, InvalidArguments) {
+    const dht11_reading_fixed_t reading = {550, 230};
+    dht11_raw_data_t raw = {55, 0, 23, 0, 78};
+    dht11_psychro_t metrics;
+
+    EXPECT_EQ(dht11_psychro_compute(nullptr, &metrics), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_psychro_compute(&reading, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_psychro_from_raw(nullptr, &metrics), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_psychro_from_raw(&raw, nullptr), DHT11_ERR_INVALID_ARG);
+}
+
+TEST(DHT11PsychroTest, RejectsReadingsOutsideTheTables) {
+    dht11_psychro_t metrics;
+    const dht11_reading_fixed_t readings[] = {{-1, 200}, {1001, 200}, {500, -401}, {500, 801}};
+
+    for (const dht11_reading_fixed_t& reading : readings) {
+        EXPECT_EQ(dht11_psychro_compute(&reading, &metrics), DHT11_ERR_INVALID_DATA);
+    }
+}
+
+TEST(DHT11PsychroTest, KnownValues) {
+    dht11_psychro_t metrics = Compute(500, 200);
+    EXPECT_EQ(metrics.dew_point_x10, 92);               // 9.26 C
+    EXPECT_EQ(metrics.absolute_humidity_x100, 862);     // 8.62 g/m3
+    EXPECT_EQ(metrics.heat_index_x10, 194);             // Simple formula, close to T
+
+    metrics = Compute(1000, 300);
+    EXPECT_EQ(metrics.dew_point_x10, 300);              // Saturated air
+    metrics = Compute(700, 350);
+    EXPECT_EQ(metrics.heat_index_x10, 503);             // NWS table: 95 F at 70 % is about 124 F
+}
+
+TEST(DHT11PsychroTest, DryAirClampsDewPoint) {
+    EXPECT_EQ(Compute(0, 200).dew_point_x10, DHT11_PSYCHRO_DEW_POINT_MIN_X10);
+    EXPECT_EQ(Compute(0, 200).absolute_humidity_x100, 0u);
+    EXPECT_EQ(Compute(10, -400).dew_point_x10, DHT11_PSYCHRO_DEW_POINT_MIN_X10);
+}
+
+TEST(DHT11PsychroTest, FromRawMatchesCompute) {
+    dht11_raw_data_t raw = {55, 0, 23, 0, 78};
+    dht11_psychro_t from_raw;
+    dht11_psychro_t computed = Compute(550, 230);
+
+    ASSERT_EQ(dht11_psychro_from_raw(&raw, &from_raw), DHT11_OK);
+    EXPECT_EQ(from_raw.dew_point_x10, computed.dew_point_x10);
+    EXPECT_EQ(from_raw.heat_index_x10, computed.heat_index_x10);
+    EXPECT_EQ(from_raw.absolute_humidity_x100, computed.absolute_humidity_x100);
+
+    raw.checksum++;
+    EXPECT_EQ(dht11_psychro_from_raw(&raw, &from_raw), DHT11_ERR_CHECKSUM);
+}
+
+// Every reading a sensor can report, against the libm formulas
+TEST(DHT11PsychroTest, ErrorIsBoundedOverFullRange) {
+    double dew_point_error = 0.0;
+    double heat_index_error = 0.0;
+    double absolute_humidity_error = 0.0;
+
+    for (int temperature_x10 = DHT11_TEMPERATURE_MIN_X10; temperature_x10 <= DHT11_TEMPERATURE_MAX_X10;
+         temperature_x10++) {
+        for (int humidity_x10 = 1; humidity_x10 <= DHT11_HUMIDITY_MAX_X10; humidity_x10++) {
+            const dht11_reading_fixed_t reading = {(int16_t)humidity_x10, (int16_t)temperature_x10};
+            dht11_psychro_t metrics;
+            ASSERT_EQ(dht11_psychro_compute(&reading, &metrics), DHT11_OK);
+
+            double temperature = temperature_x10 / 10.0;
+            double humidity = humidity_x10 / 10.0;
+            double dew_point = DewPoint(temperature, humidity);
+
+            if (dew_point * 10.0 < DHT11_PSYCHRO_DEW_POINT_MIN_X10 + 0.5) {
+                ASSERT_LE(metrics.dew_point_x10, DHT11_PSYCHRO_DEW_POINT_MIN_X10 + 1);
+            } else {
+                dew_point_error = std::max(dew_point_error, std::fabs(metrics.dew_point_x10 / 10.0 - dew_point));
+            }
+            heat_index_error = std::max(heat_index_error,
+                                        std::fabs(metrics.heat_index_x10 / 10.0 - HeatIndex(temperature, humidity)));
+            absolute_humidity_error = std::max(absolute_humidity_error,
+                                               std::fabs(metrics.absolute_humidity_x100 / 100.0 -
+                                                         AbsoluteHumidity(temperature, humidity)));
+        }
+    }
+
+    EXPECT_LE(dew_point_error, 0.1);
+    EXPECT_LE(heat_index_error, 0.1);
+    EXPECT_LE(absolute_humidity_error, 0.1);
+    RecordProperty("dew_point_error", std::to_string(dew_point_error));
+    RecordProperty("heat_index_error", std::to_string(heat_index_error));
+    RecordProperty("absolute_humidity_error", std::to_string(absolute_humidity_error));
+}
@@ -664,3 +664,79 @@ TEST_F(DHT11ReadTest, TimerOverflowProtectionInPulseMeasurement) {
     dht11_result_t result = dht11_read_raw(&handle, &raw_data);
     EXPECT_EQ(result, DHT11_ERR_TIMEOUT);  // Correctly rejects due to invalid timing
 }
+
+TEST_F(DHT11ReadTest, DisconnectedSensorFailsWithinResponseTimeout) {
+    handle.last_reading_time_ms = 0;
+    uint64_t release_time_us = 0;
+
+    EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_milliseconds())
+        .WillOnce(Return(3000));
+
+    // Each timestamp read costs 2us of wall-clock time
+    EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_microseconds())
+        .WillRepeatedly([this]() {
+            mock_time_us += 2;
+            return mock_time_us;
+        });
+
+    EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_direction(pin_ctx, NHAL_PIN_DIR_INPUT, NHAL_PIN_PMODE_PULL_UP))
+        .WillOnce([this, &release_time_us](struct nhal_pin_context* ctx, nhal_pin_dir_t dir, nhal_pin_pull_mode_t pull) {
+            release_time_us = mock_time_us;
+            return NHAL_OK;
+        });
+
+    // Waiting must not sleep between polls
+    EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_microseconds(1))
+        .Times(0);
+
+    dht11_result_t result = dht11_read_raw(&handle, &raw_data);
+    EXPECT_EQ(result, DHT11_ERR_NO_RESPONSE);
+    EXPECT_GE(mock_time_us - release_time_us, (uint64_t)DHT11_RESPONSE_TIMEOUT_US);
+    EXPECT_LE(mock_time_us - release_time_us, (uint64_t)DHT11_RESPONSE_TIMEOUT_US + 10);
+}
+
+TEST_F(DHT11ReadTest, StalledTimestampSourceIsBoundedByPollLimit) {
+    handle.last_reading_time_ms = 0;
+    int polls = 0;
+
+    EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_milliseconds())
+        .WillOnce(Return(3000));
+    EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_microseconds())
+        .WillRepeatedly(Return(500));
+    EXPECT_CALL(NhalPinMock::instance(), nhal_pin_get_state(pin_ctx, _))
+        .WillRepeatedly([&polls](struct nhal_pin_context* ctx, nhal_pin_state_t* state) {
+            polls++;
+            *state = NHAL_PIN_HIGH;
+            return NHAL_OK;
+        });
+
+    dht11_result_t result = dht11_read_raw(&handle, &raw_data);
+    EXPECT_EQ(result, DHT11_ERR_NO_RESPONSE);
+    EXPECT_EQ(polls, DHT11_WAIT_MAX_POLLS);
+}
+
+TEST_F(DHT11ReadTest, FastPinReadsWaitUntilDeadline) {
+    handle.last_reading_time_ms = 0;
+    uint64_t reads = 0;
+    int polls = 0;
+
+    EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_milliseconds())
+        .WillOnce(Return(3000));
+
+    // The clock ticks once every 100 reads, so the response timeout takes
+    // more pin polls than DHT11_WAIT_MAX_POLLS
+    EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_microseconds())
+        .WillRepeatedly([&reads]() {
+            return (uint64_t)(reads++ / 100);
+        });
+    EXPECT_CALL(NhalPinMock::instance(), nhal_pin_get_state(pin_ctx, _))
+        .WillRepeatedly([&polls](struct nhal_pin_context* ctx, nhal_pin_state_t* state) {
+            polls++;
+            *state = NHAL_PIN_HIGH;
+            return NHAL_OK;
+        });
+
+    dht11_result_t result = dht11_read_raw(&handle, &raw_data);
+    EXPECT_EQ(result, DHT11_ERR_NO_RESPONSE);
+    EXPECT_GT(polls, DHT11_WAIT_MAX_POLLS);
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <map>
+#include <string>
+#include "nhal_dht11_sim.hpp"
+
+extern "C" {
+    #include "dht11.h"
+}
+
+class DHT11SimTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Dht11Sim::instance().Reset();
+        memset(&handle, 0, sizeof(handle));
+        pin_ctx = (struct nhal_pin_context*)0x1000;
+        ASSERT_EQ(dht11_init(&handle, pin_ctx), DHT11_OK);
+    }
+
+    Dht11SimConfig& config() { return Dht11Sim::instance().config(); }
+
+    // Waits out the sampling period, then reads
+    dht11_result_t ReadNext(dht11_reading_t *reading) {
+        Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+        return dht11_read(&handle, reading);
+    }
+
+    dht11_handle_t handle;
+    struct nhal_pin_context *pin_ctx;
+};
+
+TEST_F(DHT11SimTest, CleanWaveformDecodes) {
+    dht11_reading_t reading;
+    config().data[0] = 48;
+    config().data[2] = 19;
+
+    ASSERT_EQ(ReadNext(&reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 48.0f);
+    EXPECT_FLOAT_EQ(reading.temperature, 19.0f);
+    EXPECT_EQ(Dht11Sim::instance().counters().responses, 1u);
+}
+
+TEST_F(DHT11SimTest, RateLimitFollowsVirtualClock) {
+    dht11_reading_t reading;
+
+    ASSERT_EQ(ReadNext(&reading), DHT11_OK);
+    EXPECT_EQ(dht11_read(&handle, &reading), DHT11_ERR_TOO_SOON);
+    EXPECT_EQ(ReadNext(&reading), DHT11_OK);
+}
+
+TEST_F(DHT11SimTest, ToleratesTimingJitter) {
+    dht11_reading_t reading;
+    config().jitter_us = 8;
+
+    for (int i = 0; i < 200; i++) {
+        ASSERT_EQ(ReadNext(&reading), DHT11_OK) << "read " << i;
+    }
+}
+
+TEST_F(DHT11SimTest, DropoutReportsNoResponse) {
+    dht11_reading_t reading;
+    config().dropout_probability = 1.0;
+
+    EXPECT_EQ(ReadNext(&reading), DHT11_ERR_NO_RESPONSE);
+    EXPECT_EQ(Dht11Sim::instance().counters().start_signals, 1u);
+    EXPECT_EQ(Dht11Sim::instance().counters().responses, 0u);
+}
+
+TEST_F(DHT11SimTest, FlippedBitFailsChecksum) {
+    dht11_reading_t reading;
+    config().corrupt_probability = 1.0;
+
+    EXPECT_EQ(ReadNext(&reading), DHT11_ERR_CHECKSUM);
+}
+
+TEST_F(DHT11SimTest, TruncatedFrameFails) {
+    dht11_reading_t reading;
+    config().truncate_probability = 1.0;
+
+    for (int i = 0; i < 20; i++) {
+        dht11_result_t result = ReadNext(&reading);
+        EXPECT_TRUE(result == DHT11_ERR_TIMEOUT || result == DHT11_ERR_NO_RESPONSE) << "result " << result;
+    }
+}
+
+TEST_F(DHT11SimTest, InterruptModeDecodesSimulatedEdges) {
+    dht11_raw_data_t raw_data;
+    dht11_result_t result = DHT11_ERR_IN_PROGRESS;
+    config().response_delay_us = 60;
+    Dht11Sim::instance().SetEdgeListener([this](nhal_pin_state_t level, uint32_t timestamp_us) {
+        dht11_on_edge(&handle, level, timestamp_us);
+    });
+    ASSERT_EQ(dht11_set_acquisition_mode(&handle, DHT11_ACQ_INTERRUPT), DHT11_OK);
+
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+    for (int i = 0; i < 10000 && result == DHT11_ERR_IN_PROGRESS; i++) {
+        Dht11Sim::instance().AdvanceUs(10);
+        result = dht11_read_poll(&handle);
+    }
+
+    ASSERT_EQ(result, DHT11_OK);
+    ASSERT_EQ(dht11_read_result(&handle, &raw_data), DHT11_OK);
+    EXPECT_EQ(raw_data.humidity_integer, 55);
+    EXPECT_EQ(raw_data.temperature_integer, 23);
+    EXPECT_EQ(Dht11Sim::instance().counters().get_state, 0u);
+}
+
+TEST_F(DHT11SimTest, LoadTestWithFaultInjection) {
+    const int kTransactions = 20000;
+    std::map<dht11_result_t, int> results;
+    dht11_reading_t reading;
+    config().jitter_us = 5;
+    config().glitch_probability = 0.001;
+    config().dropout_probability = 0.01;
+    config().truncate_probability = 0.01;
+    config().corrupt_probability = 0.01;
+    config().seed = 12345;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < kTransactions; i++) {
+        results[ReadNext(&reading)]++;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    const Dht11SimCounters& counters = Dht11Sim::instance().counters();
+    EXPECT_EQ(counters.start_signals, (uint64_t)kTransactions);
+    EXPECT_EQ(results.count(DHT11_ERR_TOO_SOON), 0u);
+    EXPECT_EQ(results[DHT11_ERR_NO_RESPONSE], kTransactions - (int)counters.responses);
+    // Only injected faults may fail a read
+    EXPECT_GT(results[DHT11_OK], kTransactions * 95 / 100);
+
+    for (const auto& entry : results) {
+        RecordProperty("result_" + std::to_string(entry.first), std::to_string(entry.second));
+    }
+    RecordProperty("hal_calls_per_transaction", std::to_string(counters.TotalCalls() / kTransactions));
+    RecordProperty("transactions_per_second", std::to_string((long)(kTransactions / seconds)));
+}
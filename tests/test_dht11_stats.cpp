@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include "nhal_dht11_sim.hpp"
+
+extern "C" {
+    #include "dht11.h"
+}
+
+class DHT11StatsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Dht11Sim::instance().Reset();
+        memset(&handle, 0, sizeof(handle));
+        memset(&stats, 0, sizeof(stats));
+        ASSERT_EQ(dht11_init(&handle, (struct nhal_pin_context*)0x1000), DHT11_OK);
+    }
+
+    dht11_result_t ReadNext() {
+        dht11_reading_t reading;
+        Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+        return dht11_read(&handle, &reading);
+    }
+
+    dht11_stats_counters_t Snapshot() {
+        dht11_stats_counters_t counters;
+        EXPECT_EQ(dht11_stats_snapshot(&stats, &counters), DHT11_OK);
+        return counters;
+    }
+
+    static uint32_t PhaseSum(const dht11_stats_counters_t& counters) {
+        return counters.phase_total_us[DHT11_PHASE_START] + counters.phase_total_us[DHT11_PHASE_RESPONSE] +
+               counters.phase_total_us[DHT11_PHASE_DATA];
+    }
+
+    dht11_handle_t handle;
+    dht11_stats_t stats;
+};
+
+TEST_F(DHT11StatsTest, InvalidArguments) {
+    dht11_stats_counters_t counters;
+
+    EXPECT_EQ(dht11_set_stats(nullptr, &stats), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_stats_snapshot(nullptr, &counters), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_stats_snapshot(&stats, nullptr), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_stats_reset(nullptr), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11StatsTest, DetachedByDefault) {
+    EXPECT_EQ(handle.stats, nullptr);
+    ASSERT_EQ(ReadNext(), DHT11_OK);
+
+    ASSERT_EQ(dht11_set_stats(&handle, &stats), DHT11_OK);
+    EXPECT_EQ(Snapshot().transactions, 0u);
+}
+
+TEST_F(DHT11StatsTest, TimesEachPhaseOfAPolledRead) {
+    ASSERT_EQ(dht11_set_stats(&handle, &stats), DHT11_OK);
+    ASSERT_EQ(ReadNext(), DHT11_OK);
+
+    dht11_stats_counters_t counters = Snapshot();
+    EXPECT_EQ(counters.results[DHT11_OK], 1u);
+    EXPECT_EQ(counters.transactions, 1u);
+    EXPECT_EQ(counters.retries, 0u);
+
+    uint32_t start_us = counters.phase_total_us[DHT11_PHASE_START];
+    uint32_t response_us = counters.phase_total_us[DHT11_PHASE_RESPONSE];
+    uint32_t data_us = counters.phase_total_us[DHT11_PHASE_DATA];
+    EXPECT_GE(start_us, DHT11_START_SIGNAL_MS * 1000u);
+    EXPECT_LT(start_us, DHT11_START_SIGNAL_MS * 1000u + 200u);
+    // The sensor may start its response while the host still holds the line high
+    EXPECT_GT(response_us, (uint32_t)DHT11_RESPONSE_HIGH_US);
+    EXPECT_LT(response_us, 300u);
+    EXPECT_GE(data_us, DHT11_DATA_BITS * (uint32_t)(DHT11_BIT_LOW_US + DHT11_BIT_0_HIGH_US));
+
+    EXPECT_EQ(counters.latency_total_us, PhaseSum(counters));
+    EXPECT_EQ(counters.latency_max_us, counters.latency_total_us);
+    EXPECT_EQ(counters.busy_wait_us, response_us + data_us);
+    // 18ms start signal plus a few ms of frame lands in the 16-32ms bucket
+    EXPECT_EQ(counters.latency_histogram[14], 1u);
+}
+
+TEST_F(DHT11StatsTest, CountsRejectedAttemptsWithoutTiming) {
+    dht11_reading_t reading;
+    ASSERT_EQ(dht11_set_stats(&handle, &stats), DHT11_OK);
+
+    ASSERT_EQ(ReadNext(), DHT11_OK);
+    ASSERT_EQ(dht11_read(&handle, &reading), DHT11_ERR_TOO_SOON);
+
+    dht11_stats_counters_t counters = Snapshot();
+    EXPECT_EQ(counters.results[DHT11_OK], 1u);
+    EXPECT_EQ(counters.results[DHT11_ERR_TOO_SOON], 1u);
+    EXPECT_EQ(counters.transactions, 1u);
+}
+
+TEST_F(DHT11StatsTest, CountsRetriesAfterFailures) {
+    ASSERT_EQ(dht11_set_stats(&handle, &stats), DHT11_OK);
+
+    Dht11Sim::instance().config().dropout_probability = 1.0;
+    ASSERT_EQ(ReadNext(), DHT11_ERR_NO_RESPONSE);
+    ASSERT_EQ(ReadNext(), DHT11_ERR_NO_RESPONSE);
+    Dht11Sim::instance().config().dropout_probability = 0.0;
+    ASSERT_EQ(ReadNext(), DHT11_OK);
+    ASSERT_EQ(ReadNext(), DHT11_OK);
+
+    dht11_stats_counters_t counters = Snapshot();
+    EXPECT_EQ(counters.results[DHT11_ERR_NO_RESPONSE], 2u);
+    EXPECT_EQ(counters.results[DHT11_OK], 2u);
+    EXPECT_EQ(counters.transactions, 4u);
+    EXPECT_EQ(counters.retries, 2u);
+}
+
+TEST_F(DHT11StatsTest, CountsResultsAfterConversionAndFilter) {
+    dht11_filter_config_t config;
+    dht11_filter_t filter;
+    ASSERT_EQ(dht11_filter_config_default(&config), DHT11_OK);
+    config.max_humidity_step_x10 = 100;
+    ASSERT_EQ(dht11_filter_init(&filter, &config), DHT11_OK);
+    ASSERT_EQ(dht11_set_filter(&handle, &filter), DHT11_OK);
+    ASSERT_EQ(dht11_set_stats(&handle, &stats), DHT11_OK);
+
+    ASSERT_EQ(ReadNext(), DHT11_OK);
+    Dht11Sim::instance().config().data[0] = 101;  // Passes the checksum, fails the range check
+    ASSERT_EQ(ReadNext(), DHT11_ERR_INVALID_DATA);
+    Dht11Sim::instance().config().data[0] = 95;   // In range, but a jump the filter rejects
+    ASSERT_EQ(ReadNext(), DHT11_ERR_OUTLIER);
+
+    dht11_stats_counters_t counters = Snapshot();
+    EXPECT_EQ(counters.results[DHT11_OK], 1u);
+    EXPECT_EQ(counters.results[DHT11_ERR_INVALID_DATA], 1u);
+    EXPECT_EQ(counters.results[DHT11_ERR_OUTLIER], 1u);
+    EXPECT_EQ(counters.transactions, 3u);
+}
+
+TEST_F(DHT11StatsTest, InterruptReadsDoNotBusyWait) {
+    dht11_result_t result = DHT11_ERR_IN_PROGRESS;
+    Dht11Sim::instance().config().response_delay_us = 60;
+    Dht11Sim::instance().SetEdgeListener([this](nhal_pin_state_t level, uint32_t timestamp_us) {
+        dht11_on_edge(&handle, level, timestamp_us);
+    });
+    ASSERT_EQ(dht11_set_acquisition_mode(&handle, DHT11_ACQ_INTERRUPT), DHT11_OK);
+    ASSERT_EQ(dht11_set_stats(&handle, &stats), DHT11_OK);
+
+    Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+    ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+    while (result == DHT11_ERR_IN_PROGRESS) {
+        Dht11Sim::instance().AdvanceUs(100);
+        result = dht11_read_poll(&handle);
+    }
+    ASSERT_EQ(result, DHT11_OK);
+
+    dht11_stats_counters_t counters = Snapshot();
+    EXPECT_EQ(counters.transactions, 1u);
+    EXPECT_EQ(counters.busy_wait_us, 0u);
+    EXPECT_GE(counters.phase_total_us[DHT11_PHASE_RESPONSE], (uint32_t)(DHT11_RESPONSE_LOW_US + DHT11_RESPONSE_HIGH_US));
+    EXPECT_LT(counters.phase_total_us[DHT11_PHASE_RESPONSE], 300u);
+    EXPECT_EQ(counters.latency_total_us, PhaseSum(counters));
+    EXPECT_EQ(counters.frames_timed, 1u);
+}
+
+TEST_F(DHT11StatsTest, RecordsPulseWidthHistograms) {
+    ASSERT_EQ(dht11_set_stats(&handle, &stats), DHT11_OK);
+    ASSERT_EQ(ReadNext(), DHT11_OK);
+
+    dht11_stats_counters_t counters = Snapshot();
+    uint32_t zeros = 0, ones = 0, lows = 0;
+    for (int i = 0; i < DHT11_STATS_PULSE_BUCKETS; i++) {
+        zeros += counters.zero_high_histogram[i];
+        ones += counters.one_high_histogram[i];
+        lows += counters.low_histogram[i];
+    }
+    EXPECT_EQ(counters.frames_timed, 1u);
+    EXPECT_EQ(zeros + ones, (uint32_t)DHT11_DATA_BITS);
+    EXPECT_EQ(lows, (uint32_t)DHT11_DATA_BITS);
+    // 55, 0, 23, 0, 78 has 13 one bits
+    EXPECT_EQ(ones, 13u);
+    EXPECT_EQ(counters.zero_high_histogram[DHT11_BIT_0_HIGH_US / DHT11_STATS_PULSE_BUCKET_US] +
+              counters.zero_high_histogram[DHT11_BIT_0_HIGH_US / DHT11_STATS_PULSE_BUCKET_US + 1], zeros);
+    EXPECT_EQ(counters.one_high_histogram[DHT11_BIT_1_HIGH_US / DHT11_STATS_PULSE_BUCKET_US] +
+              counters.one_high_histogram[DHT11_BIT_1_HIGH_US / DHT11_STATS_PULSE_BUCKET_US + 1], ones);
+    EXPECT_GE(counters.last_margin_us, 10u);
+    EXPECT_EQ(counters.min_margin_us, counters.last_margin_us);
+}
+
+TEST_F(DHT11StatsTest, MarginShrinksAsTimingDrifts) {
+    ASSERT_EQ(dht11_set_stats(&handle, &stats), DHT11_OK);
+    ASSERT_EQ(ReadNext(), DHT11_OK);
+    uint32_t nominal_margin_us = Snapshot().last_margin_us;
+
+    // A slow sensor stretches its '0' pulses toward the threshold
+    Dht11Sim::instance().config().zero_high_us = DHT11_PULSE_THRESHOLD_US - 6;
+    ASSERT_EQ(ReadNext(), DHT11_OK);
+
+    dht11_stats_counters_t counters = Snapshot();
+    EXPECT_EQ(counters.frames_timed, 2u);
+    EXPECT_LT(counters.last_margin_us, nominal_margin_us);
+    EXPECT_LE(counters.last_margin_us, 6u);
+    EXPECT_EQ(counters.min_margin_us, counters.last_margin_us);
+    EXPECT_EQ(counters.margin_histogram[counters.last_margin_us / DHT11_STATS_PULSE_BUCKET_US], 1u);
+}
+
+TEST_F(DHT11StatsTest, ChecksumFailuresAreStillTimed) {
+    ASSERT_EQ(dht11_set_stats(&handle, &stats), DHT11_OK);
+    Dht11Sim::instance().config().corrupt_probability = 1.0;
+
+    ASSERT_EQ(ReadNext(), DHT11_ERR_CHECKSUM);
+    EXPECT_EQ(Snapshot().frames_timed, 1u);
+
+    // A frame that never completes has no margin to report
+    Dht11Sim::instance().config().dropout_probability = 1.0;
+    ASSERT_EQ(ReadNext(), DHT11_ERR_NO_RESPONSE);
+    EXPECT_EQ(Snapshot().frames_timed, 1u);
+}
+
+TEST_F(DHT11StatsTest, ResetTakesEffectImmediately) {
+    ASSERT_EQ(dht11_set_stats(&handle, &stats), DHT11_OK);
+    ASSERT_EQ(ReadNext(), DHT11_OK);
+
+    ASSERT_EQ(dht11_stats_reset(&stats), DHT11_OK);
+    EXPECT_EQ(Snapshot().transactions, 0u);
+
+    ASSERT_EQ(ReadNext(), DHT11_OK);
+    dht11_stats_counters_t counters = Snapshot();
+    EXPECT_EQ(counters.transactions, 1u);
+    EXPECT_EQ(counters.results[DHT11_OK], 1u);
+}
+
+TEST_F(DHT11StatsTest, ConcurrentSnapshotsAreConsistent) {
+    const int kReads = 3000;
+    std::atomic<bool> done(false);
+    std::atomic<int> inconsistent(0);
+    std::atomic<int> snapshots(0);
+    ASSERT_EQ(dht11_set_stats(&handle, &stats), DHT11_OK);
+
+    std::thread scraper([this, &done, &inconsistent, &snapshots]() {
+        while (!done.load()) {
+            dht11_stats_counters_t counters;
+            if (dht11_stats_snapshot(&stats, &counters) != DHT11_OK) {
+                continue;
+            }
+            // Every field of one update must come from the same update
+            if (counters.results[DHT11_OK] != counters.transactions ||
+                counters.latency_total_us != PhaseSum(counters)) {
+                inconsistent++;
+            }
+            snapshots++;
+        }
+    });
+
+    int ok = 0;
+    for (int i = 0; i < kReads; i++) {
+        ok += ReadNext() == DHT11_OK;
+    }
+    done = true;
+    scraper.join();
+
+    EXPECT_EQ(ok, kReads);
+    EXPECT_EQ(inconsistent.load(), 0);
+    EXPECT_EQ(Snapshot().transactions, (uint32_t)kReads);
+    RecordProperty("snapshots", std::to_string(snapshots.load()));
+}
@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <pthread.h>
+#include "nhal_common.h"
+#include "nhal_pin_mock.hpp"
+#include "nhal_common_mock.hpp"
+#include "dht11_frame_builder.hpp"
+
+extern "C" {
+    #include "dht11.h"
+}
+
+using ::testing::_;
+using ::testing::Return;
+
+namespace {
+
+struct PthreadLock {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+};
+
+void LockHook(void *ctx) { pthread_mutex_lock(&static_cast<PthreadLock*>(ctx)->mutex); }
+void UnlockHook(void *ctx) { pthread_mutex_unlock(&static_cast<PthreadLock*>(ctx)->mutex); }
+void WaitHook(void *ctx) {
+    PthreadLock *lock = static_cast<PthreadLock*>(ctx);
+    pthread_cond_wait(&lock->cond, &lock->mutex);
+}
+void NotifyAllHook(void *ctx) { pthread_cond_broadcast(&static_cast<PthreadLock*>(ctx)->cond); }
+
+} // namespace
+
+class DHT11SyncTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        memset(&handle, 0, sizeof(handle));
+        pthread_mutex_init(&lock.mutex, nullptr);
+        pthread_cond_init(&lock.cond, nullptr);
+        lock_ops = {LockHook, UnlockHook, WaitHook, NotifyAllHook, &lock};
+        mock_time_ms = 10000;
+        mock_time_us = 0;
+        bus_transactions = 0;
+        active_start_signals = 0;
+        max_active_start_signals = 0;
+        start_signal_sleep_ms = 30;
+        advance_ms_per_call = 0;
+        script_pos = 0;
+
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_milliseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){ return mock_time_ms += advance_ms_per_call; });
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_get_timestamp_microseconds())
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](){ return mock_time_us += 20; });
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_microseconds(_))
+            .Times(testing::AnyNumber());
+        EXPECT_CALL(NhalCommonMock::instance(), nhal_delay_milliseconds(_))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](uint32_t ms) {
+                // The start signal is where the bus is held; make it long enough for readers to pile up
+                int active = ++active_start_signals;
+                int seen = max_active_start_signals.load();
+                while (active > seen && !max_active_start_signals.compare_exchange_weak(seen, active)) {
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(start_signal_sleep_ms));
+                --active_start_signals;
+            });
+
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_direction(_, _, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly(Return(NHAL_OK));
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_set_state(_, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](struct nhal_pin_context* ctx, nhal_pin_state_t state) {
+                if (state == NHAL_PIN_LOW) {
+                    bus_transactions++;
+                    script_pos = 0;
+                }
+                return NHAL_OK;
+            });
+        EXPECT_CALL(NhalPinMock::instance(), nhal_pin_get_state(_, _))
+            .Times(testing::AnyNumber())
+            .WillRepeatedly([this](struct nhal_pin_context* ctx, nhal_pin_state_t* state) {
+                *state = script_pos < pin_script.size() ? pin_script[script_pos++] : NHAL_PIN_HIGH;
+                return NHAL_OK;
+            });
+
+        pin_script = AllZeroFramePinScript();
+        pin_ctx = (struct nhal_pin_context*)0x1000;
+        dht11_init(&handle, pin_ctx);
+    }
+
+    void TearDown() override {
+        testing::Mock::VerifyAndClearExpectations(&NhalPinMock::instance());
+        testing::Mock::VerifyAndClearExpectations(&NhalCommonMock::instance());
+        pthread_cond_destroy(&lock.cond);
+        pthread_mutex_destroy(&lock.mutex);
+    }
+
+    // Releases all readers at once so they contend for the same transaction
+    std::vector<dht11_result_t> RunReaders(int readers, int reads_per_reader) {
+        std::vector<dht11_result_t> results(readers * reads_per_reader, DHT11_ERR_INVALID_ARG);
+        std::atomic<bool> go(false);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < readers; t++) {
+            threads.emplace_back([this, t, reads_per_reader, &go, &results]() {
+                while (!go.load()) {
+                    std::this_thread::yield();
+                }
+                for (int i = 0; i < reads_per_reader; i++) {
+                    dht11_reading_t reading;
+                    results[t * reads_per_reader + i] = dht11_read(&handle, &reading);
+                }
+            });
+        }
+        go = true;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        return results;
+    }
+
+    dht11_handle_t handle;
+    struct nhal_pin_context *pin_ctx;
+    PthreadLock lock;
+    dht11_lock_ops_t lock_ops;
+    std::atomic<uint32_t> mock_time_ms;
+    std::atomic<uint64_t> mock_time_us;
+    std::atomic<int> bus_transactions;
+    std::atomic<int> active_start_signals;
+    std::atomic<int> max_active_start_signals;
+    int start_signal_sleep_ms;
+    uint32_t advance_ms_per_call;
+    std::vector<nhal_pin_state_t> pin_script;
+    size_t script_pos;
+};
+
+TEST_F(DHT11SyncTest, SetLockOpsRejectsInvalidArguments) {
+    dht11_lock_ops_t incomplete = lock_ops;
+    incomplete.wait = nullptr;
+
+    EXPECT_EQ(dht11_set_lock_ops(nullptr, &lock_ops), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_set_lock_ops(&handle, &incomplete), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(handle.lock_ops, nullptr);
+    EXPECT_EQ(dht11_set_lock_ops(&handle, &lock_ops), DHT11_OK);
+    EXPECT_EQ(dht11_set_lock_ops(&handle, nullptr), DHT11_OK);
+    EXPECT_EQ(handle.lock_ops, nullptr);
+}
+
+TEST_F(DHT11SyncTest, SingleReaderBehavesLikeUnlockedRead) {
+    dht11_reading_t reading;
+    ASSERT_EQ(dht11_set_lock_ops(&handle, &lock_ops), DHT11_OK);
+    start_signal_sleep_ms = 0;
+
+    EXPECT_EQ(dht11_read(&handle, &reading), DHT11_OK);
+    EXPECT_EQ(dht11_read(&handle, &reading), DHT11_ERR_TOO_SOON);
+    EXPECT_EQ(bus_transactions.load(), 1);
+}
+
+TEST_F(DHT11SyncTest, FailedLockedReadLeavesReadingUnchanged) {
+    dht11_reading_t reading = {34.5f, 12.5f};
+    dht11_reading_fixed_t fixed = {345, 125};
+    ASSERT_EQ(dht11_set_lock_ops(&handle, &lock_ops), DHT11_OK);
+    start_signal_sleep_ms = 0;
+    pin_script.clear();
+
+    EXPECT_EQ(dht11_read(&handle, &reading), DHT11_ERR_NO_RESPONSE);
+    EXPECT_FLOAT_EQ(reading.temperature, 12.5f);
+    EXPECT_FLOAT_EQ(reading.humidity, 34.5f);
+
+    handle.last_reading_time_ms = 0;
+    EXPECT_EQ(dht11_read_fixed(&handle, &fixed), DHT11_ERR_NO_RESPONSE);
+    EXPECT_EQ(fixed.temperature_x10, 125);
+    EXPECT_EQ(fixed.humidity_x10, 345);
+}
+
+TEST_F(DHT11SyncTest, ConcurrentReadersShareOneTransaction) {
+    ASSERT_EQ(dht11_set_lock_ops(&handle, &lock_ops), DHT11_OK);
+    ASSERT_EQ(dht11_set_cache_max_age(&handle, 1000), DHT11_OK);
+
+    std::vector<dht11_result_t> results = RunReaders(8, 1);
+
+    for (dht11_result_t result : results) {
+        EXPECT_EQ(result, DHT11_OK);
+    }
+    EXPECT_EQ(bus_transactions.load(), 1);
+    EXPECT_EQ(max_active_start_signals.load(), 1);
+}
+
+TEST_F(DHT11SyncTest, ConcurrentReadersWithoutCacheNeverOverlapTransactions) {
+    ASSERT_EQ(dht11_set_lock_ops(&handle, &lock_ops), DHT11_OK);
+
+    std::vector<dht11_result_t> results = RunReaders(8, 1);
+
+    int ok = 0;
+    for (dht11_result_t result : results) {
+        EXPECT_TRUE(result == DHT11_OK || result == DHT11_ERR_TOO_SOON);
+        ok += result == DHT11_OK;
+    }
+    EXPECT_GE(ok, 1);
+    EXPECT_EQ(bus_transactions.load(), 1);
+    EXPECT_EQ(max_active_start_signals.load(), 1);
+}
+
+TEST_F(DHT11SyncTest, StressReadersKeepBusExclusive) {
+    ASSERT_EQ(dht11_set_lock_ops(&handle, &lock_ops), DHT11_OK);
+    start_signal_sleep_ms = 1;
+    advance_ms_per_call = 100;
+
+    std::vector<dht11_result_t> results = RunReaders(8, 50);
+
+    int ok = 0;
+    for (dht11_result_t result : results) {
+        EXPECT_TRUE(result == DHT11_OK || result == DHT11_ERR_TOO_SOON);
+        ok += result == DHT11_OK;
+    }
+    // Every reader either shared a transaction's result or was rate limited
+    EXPECT_GE(ok, bus_transactions.load());
+    EXPECT_LT(bus_transactions.load(), 8 * 50);
+    EXPECT_EQ(max_active_start_signals.load(), 1);
+}
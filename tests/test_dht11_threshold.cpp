@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "nhal_dht11_sim.hpp"
+
+extern "C" {
+    #include "dht11.h"
+}
+
+class DHT11ThresholdTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Dht11Sim::instance().Reset();
+        memset(&handle, 0, sizeof(handle));
+        pin_ctx = (struct nhal_pin_context*)0x1000;
+        ASSERT_EQ(dht11_init(&handle, pin_ctx), DHT11_OK);
+    }
+
+    Dht11SimConfig& config() { return Dht11Sim::instance().config(); }
+
+    dht11_result_t ReadNext(dht11_reading_t *reading) {
+        Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+        return dht11_read(&handle, reading);
+    }
+
+    uint8_t Threshold() {
+        uint8_t threshold_us = 0;
+        EXPECT_EQ(dht11_get_bit_threshold(&handle, &threshold_us), DHT11_OK);
+        return threshold_us;
+    }
+
+    dht11_handle_t handle;
+    struct nhal_pin_context *pin_ctx;
+};
+
+TEST_F(DHT11ThresholdTest, DefaultsToFixedThreshold) {
+    EXPECT_EQ(Threshold(), DHT11_PULSE_THRESHOLD_US);
+    EXPECT_FALSE(handle.adaptive_threshold);
+}
+
+TEST_F(DHT11ThresholdTest, InvalidArguments) {
+    uint8_t threshold_us;
+
+    EXPECT_EQ(dht11_set_adaptive_threshold(NULL, true), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_get_bit_threshold(NULL, &threshold_us), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_get_bit_threshold(&handle, NULL), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11ThresholdTest, FixedThresholdFailsSlowSensor) {
+    dht11_reading_t reading;
+    config().zero_high_us = 44;
+    config().one_high_us = 90;
+
+    EXPECT_EQ(ReadNext(&reading), DHT11_ERR_CHECKSUM);
+    EXPECT_EQ(Threshold(), DHT11_PULSE_THRESHOLD_US);
+}
+
+TEST_F(DHT11ThresholdTest, AdaptiveLearnsSlowSensor) {
+    dht11_reading_t reading;
+    config().zero_high_us = 44;
+    config().one_high_us = 90;
+    ASSERT_EQ(dht11_set_adaptive_threshold(&handle, true), DHT11_OK);
+
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(ReadNext(&reading), DHT11_OK) << "read " << i;
+        EXPECT_FLOAT_EQ(reading.humidity, 55.0f);
+        EXPECT_FLOAT_EQ(reading.temperature, 23.0f);
+    }
+    EXPECT_GT(Threshold(), 55);
+    EXPECT_LT(Threshold(), 80);
+}
+
+TEST_F(DHT11ThresholdTest, AdaptiveLearnsFastSensor) {
+    dht11_reading_t reading;
+    config().zero_high_us = 10;
+    config().one_high_us = 28;
+
+    // Every pulse reads as a zero, and an all-zero frame passes the checksum
+    ASSERT_EQ(ReadNext(&reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 0.0f);
+
+    ASSERT_EQ(dht11_set_adaptive_threshold(&handle, true), DHT11_OK);
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(ReadNext(&reading), DHT11_OK) << "read " << i;
+        EXPECT_FLOAT_EQ(reading.humidity, 55.0f);
+        EXPECT_FLOAT_EQ(reading.temperature, 23.0f);
+    }
+    EXPECT_GT(Threshold(), 14);
+    EXPECT_LT(Threshold(), 30);
+}
+
+TEST_F(DHT11ThresholdTest, AdaptiveToleratesJitter) {
+    dht11_reading_t reading;
+    config().zero_high_us = 40;
+    config().one_high_us = 84;
+    config().jitter_us = 6;
+    ASSERT_EQ(dht11_set_adaptive_threshold(&handle, true), DHT11_OK);
+
+    for (int i = 0; i < 200; i++) {
+        ASSERT_EQ(ReadNext(&reading), DHT11_OK) << "read " << i;
+    }
+}
+
+TEST_F(DHT11ThresholdTest, TracksSlowDrift) {
+    dht11_reading_t reading;
+    ASSERT_EQ(dht11_set_adaptive_threshold(&handle, true), DHT11_OK);
+
+    // Both pulse widths stretch by 1us per read, well past the fixed threshold
+    for (int i = 0; i < 24; i++) {
+        config().zero_high_us = 26 + i;
+        config().one_high_us = 70 + i;
+        ASSERT_EQ(ReadNext(&reading), DHT11_OK) << "read " << i;
+    }
+    EXPECT_GT(Threshold(), 55);
+}
+
+TEST_F(DHT11ThresholdTest, InterruptModeLearnsToo) {
+    dht11_raw_data_t raw_data;
+    config().zero_high_us = 44;
+    config().one_high_us = 90;
+    config().response_delay_us = 60;
+    Dht11Sim::instance().SetEdgeListener([this](nhal_pin_state_t level, uint32_t timestamp_us) {
+        dht11_on_edge(&handle, level, timestamp_us);
+    });
+    ASSERT_EQ(dht11_set_acquisition_mode(&handle, DHT11_ACQ_INTERRUPT), DHT11_OK);
+    ASSERT_EQ(dht11_set_adaptive_threshold(&handle, true), DHT11_OK);
+
+    for (int read = 0; read < 3; read++) {
+        dht11_result_t result = DHT11_ERR_IN_PROGRESS;
+        Dht11Sim::instance().AdvanceMs(DHT11_MIN_SAMPLING_PERIOD_MS);
+        ASSERT_EQ(dht11_read_start(&handle), DHT11_OK);
+        for (int i = 0; i < 10000 && result == DHT11_ERR_IN_PROGRESS; i++) {
+            Dht11Sim::instance().AdvanceUs(10);
+            result = dht11_read_poll(&handle);
+        }
+
+        ASSERT_EQ(result, DHT11_OK) << "read " << read;
+        ASSERT_EQ(dht11_read_result(&handle, &raw_data), DHT11_OK);
+        EXPECT_EQ(raw_data.humidity_integer, 55);
+        EXPECT_EQ(raw_data.temperature_integer, 23);
+    }
+    EXPECT_GT(Threshold(), 55);
+}
+
+TEST_F(DHT11ThresholdTest, GenuineZeroFrameIsKept) {
+    dht11_reading_t reading;
+    memset(config().data, 0, sizeof(config().data));
+    ASSERT_EQ(dht11_set_adaptive_threshold(&handle, true), DHT11_OK);
+
+    ASSERT_EQ(ReadNext(&reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 0.0f);
+    EXPECT_FLOAT_EQ(reading.temperature, 0.0f);
+    EXPECT_EQ(Threshold(), DHT11_PULSE_THRESHOLD_US);
+}
+
+TEST_F(DHT11ThresholdTest, DisableRestoresDefault) {
+    dht11_reading_t reading;
+    config().zero_high_us = 44;
+    config().one_high_us = 90;
+    ASSERT_EQ(dht11_set_adaptive_threshold(&handle, true), DHT11_OK);
+    ASSERT_EQ(ReadNext(&reading), DHT11_OK);
+    ASSERT_NE(Threshold(), DHT11_PULSE_THRESHOLD_US);
+
+    ASSERT_EQ(dht11_set_adaptive_threshold(&handle, false), DHT11_OK);
+    EXPECT_EQ(Threshold(), DHT11_PULSE_THRESHOLD_US);
+    EXPECT_EQ(ReadNext(&reading), DHT11_ERR_CHECKSUM);
+}
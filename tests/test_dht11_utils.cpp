@@ -455,3 +455,129 @@ TEST_F(DHT11UtilsTest, VerifyChecksumWithMaxValues) {
     
     EXPECT_TRUE(result);
 }
+
+TEST_F(DHT11UtilsTest, ConvertRawVariantDht22PositiveValues) {
+    // 65.2 %RH = 0x028C, 35.1 C = 0x015F
+    raw_data.humidity_integer = 0x02;
+    raw_data.humidity_decimal = 0x8C;
+    raw_data.temperature_integer = 0x01;
+    raw_data.temperature_decimal = 0x5F;
+    raw_data.checksum = (uint8_t)(0x02 + 0x8C + 0x01 + 0x5F);
+
+    ASSERT_EQ(dht11_convert_raw_variant(&dht11_variant_dht22, &raw_data, &reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 65.2f);
+    EXPECT_FLOAT_EQ(reading.temperature, 35.1f);
+
+    // The DHT11 decoding takes the same bytes for integer and tenths parts
+    ASSERT_EQ(dht11_convert_raw_to_reading(&raw_data, &reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 2.0f + 14.0f);
+}
+
+TEST_F(DHT11UtilsTest, ConvertRawVariantDht22NegativeTemperature) {
+    // -10.1 C = sign bit | 0x0065
+    raw_data.humidity_integer = 0x01;
+    raw_data.humidity_decimal = 0xF4;
+    raw_data.temperature_integer = 0x80;
+    raw_data.temperature_decimal = 0x65;
+    raw_data.checksum = (uint8_t)(0x01 + 0xF4 + 0x80 + 0x65);
+
+    ASSERT_EQ(dht11_convert_raw_variant(&dht11_variant_dht22, &raw_data, &reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 50.0f);
+    EXPECT_FLOAT_EQ(reading.temperature, -10.1f);
+}
+
+TEST_F(DHT11UtilsTest, ConvertRawVariantChecksAndRanges) {
+    raw_data.humidity_integer = 0x03;
+    raw_data.humidity_decimal = 0xE9;  // 100.1 %RH
+    raw_data.temperature_integer = 0x00;
+    raw_data.temperature_decimal = 0xC8;
+    raw_data.checksum = (uint8_t)(0x03 + 0xE9 + 0x00 + 0xC8);
+    EXPECT_EQ(dht11_convert_raw_variant(&dht11_variant_dht21, &raw_data, &reading), DHT11_ERR_INVALID_DATA);
+
+    raw_data.checksum++;
+    EXPECT_EQ(dht11_convert_raw_variant(&dht11_variant_am2302, &raw_data, &reading), DHT11_ERR_CHECKSUM);
+
+    EXPECT_EQ(dht11_convert_raw_variant(nullptr, &raw_data, &reading), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_convert_raw_variant(&dht11_variant_dht22, nullptr, &reading), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_convert_raw_variant(&dht11_variant_dht22, &raw_data, nullptr), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11UtilsTest, ConvertRawVariantDht11MatchesDefault) {
+    dht11_reading_t variant_reading;
+    raw_data.humidity_integer = 55;
+    raw_data.humidity_decimal = 3;
+    raw_data.temperature_integer = 25;
+    raw_data.temperature_decimal = 7;
+    raw_data.checksum = 55 + 3 + 25 + 7;
+
+    ASSERT_EQ(dht11_convert_raw_to_reading(&raw_data, &reading), DHT11_OK);
+    ASSERT_EQ(dht11_convert_raw_variant(&dht11_variant_dht11, &raw_data, &variant_reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(variant_reading.humidity, reading.humidity);
+    EXPECT_FLOAT_EQ(variant_reading.temperature, reading.temperature);
+}
+
+TEST_F(DHT11UtilsTest, ConvertRawToFixedMatchesFloat) {
+    dht11_reading_fixed_t fixed;
+    raw_data.humidity_integer = 55;
+    raw_data.humidity_decimal = 3;
+    raw_data.temperature_integer = 25;
+    raw_data.temperature_decimal = 7;
+    raw_data.checksum = 55 + 3 + 25 + 7;
+
+    ASSERT_EQ(dht11_convert_raw_to_fixed(&raw_data, &fixed), DHT11_OK);
+    EXPECT_EQ(fixed.humidity_x10, 553);
+    EXPECT_EQ(fixed.temperature_x10, 257);
+
+    ASSERT_EQ(dht11_convert_raw_to_reading(&raw_data, &reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, 55.3f);
+    EXPECT_FLOAT_EQ(reading.temperature, 25.7f);
+}
+
+TEST_F(DHT11UtilsTest, ConvertRawToFixedChecksAndRanges) {
+    dht11_reading_fixed_t fixed = {1, 2};
+    raw_data.humidity_integer = 101;
+    raw_data.humidity_decimal = 0;
+    raw_data.temperature_integer = 25;
+    raw_data.temperature_decimal = 0;
+    raw_data.checksum = 101 + 25;
+    EXPECT_EQ(dht11_convert_raw_to_fixed(&raw_data, &fixed), DHT11_ERR_INVALID_DATA);
+    EXPECT_EQ(fixed.humidity_x10, 1010);
+
+    // A checksum failure leaves the float reading untouched
+    reading.humidity = -1.0f;
+    raw_data.checksum++;
+    EXPECT_EQ(dht11_convert_raw_to_fixed(&raw_data, &fixed), DHT11_ERR_CHECKSUM);
+    EXPECT_EQ(dht11_convert_raw_to_reading(&raw_data, &reading), DHT11_ERR_CHECKSUM);
+    EXPECT_FLOAT_EQ(reading.humidity, -1.0f);
+
+    EXPECT_EQ(dht11_convert_raw_to_fixed(nullptr, &fixed), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_convert_raw_to_fixed(&raw_data, nullptr), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11UtilsTest, ConvertRawVariantFixedDht22NegativeTemperature) {
+    dht11_reading_fixed_t fixed;
+    // -10.1 C = sign bit | 0x0065, 50.0 %RH = 0x01F4
+    raw_data.humidity_integer = 0x01;
+    raw_data.humidity_decimal = 0xF4;
+    raw_data.temperature_integer = 0x80;
+    raw_data.temperature_decimal = 0x65;
+    raw_data.checksum = (uint8_t)(0x01 + 0xF4 + 0x80 + 0x65);
+
+    ASSERT_EQ(dht11_convert_raw_variant_fixed(&dht11_variant_dht22, &raw_data, &fixed), DHT11_OK);
+    EXPECT_EQ(fixed.humidity_x10, 500);
+    EXPECT_EQ(fixed.temperature_x10, -101);
+
+    EXPECT_EQ(dht11_convert_raw_variant_fixed(nullptr, &raw_data, &fixed), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_convert_raw_variant_fixed(&dht11_variant_dht22, &raw_data, nullptr), DHT11_ERR_INVALID_ARG);
+}
+
+TEST_F(DHT11UtilsTest, FixedToReading) {
+    const dht11_reading_fixed_t fixed = {-5, -101};
+
+    ASSERT_EQ(dht11_fixed_to_reading(&fixed, &reading), DHT11_OK);
+    EXPECT_FLOAT_EQ(reading.humidity, -0.5f);
+    EXPECT_FLOAT_EQ(reading.temperature, -10.1f);
+
+    EXPECT_EQ(dht11_fixed_to_reading(nullptr, &reading), DHT11_ERR_INVALID_ARG);
+    EXPECT_EQ(dht11_fixed_to_reading(&fixed, nullptr), DHT11_ERR_INVALID_ARG);
+}